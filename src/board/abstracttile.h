@@ -3,24 +3,18 @@
 
 #include "../common/forward.h"
 #include "../common/resource.h"
-#include <memory>
-#include <vector>
 
 class AbstractTile {
   public:
     AbstractTile();
     virtual ~AbstractTile();
 
-    virtual void addNeighbouringVertex(Vertex*) = 0;
-
     virtual int getTileNumber() const = 0; // Unique identifier assigned to each tile on the board
     virtual int getTileValue() const = 0;  // The dice roll needed to obtain resources from this tile
     virtual Resource getResource() const = 0;
 
-    virtual std::vector<int> getStealCandidates(Builder&) const = 0;
-    virtual BuilderInventoryUpdate giveResourcesToBuilders() const = 0;
-
-    virtual std::unique_ptr<AbstractTile> removeGeese() = 0;
+    // Tiles with geese on them give no resources
+    virtual void setGeese(bool) = 0;
     virtual bool hasGeese() const = 0;
 };
 
@@ -1,39 +1,55 @@
 #include "board.h"
 #include "../common/inventoryupdate.h"
-#include "../structures/basement.h"
-#include "../structures/house.h"
+#include "../structures/residence.h"
 #include "../structures/road.h"
-#include "../structures/tower.h"
+#include "boardrenderer.h"
 #include "edge.h"
-#include "geesetile.h"
 #include "tile.h"
+#include "topology.h"
 #include "vertex.h"
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+namespace {
+// Vertices and edges have no default constructor, so their arrays are built from an index sequence
+template <typename T, std::size_t... I>
+std::array<T, sizeof...(I)> makeNumbered(std::index_sequence<I...>) {
+    return {{T{static_cast<int>(I)}...}};
+}
+
+// Every board starts from the same empty vertices and edges, so they are built once and copied from then on
+const std::array<Vertex, Topology::NUM_VERTICES> emptyVertices = makeNumbered<Vertex>(std::make_index_sequence<Topology::NUM_VERTICES>{});
+const std::array<Edge, Topology::NUM_EDGES> emptyEdges = makeNumbered<Edge>(std::make_index_sequence<Topology::NUM_EDGES>{});
+
+template <std::size_t... I>
+std::array<Tile, sizeof...(I)> makeTiles(const std::vector<TileInitData>& tileInitData, std::index_sequence<I...>) {
+    return {{Tile{static_cast<int>(I), tileInitData.at(I).tileValue, tileInitData.at(I).resource}...}};
+}
+}
 
-Board::Board(std::vector<TileInitData> tileInitData) : geeseTile{-1} {
+Board::Board(const std::vector<TileInitData>& tileInitData) : tiles{makeTiles(tileInitData, std::make_index_sequence<NUM_TILES>{})},
+    vertices{emptyVertices}, edges{emptyEdges}, geeseTile{-1}, residenceMasks{}, roadMasks{}, roadEndpointMasks{}, occupiedVertices{0}, occupiedEdges{}, builderColours{}, hash{0}, vertexYields{}, payoutOffsets{} {
     for (int i = 0; i < NUM_TILES; i++) {
-        tiles.push_back(std::make_unique<Tile>(i, tileInitData.at(i).tileValue, tileInitData.at(i).resource));
+        hash ^= Zobrist::key(Zobrist::Feature::TILE, i, tileInitData.at(i).resource, tileInitData.at(i).tileValue);
 
         // Assume there is only one park tile
         if (tileInitData.at(i).resource == Resource::PARK) {
-            setGeeseTile(i);
+            geeseTile = i;
+            tiles[i].setGeese(true);
+            hash ^= Zobrist::key(Zobrist::Feature::GEESE, i);
         }
     }
 
-    for (int i = 0; i < NUM_EDGES; i++) {
-        edges.push_back(std::make_unique<Edge>(i));
-    }
-
-    for (int i = 0; i < NUM_VERTICES; i++) {
-        vertices.push_back(std::make_unique<Vertex>(i));
+    for (int i = 0; i < NUM_TILES; i++) {
+        if (i != geeseTile) {
+            addTileYield(i, 1);
+        }
     }
-
-    setupVertices();
-    setupEdges();
-    setupTiles();
 }
 
-Board::Board(std::vector<TileInitData> tileInitData, std::vector<std::pair<Builder*, BuilderStructureData>> structureData) : Board(tileInitData) {
-    for (auto& pair : structureData) {
+Board::Board(const std::vector<TileInitData>& tileInitData, const std::vector<std::pair<Builder*, BuilderStructureData>>& structureData) : Board(tileInitData) {
+    for (const auto& pair : structureData) {
         Builder* builder = pair.first;
         BuilderStructureData data = pair.second;
 
@@ -48,862 +64,506 @@ Board::Board(std::vector<TileInitData> tileInitData, std::vector<std::pair<Build
 
 Board::~Board() {}
 
-void Board::setResidence(Builder& builder, int vertexNumber, char residenceType) {
-    Vertex* vertex = getVertex(vertexNumber);
+std::vector<TileInitData> Board::getTileInitData() const {
+    std::vector<TileInitData> data;
+    data.reserve(NUM_TILES);
+    for (const Tile& tile : tiles) {
+        data.push_back(TileInitData{tile.getTileValue(), tile.getResource()});
+    }
+    return data;
+}
+
+BoardSnapshot Board::snapshot() const {
+    BoardSnapshot snapshot;
 
-    if (residenceType == 'B') {
-        std::shared_ptr<Residence> residence = std::make_shared<Basement>(builder, *vertex);
-        builder.residences.push_back(residence);
-        vertex->buildResidence(residence);
+    // Only occupied locations hold a structure; everything else is already empty
+    for (VertexMask bits = occupiedVertices; bits != 0; bits &= bits - 1) {
+        int vertexNumber = lowestBit(bits);
+        snapshot.residences[vertexNumber] = vertices[vertexNumber].getResidence();
     }
-    else if (residenceType == 'H') {
-        std::shared_ptr<Residence> residence = std::make_shared<House>(builder, *vertex);
-        builder.residences.push_back(residence);
-        vertex->buildResidence(residence);
+    for (int word = 0; word < 2; word++) {
+        for (uint64_t bits = word == 0 ? occupiedEdges.lo : occupiedEdges.hi; bits != 0; bits &= bits - 1) {
+            int edgeNumber = 64 * word + lowestBit(bits);
+            snapshot.roads[edgeNumber] = edges[edgeNumber].getRoad();
+        }
     }
-    else if (residenceType == 'T') {
-        std::shared_ptr<Residence> residence = std::make_shared<Tower>(builder, *vertex);
-        builder.residences.push_back(residence);
-        vertex->buildResidence(residence);
+    snapshot.geeseTile = geeseTile;
+    snapshot.residenceMasks = residenceMasks;
+    snapshot.roadMasks = roadMasks;
+    snapshot.roadEndpointMasks = roadEndpointMasks;
+    snapshot.occupiedVertices = occupiedVertices;
+    snapshot.occupiedEdges = occupiedEdges;
+    snapshot.builderColours = builderColours;
+    snapshot.hash = hash;
+    snapshot.payouts = payouts;
+    snapshot.payoutOffsets = payoutOffsets;
+    return snapshot;
+}
+
+void Board::restore(const BoardSnapshot& snapshot) {
+    // Only locations occupied before or after can change
+    for (VertexMask bits = occupiedVertices | snapshot.occupiedVertices; bits != 0; bits &= bits - 1) {
+        int vertexNumber = lowestBit(bits);
+        vertices[vertexNumber].buildResidence(snapshot.residences[vertexNumber]);
+    }
+    EdgeMask changedEdges = occupiedEdges | snapshot.occupiedEdges;
+    for (int word = 0; word < 2; word++) {
+        for (uint64_t bits = word == 0 ? changedEdges.lo : changedEdges.hi; bits != 0; bits &= bits - 1) {
+            int edgeNumber = 64 * word + lowestBit(bits);
+            edges[edgeNumber].buildRoad(snapshot.roads[edgeNumber]);
+        }
+    }
+
+    if (geeseTile != snapshot.geeseTile) {
+        if (geeseTile != -1) {
+            tiles[geeseTile].setGeese(false);
+            addTileYield(geeseTile, 1);
+        }
+        if (snapshot.geeseTile != -1) {
+            tiles.at(snapshot.geeseTile).setGeese(true);
+            addTileYield(snapshot.geeseTile, -1);
+        }
     }
+    geeseTile = snapshot.geeseTile;
+    residenceMasks = snapshot.residenceMasks;
+    roadMasks = snapshot.roadMasks;
+    roadEndpointMasks = snapshot.roadEndpointMasks;
+    occupiedVertices = snapshot.occupiedVertices;
+    occupiedEdges = snapshot.occupiedEdges;
+    builderColours = snapshot.builderColours;
+    hash = snapshot.hash;
+    payouts = snapshot.payouts;
+    payoutOffsets = snapshot.payoutOffsets;
 }
 
-void Board::setRoad(Builder& builder, int edgeNumber) {
-    Edge* edge = getEdge(edgeNumber);
-    std::shared_ptr<Road> road = std::make_shared<Road>(builder, *edge);
-    builder.roads.push_back(road);
-    edge->buildRoad(road);
+void Board::setResidence(Builder& builder, int vertexNumber, char residenceType) {
+    if (residenceType != 'B' && residenceType != 'H' && residenceType != 'T') {
+        return;
+    }
+
+    Residence residence{builder.getBuilderNumber(), Residence::levelFromLetter(residenceType)};
+    builder.addResidence(vertexNumber, residence);
+    getMutableVertex(vertexNumber)->buildResidence(residence);
+    markResidence(builder, vertexNumber);
 }
 
-AbstractTile* Board::getTile(int tileNumber) const {
-    return tiles.at(tileNumber).get();
+void Board::setRoad(Builder& builder, int edgeNumber) {
+    builder.roads.emplace_back(edgeNumber);
+    getMutableEdge(edgeNumber)->buildRoad(Road{builder.getBuilderNumber()});
+    markRoad(builder, edgeNumber);
 }
 
-Vertex* Board::getVertex(int vertexNumber) const {
-    return vertices.at(vertexNumber).get();
+void Board::markRoad(const Builder& builder, int edgeNumber) {
+    int builderNumber = builder.getBuilderNumber();
+    builderColours.at(builderNumber) = builder.getBuilderColour();
+    roadMasks.at(builderNumber) |= EdgeMask::bit(edgeNumber);
+    roadEndpointMasks.at(builderNumber) |= endpointMasks[edgeNumber];
+    occupiedEdges |= EdgeMask::bit(edgeNumber);
+    hash ^= Zobrist::key(Zobrist::Feature::ROAD, edgeNumber, builderNumber);
 }
 
-Edge* Board::getEdge(int edgeNumber) const {
-    return edges.at(edgeNumber).get();
+void Board::markResidence(const Builder& builder, int vertexNumber) {
+    int builderNumber = builder.getBuilderNumber();
+    builderColours.at(builderNumber) = builder.getBuilderColour();
+    residenceMasks.at(builderNumber) |= vertexBit(vertexNumber);
+    occupiedVertices |= vertexBit(vertexNumber);
+    hash ^= residenceKey(vertexNumber, vertices[vertexNumber].getResidence());
+    refreshPayoutsAround(vertexNumber);
 }
 
-bool Board::buildRoad(Builder& builder, int edgeNumber, std::ostream& out) {
-    Edge* edge;
-    try{
-        edge = getEdge(edgeNumber);
-    } catch (std::out_of_range& e) {
-        out << "Invalid edge number." << std::endl;
-        return false;
-    }
+uint64_t Board::residenceKey(int vertexNumber, const Residence& residence) {
+    return Zobrist::key(Zobrist::Feature::RESIDENCE, vertexNumber, residence.getOwner(), static_cast<int>(residence.getLevel()));
+}
 
-    // check if can build road on edge
-    if (!edge->canBuildRoad(builder)) {
-        out << "You cannot build here." << std::endl;
-        return false;
+// Rebuilds the payouts for every tile with the given value, shifting the later rows along to make room
+void Board::refreshPayouts(int tileValue) {
+    if (tileValue < 0 || tileValue > MAX_ROLL) {
+        // Never rolled, so never paid out
+        return;
     }
 
-    // check if builder has resources to build road
-    std::shared_ptr<Road> road = builder.tryBuildRoad(*edge);
+    Payout row[MAX_PAYOUTS];
+    int rowSize = 0;
+    for (int i = 0; i < NUM_TILES; i++) {
+        const Tile& tile = tiles[i];
+        if (tile.getTileValue() != tileValue || tile.hasGeese() || tile.getResource() == Resource::PARK) {
+            continue;
+        }
 
-    if (road != nullptr) {
-        edge->buildRoad(road);
-        out << "You have successfully built a road." << std::endl;
-        return true;
+        for (int j = 0; j < Topology::VERTICES_PER_TILE; j++) {
+            const Residence& residence = vertices[Topology::tileVertices[i * Topology::VERTICES_PER_TILE + j]].getResidence();
+            if (residence.exists()) {
+                row[rowSize++] = Payout{residence.getOwner(), tile.getResource(), residence.getResourceMultiplier()};
+            }
+        }
     }
 
-    out << "You do not have enough resources." << std::endl;
-    return false;
-}
-
-bool Board::buildResidence(Builder& builder, int vertexNumber, std::ostream& out) {
-    Vertex* vertex;
-    try{
-        vertex = getVertex(vertexNumber);
-    } catch (std::out_of_range& e) {
-        out << "Invalid vertex number." << std::endl;
-        return false;
+    int rowStart = payoutOffsets[tileValue];
+    int rowEnd = payoutOffsets[tileValue + 1];
+    int size = payouts.size();
+    int growth = rowSize - (rowEnd - rowStart);
+    if (growth > 0) {
+        payouts.resize(size + growth);
+        std::copy_backward(payouts.begin() + rowEnd, payouts.begin() + size, payouts.end());
     }
-
-    // check if can build residence on vertex
-    if (!vertex->canBuildResidence(builder)) {
-        out << "You cannot build here." << std::endl;
-        return false;
+    else if (growth < 0) {
+        std::copy(payouts.begin() + rowEnd, payouts.begin() + size, payouts.begin() + rowEnd + growth);
+        payouts.resize(size + growth);
     }
+    std::copy(row, row + rowSize, payouts.begin() + rowStart);
 
-    // check if builder has resources to build residence
-    std::shared_ptr<Residence> residence = builder.tryBuildResidence(*vertex);
-
-    if (residence != nullptr) {
-        vertex->buildResidence(residence);
-        out << "You have successfully built a residence." << std::endl;
-        return true;
+    for (int roll = tileValue + 1; roll <= MAX_ROLL + 1; roll++) {
+        payoutOffsets[roll] += growth;
     }
-
-    out << "You do not have enough resources." << std::endl;
-    return false;
 }
 
-bool Board::buildInitialResidence(Builder& builder, int vertexNumber, std::ostream& out) {
-    Vertex* vertex;
-    try{
-        vertex = getVertex(vertexNumber);
-    } catch (std::out_of_range& e) {
-        out << "Invalid vertex number." << std::endl;
-        return false;
+// Rebuilds the payouts of every tile touching the given vertex, once per distinct tile value
+void Board::refreshPayoutsAround(int vertexNumber) {
+    uint32_t tileValues = 0;
+    for (TileMask bits = vertexTileMasks[vertexNumber]; bits != 0; bits &= bits - 1) {
+        tileValues |= uint32_t{1} << tiles[lowestBit(bits)].getTileValue();
     }
-
-    // check if can build residence on vertex
-    if (!vertex->canBuildInitialResidence()) {
-        out << "You cannot build here." << std::endl;
-        return false;
+    for (; tileValues != 0; tileValues &= tileValues - 1) {
+        refreshPayouts(lowestBit(tileValues));
     }
-
-    std::shared_ptr<Residence> residence = builder.tryBuildInitialResidence(*vertex);
-    vertex->buildResidence(residence);
-    return true;
 }
 
-bool Board::upgradeResidence(Builder& builder, int vertexNumber, std::ostream& out) {
-    Vertex* vertex;
-    try{
-        vertex = getVertex(vertexNumber);
-    } catch (std::out_of_range& e) {
-        out << "Invalid vertex number." << std::endl;
-        return false;
+void Board::addTileYield(int tileNumber, int sign) {
+    const Tile& tile = tiles[tileNumber];
+    if (tile.getResource() == Resource::PARK) {
+        return;
     }
 
-    // check if can upgrade residence on vertex
-    if (!vertex->canUpgradeResidence(builder)) {
-        out << "You cannot upgrade this residence." << std::endl;
-        return false;
+    int ways = sign * rollWays(tile.getTileValue());
+    for (int j = 0; j < Topology::VERTICES_PER_TILE; j++) {
+        vertexYields[Topology::tileVertices[tileNumber * Topology::VERTICES_PER_TILE + j]][tile.getResource()] += ways;
     }
+}
 
-    // check if builder has resources to upgrade residence
-    std::shared_ptr<Residence> residence = builder.tryUpgradeResidence(*vertex);
-
-    if (residence != nullptr) {
-        vertex->upgradeResidence(residence);
-        out << "You have successfully upgraded your residence." << std::endl;
-        return true;
+bool Board::canBuildRoad(const Builder& builder, int edgeNumber) const {
+    if (occupiedEdges.test(edgeNumber)) {
+        // Road already exists!
+        return false;
     }
 
-    out << "You do not have enough resources." << std::endl;
-    return false;
+    // An endpoint must hold one of the builder's residences, or be empty and touch one of the builder's roads,
+    // so that roads never pass through someone else's residence
+    int builderNumber = builder.getBuilderNumber();
+    VertexMask reachable = residenceMasks.at(builderNumber) | (roadEndpointMasks.at(builderNumber) & ~occupiedVertices);
+    return (endpointMasks[edgeNumber] & reachable) != 0;
 }
 
-int Board::getGeeseTile() const {
-    return geeseTile;
+bool Board::canBuildResidence(const Builder& builder, int vertexNumber) const {
+    // Residence can only be built along an existing road owned by builder
+    return canBuildInitialResidence(vertexNumber) && (roadEndpointMasks.at(builder.getBuilderNumber()) & vertexBit(vertexNumber)) != 0;
 }
 
-void Board::setGeeseTile(int newGeeseTile) {
-    // Remove existing geese tiles, if applicable
-    if (geeseTile != -1) {
-        tiles.at(geeseTile) = tiles.at(geeseTile).get()->removeGeese();
-    }
-
-    // Incorporate the new geese tile
-    tiles.at(newGeeseTile) = std::make_unique<GeeseTile>(std::move(tiles.at(newGeeseTile)));
-    geeseTile = newGeeseTile;
+bool Board::canBuildInitialResidence(int vertexNumber) const {
+    // Neither this vertex nor any adjacent vertex may already hold a residence
+    return (occupiedVertices & spacingMasks[vertexNumber]) == 0;
 }
 
-BuilderInventoryUpdate Board::getResourcesFromDiceRoll(int rollNumber) const {
-    BuilderInventoryUpdate update;
-
-    for (size_t i = 0; i < tiles.size(); i++) {
-        if (tiles.at(i)->getTileValue() == rollNumber) {
-            update += tiles.at(i)->giveResourcesToBuilders();
+void Board::generateLegalActions(const Builder& builder, LegalActions& actions) const {
+    int builderNumber = builder.getBuilderNumber();
+
+    if (builder.inventory.canAfford(ROAD_COST)) {
+        // Roads may only leave a vertex that canBuildRoad accepts as an endpoint
+        VertexMask reachable = residenceMasks.at(builderNumber) | (roadEndpointMasks.at(builderNumber) & ~occupiedVertices);
+        EdgeMask candidates;
+        for (VertexMask bits = reachable; bits != 0; bits &= bits - 1) {
+            int vertexNumber = lowestBit(bits);
+            for (int j = Topology::vertexEdgeOffsets[vertexNumber]; j < Topology::vertexEdgeOffsets[vertexNumber + 1]; j++) {
+                candidates |= EdgeMask::bit(Topology::vertexEdges[j]);
+            }
         }
-    }
+        candidates &= ~occupiedEdges;
 
-    return update;
-}
-
-void Board::printBoard(std::ostream& out) const {
-    out << "                          " + printVertex(0) + printEdge(0, true) + printVertex(1) << std::endl;
-    out << "                            |         |" << std::endl;
-    out << "                           " << printEdge(1, false) + "    0   " + printEdge(2, false) << std::endl;
-    out << "                            |" + printResource(0) + "|" << std::endl;
-    out << "                " + printVertex(2) + printEdge(3, true) + printVertex(3) + printTile(0) + printVertex(4) + printEdge(4, true) + printVertex(5) << std::endl;
-    out << "                  |         |" + printGeese(0) + "|         |" << std::endl;
-    out << "                 " + printEdge(5, false) + "    1   " + printEdge(6, false) + "        " + printEdge(7, false) + "    2   " + printEdge(8, false) << std::endl;
-    out << "                  |" + printResource(1) + "|         |" + printResource(2) + "|" << std::endl;
-    out << "      " + printVertex(6) + printEdge(9, true) + printVertex(7) + printTile(1) + printVertex(8) + printEdge(10, true) + printVertex(9) + printTile(2) + printVertex(10) + printEdge(11, true) + printVertex(11) << std::endl;
-    out << "        |         |" + printGeese(1) + "|         |" + printGeese(2) + "|         |" << std::endl;
-    out << "       " + printEdge(12, false) + "    3   " + printEdge(13, false) + "        " + printEdge(14, false) + "    4   " + printEdge(15, false) + "        " + printEdge(16, false) + "    5   " + printEdge(17, false) << std::endl;
-    out << "        |" + printResource(3) + "|         |" + printResource(4) + "|         |" + printResource(5) + "|" << std::endl;
-    out << "      " + printVertex(12) + printTile(3) + printVertex(13) + printEdge(18, true) + printVertex(14) + printTile(4) + printVertex(15) + printEdge(19, true) + printVertex(16) + printTile(5) + printVertex(17) << std::endl;
-    out << "        |" + printGeese(3) + "|         |" + printGeese(4) + "|         |" + printGeese(5) + "|" << std::endl;
-    out << "       " + printEdge(20, false) + "        " + printEdge(21, false) + "    6   " + printEdge(22, false) + "        " + printEdge(23, false) + "    7   " + printEdge(24, false) + "        " + printEdge(25, false) << std::endl;
-    out << "        |         |" + printResource(6) + "|         |" + printResource(7) + "|         |" << std::endl;
-    out << "      " + printVertex(18) + printEdge(26, true) + printVertex(19) + printTile(6) + printVertex(20) + printEdge(27, true) + printVertex(21) + printTile(7) + printVertex(22) + printEdge(28, true) + printVertex(23) << std::endl;
-    out << "        |         |" + printGeese(6) + "|         |" + printGeese(7) + "|         |" << std::endl;
-    out << "       " + printEdge(29, false) + "    8   " + printEdge(30, false) + "        " + printEdge(31, false) + "    9   " + printEdge(32, false) + "        " + printEdge(33, false) + "   10   " + printEdge(34, false) << std::endl;
-    out << "        |" + printResource(8) + "|         |" + printResource(9) + "|         |" + printResource(10) + "|" << std::endl;
-    out << "      " + printVertex(24) + printTile(8) + printVertex(25) + printEdge(35, true) + printVertex(26) + printTile(9) + printVertex(27) + printEdge(36, true) + printVertex(28) + printTile(10) + printVertex(29) << std::endl;
-    out << "        |" + printGeese(8) + "|         |" + printGeese(9) + "|         |" + printGeese(10) + "|" << std::endl;
-    out << "       " + printEdge(37, false) + "        " + printEdge(38, false) + "   11   " + printEdge(39, false) + "        " + printEdge(40, false) + "   12   " + printEdge(41, false) + "        " + printEdge(42, false) << std::endl;
-    out << "        |         |" + printResource(11) + "|         |" + printResource(12) + "|         |" << std::endl;
-    out << "      " + printVertex(30) + printEdge(43, true) + printVertex(31) + printTile(11) + printVertex(32) + printEdge(44, true) + printVertex(33) + printTile(12) + printVertex(34) + printEdge(45, true) + printVertex(35) << std::endl;
-    out << "        |         |" + printGeese(11) + "|         |" + printGeese(12) + "|         |" << std::endl;
-    out << "       " + printEdge(46, false) + "   13   " + printEdge(47, false) + "        " + printEdge(48, false) + "   14   " + printEdge(49, false) + "        " + printEdge(50, false) + "   15   " + printEdge(51, false) << std::endl;
-    out << "        |" + printResource(13) + "|         |" + printResource(14) + "|         |" + printResource(15) + "|" << std::endl;
-    out << "      " + printVertex(36) + printTile(13) + printVertex(37) + printEdge(52, true) + printVertex(38) + printTile(14) + printVertex(39) + printEdge(53, true) + printVertex(40) + printTile(15) + printVertex(41) << std::endl;
-    out << "        |" + printGeese(13) + "|         |" + printGeese(14) + "|         |" + printGeese(15) + "|" << std::endl;
-    out << "       " + printEdge(54, false) + "        " + printEdge(55, false) + "   16   " + printEdge(56, false) + "        " + printEdge(57, false) + "   17   " + printEdge(58, false) + "        " + printEdge(59, false) << std::endl;
-    out << "        |         |" + printResource(16) + "|         |" + printResource(17) + "|         |" << std::endl;
-    out << "      " + printVertex(42) + printEdge(60, true) + printVertex(43) + printTile(16) + printVertex(44) + printEdge(61, true) + printVertex(45) + printTile(17) + printVertex(46) + printEdge(62, true) + printVertex(47) << std::endl;
-    out << "                  |" + printGeese(16) + "|         |" + printGeese(17) + "|" << std::endl;
-    out << "                 " + printEdge(63, false) + "        " + printEdge(64, false) + "   18   " + printEdge(65, false) + "        " + printEdge(66, false) << std::endl;
-    out << "                  |         |" + printResource(18) + "|         |" << std::endl;
-    out << "                " + printVertex(48) + printEdge(67, true) + printVertex(49) + printTile(18) + printVertex(50) + printEdge(68, true) + printVertex(51) << std::endl;
-    out << "                            |" + printGeese(18) + "|" << std::endl;
-    out << "                           " + printEdge(69, false) + "        " + printEdge(70, false) << std::endl;
-    out << "                            |         |" << std::endl;
-    out << "                          " + printVertex(52) + printEdge(71, true) + printVertex(53) << std::endl;
-}
-
-std::string Board::printVertex(int vertexNumber) const {
-    Vertex* vertex = getVertex(vertexNumber);
-    std::string vertexString = "|";
-
-    if (vertex->getResidence() == nullptr) {
-        if (vertexNumber < 10) {
-            vertexString += " ";
+        for (int word = 0; word < 2; word++) {
+            for (uint64_t bits = word == 0 ? candidates.lo : candidates.hi; bits != 0; bits &= bits - 1) {
+                actions.emplace_back(Action{ActionType::BUILD_ROAD, 64 * word + lowestBit(bits)});
+            }
         }
-        vertexString += std::to_string(vertexNumber) + "|";
     }
-    else {
-        vertexString += vertex->getResidence()->getOwner().getBuilderColour();
-        vertexString += vertex->getResidence()->getResidenceLetter();
-        vertexString += "|";
-    }
-
-    return vertexString;
-}
-
-std::string Board::printEdge(int edgeNumber, bool isHorizontal) const {
-    Edge* edge = getEdge(edgeNumber);
-    std::string edgeString = "";
 
-    if (isHorizontal) {
-        edgeString += "--";
-    }
-
-    if (edge->getRoad() == nullptr) {
-        if (edgeNumber < 10) {
-            edgeString += " ";
+    if (builder.inventory.canAfford(BASEMENT_COST)) {
+        for (VertexMask bits = roadEndpointMasks.at(builderNumber) & ~occupiedVertices; bits != 0; bits &= bits - 1) {
+            int vertexNumber = lowestBit(bits);
+            if ((occupiedVertices & spacingMasks[vertexNumber]) == 0) {
+                actions.emplace_back(Action{ActionType::BUILD_RESIDENCE, vertexNumber});
+            }
         }
-        edgeString += std::to_string(edgeNumber);
-    }
-    else {
-        edgeString += edge->getRoad()->getOwner().getBuilderColour();
-        edgeString += "R";
     }
 
-    if (isHorizontal) {
-        edgeString += "--";
+    for (int vertexNumber : builder.residences) {
+        ResidenceLevel level = vertices[vertexNumber].getResidence().getLevel();
+        if ((level == ResidenceLevel::BASEMENT && builder.inventory.canAfford(HOUSE_COST)) || (level == ResidenceLevel::HOUSE && builder.inventory.canAfford(TOWER_COST))) {
+            actions.emplace_back(Action{ActionType::IMPROVE, vertexNumber});
+        }
     }
-
-    return edgeString;
 }
 
-std::string Board::printTile(int tileNumber) const {
-    AbstractTile* tile = getTile(tileNumber);
-    std::string tileString = "  ";
-
-    if (tile->getTileValue() == 7) {
-        tileString += "    ";
-        return tileString;
+std::vector<int> Board::getStealCandidates(int tileNumber, const Builder& builder) const {
+    std::vector<int> builders;
+    for (int j = 0; j < Topology::VERTICES_PER_TILE; j++) {
+        const Residence& residence = vertices[Topology::tileVertices[tileNumber * Topology::VERTICES_PER_TILE + j]].getResidence();
+        int owner = residence.getOwner();
+        if (residence.exists() && owner != builder.getBuilderNumber() && std::find(builders.begin(), builders.end(), owner) == builders.end()) {
+            builders.emplace_back(owner);
+        }
     }
+    return builders;
+}
 
-    if (tile->getTileValue() < 10) {
-        tileString += " ";
-    }
+VertexMask Board::getResidenceMask(int builderNumber) const {
+    return residenceMasks.at(builderNumber);
+}
 
-    tileString += std::to_string(tile->getTileValue());
-    tileString += "  ";
-    return tileString;
+EdgeMask Board::getRoadMask(int builderNumber) const {
+    return roadMasks.at(builderNumber);
 }
 
-std::string Board::printResource(int tileNumber) const {
-    AbstractTile* tile = getTile(tileNumber);
-    Resource resource = tile->getResource();
+const Tile* Board::getTile(int tileNumber) const {
+    return &tiles.at(tileNumber);
+}
 
-    // Add leading spaces
-    std::string tileString = resource == ENERGY ? " " : "  ";
+const Vertex* Board::getVertex(int vertexNumber) const {
+    return &vertices.at(vertexNumber);
+}
 
-    // Append Resource as string
-    tileString += resourceToString(resource);
+const Edge* Board::getEdge(int edgeNumber) const {
+    return &edges.at(edgeNumber);
+}
 
-    // Append trailing spaces
-    tileString += resource <= GLASS ? "  " : "   ";
+Vertex* Board::getMutableVertex(int vertexNumber) {
+    return &vertices.at(vertexNumber);
+}
 
-    return tileString;
+Edge* Board::getMutableEdge(int edgeNumber) {
+    return &edges.at(edgeNumber);
 }
 
-std::string Board::printGeese(int tileNumber) const {
-    AbstractTile* tile = getTile(tileNumber);
-    std::string tileString = "";
+ActionStatus Board::buildRoad(Builder& builder, int edgeNumber) {
+    if (edgeNumber < 0 || edgeNumber >= NUM_EDGES) {
+        return ActionStatus::INVALID_LOCATION;
+    }
+    Edge* edge = getMutableEdge(edgeNumber);
 
-    if (tile->hasGeese()) {
-        tileString += "  GEESE  ";
+    // check if can build road on edge
+    if (!canBuildRoad(builder, edgeNumber)) {
+        return ActionStatus::CANNOT_BUILD;
     }
-    else {
-        tileString += "         ";
+
+    // check if builder has resources to build road
+    if (!builder.tryBuildRoad(*edge)) {
+        return ActionStatus::INSUFFICIENT_RESOURCES;
     }
 
-    return tileString;
+    edge->buildRoad(Road{builder.getBuilderNumber()});
+    markRoad(builder, edgeNumber);
+    return ActionStatus::SUCCESS;
 }
 
-void Board::setupVertices() {
-    vertices[0]->addNeighbouringEdge(edges[0].get());
-    vertices[0]->addNeighbouringEdge(edges[1].get());
-
-    vertices[1]->addNeighbouringEdge(edges[0].get());
-    vertices[1]->addNeighbouringEdge(edges[2].get());
-
-    vertices[2]->addNeighbouringEdge(edges[3].get());
-    vertices[2]->addNeighbouringEdge(edges[5].get());
-
-    vertices[3]->addNeighbouringEdge(edges[1].get());
-    vertices[3]->addNeighbouringEdge(edges[3].get());
-    vertices[3]->addNeighbouringEdge(edges[6].get());
-
-    vertices[4]->addNeighbouringEdge(edges[2].get());
-    vertices[4]->addNeighbouringEdge(edges[4].get());
-    vertices[4]->addNeighbouringEdge(edges[7].get());
-
-    vertices[5]->addNeighbouringEdge(edges[4].get());
-    vertices[5]->addNeighbouringEdge(edges[8].get());
-
-    vertices[6]->addNeighbouringEdge(edges[9].get());
-    vertices[6]->addNeighbouringEdge(edges[12].get());
-
-    vertices[7]->addNeighbouringEdge(edges[5].get());
-    vertices[7]->addNeighbouringEdge(edges[9].get());
-    vertices[7]->addNeighbouringEdge(edges[13].get());
-
-    vertices[8]->addNeighbouringEdge(edges[6].get());
-    vertices[8]->addNeighbouringEdge(edges[10].get());
-    vertices[8]->addNeighbouringEdge(edges[14].get());
-
-    vertices[9]->addNeighbouringEdge(edges[7].get());
-    vertices[9]->addNeighbouringEdge(edges[10].get());
-    vertices[9]->addNeighbouringEdge(edges[15].get());
-
-    vertices[10]->addNeighbouringEdge(edges[8].get());
-    vertices[10]->addNeighbouringEdge(edges[11].get());
-    vertices[10]->addNeighbouringEdge(edges[16].get());
-
-    vertices[11]->addNeighbouringEdge(edges[11].get());
-    vertices[11]->addNeighbouringEdge(edges[17].get());
-
-    vertices[12]->addNeighbouringEdge(edges[12].get());
-    vertices[12]->addNeighbouringEdge(edges[20].get());
-
-    vertices[13]->addNeighbouringEdge(edges[13].get());
-    vertices[13]->addNeighbouringEdge(edges[18].get());
-    vertices[13]->addNeighbouringEdge(edges[21].get());
-
-    vertices[14]->addNeighbouringEdge(edges[14].get());
-    vertices[14]->addNeighbouringEdge(edges[18].get());
-    vertices[14]->addNeighbouringEdge(edges[22].get());
-
-    vertices[15]->addNeighbouringEdge(edges[15].get());
-    vertices[15]->addNeighbouringEdge(edges[19].get());
-    vertices[15]->addNeighbouringEdge(edges[23].get());
-
-    vertices[16]->addNeighbouringEdge(edges[16].get());
-    vertices[16]->addNeighbouringEdge(edges[19].get());
-    vertices[16]->addNeighbouringEdge(edges[24].get());
-
-    vertices[17]->addNeighbouringEdge(edges[17].get());
-    vertices[17]->addNeighbouringEdge(edges[25].get());
-
-    vertices[18]->addNeighbouringEdge(edges[20].get());
-    vertices[18]->addNeighbouringEdge(edges[26].get());
-    vertices[18]->addNeighbouringEdge(edges[29].get());
-
-    vertices[19]->addNeighbouringEdge(edges[21].get());
-    vertices[19]->addNeighbouringEdge(edges[26].get());
-    vertices[19]->addNeighbouringEdge(edges[30].get());
-
-    vertices[20]->addNeighbouringEdge(edges[22].get());
-    vertices[20]->addNeighbouringEdge(edges[27].get());
-    vertices[20]->addNeighbouringEdge(edges[31].get());
-
-    vertices[21]->addNeighbouringEdge(edges[23].get());
-    vertices[21]->addNeighbouringEdge(edges[27].get());
-    vertices[21]->addNeighbouringEdge(edges[32].get());
-
-    vertices[22]->addNeighbouringEdge(edges[24].get());
-    vertices[22]->addNeighbouringEdge(edges[28].get());
-    vertices[22]->addNeighbouringEdge(edges[33].get());
-
-    vertices[23]->addNeighbouringEdge(edges[25].get());
-    vertices[23]->addNeighbouringEdge(edges[28].get());
-    vertices[23]->addNeighbouringEdge(edges[34].get());
-
-    vertices[24]->addNeighbouringEdge(edges[29].get());
-    vertices[24]->addNeighbouringEdge(edges[37].get());
-
-    vertices[25]->addNeighbouringEdge(edges[30].get());
-    vertices[25]->addNeighbouringEdge(edges[35].get());
-    vertices[25]->addNeighbouringEdge(edges[38].get());
-
-    vertices[26]->addNeighbouringEdge(edges[31].get());
-    vertices[26]->addNeighbouringEdge(edges[35].get());
-    vertices[26]->addNeighbouringEdge(edges[39].get());
-
-    vertices[27]->addNeighbouringEdge(edges[32].get());
-    vertices[27]->addNeighbouringEdge(edges[36].get());
-    vertices[27]->addNeighbouringEdge(edges[40].get());
-
-    vertices[28]->addNeighbouringEdge(edges[33].get());
-    vertices[28]->addNeighbouringEdge(edges[36].get());
-    vertices[28]->addNeighbouringEdge(edges[41].get());
-
-    vertices[29]->addNeighbouringEdge(edges[34].get());
-    vertices[29]->addNeighbouringEdge(edges[42].get());
-
-    vertices[30]->addNeighbouringEdge(edges[37].get());
-    vertices[30]->addNeighbouringEdge(edges[43].get());
-    vertices[30]->addNeighbouringEdge(edges[46].get());
-
-    vertices[31]->addNeighbouringEdge(edges[38].get());
-    vertices[31]->addNeighbouringEdge(edges[43].get());
-    vertices[31]->addNeighbouringEdge(edges[47].get());
-
-    vertices[32]->addNeighbouringEdge(edges[39].get());
-    vertices[32]->addNeighbouringEdge(edges[44].get());
-    vertices[32]->addNeighbouringEdge(edges[48].get());
-
-    vertices[33]->addNeighbouringEdge(edges[40].get());
-    vertices[33]->addNeighbouringEdge(edges[44].get());
-    vertices[33]->addNeighbouringEdge(edges[49].get());
-
-    vertices[34]->addNeighbouringEdge(edges[41].get());
-    vertices[34]->addNeighbouringEdge(edges[45].get());
-    vertices[34]->addNeighbouringEdge(edges[50].get());
-
-    vertices[35]->addNeighbouringEdge(edges[42].get());
-    vertices[35]->addNeighbouringEdge(edges[45].get());
-    vertices[35]->addNeighbouringEdge(edges[51].get());
-
-    vertices[36]->addNeighbouringEdge(edges[46].get());
-    vertices[36]->addNeighbouringEdge(edges[54].get());
-
-    vertices[37]->addNeighbouringEdge(edges[47].get());
-    vertices[37]->addNeighbouringEdge(edges[52].get());
-    vertices[37]->addNeighbouringEdge(edges[55].get());
-
-    vertices[38]->addNeighbouringEdge(edges[48].get());
-    vertices[38]->addNeighbouringEdge(edges[52].get());
-    vertices[38]->addNeighbouringEdge(edges[56].get());
-
-    vertices[39]->addNeighbouringEdge(edges[49].get());
-    vertices[39]->addNeighbouringEdge(edges[53].get());
-    vertices[39]->addNeighbouringEdge(edges[57].get());
-
-    vertices[40]->addNeighbouringEdge(edges[50].get());
-    vertices[40]->addNeighbouringEdge(edges[53].get());
-    vertices[40]->addNeighbouringEdge(edges[58].get());
-
-    vertices[41]->addNeighbouringEdge(edges[51].get());
-    vertices[41]->addNeighbouringEdge(edges[59].get());
-
-    vertices[42]->addNeighbouringEdge(edges[54].get());
-    vertices[42]->addNeighbouringEdge(edges[60].get());
-
-    vertices[43]->addNeighbouringEdge(edges[55].get());
-    vertices[43]->addNeighbouringEdge(edges[60].get());
-    vertices[43]->addNeighbouringEdge(edges[63].get());
-
-    vertices[44]->addNeighbouringEdge(edges[56].get());
-    vertices[44]->addNeighbouringEdge(edges[61].get());
-    vertices[44]->addNeighbouringEdge(edges[64].get());
-
-    vertices[45]->addNeighbouringEdge(edges[57].get());
-    vertices[45]->addNeighbouringEdge(edges[61].get());
-    vertices[45]->addNeighbouringEdge(edges[65].get());
-
-    vertices[46]->addNeighbouringEdge(edges[58].get());
-    vertices[46]->addNeighbouringEdge(edges[62].get());
-    vertices[46]->addNeighbouringEdge(edges[66].get());
-
-    vertices[47]->addNeighbouringEdge(edges[59].get());
-    vertices[47]->addNeighbouringEdge(edges[62].get());
-
-    vertices[48]->addNeighbouringEdge(edges[63].get());
-    vertices[48]->addNeighbouringEdge(edges[67].get());
-
-    vertices[49]->addNeighbouringEdge(edges[64].get());
-    vertices[49]->addNeighbouringEdge(edges[67].get());
-    vertices[49]->addNeighbouringEdge(edges[69].get());
-
-    vertices[50]->addNeighbouringEdge(edges[65].get());
-    vertices[50]->addNeighbouringEdge(edges[68].get());
-    vertices[50]->addNeighbouringEdge(edges[70].get());
+ActionStatus Board::buildResidence(Builder& builder, int vertexNumber) {
+    if (vertexNumber < 0 || vertexNumber >= NUM_VERTICES) {
+        return ActionStatus::INVALID_LOCATION;
+    }
+    Vertex* vertex = getMutableVertex(vertexNumber);
 
-    vertices[51]->addNeighbouringEdge(edges[66].get());
-    vertices[51]->addNeighbouringEdge(edges[68].get());
+    // check if can build residence on vertex
+    if (!canBuildResidence(builder, vertexNumber)) {
+        return ActionStatus::CANNOT_BUILD;
+    }
 
-    vertices[52]->addNeighbouringEdge(edges[69].get());
-    vertices[52]->addNeighbouringEdge(edges[71].get());
+    // check if builder has resources to build residence
+    if (!builder.tryBuildResidence(*vertex)) {
+        return ActionStatus::INSUFFICIENT_RESOURCES;
+    }
 
-    vertices[53]->addNeighbouringEdge(edges[70].get());
-    vertices[53]->addNeighbouringEdge(edges[71].get());
+    vertex->buildResidence(Residence{builder.getBuilderNumber()});
+    markResidence(builder, vertexNumber);
+    return ActionStatus::SUCCESS;
 }
 
-void Board::setupEdges() {
-    edges[0]->addNeighbouringVertex(vertices[0].get());
-    edges[0]->addNeighbouringVertex(vertices[1].get());
-
-    edges[1]->addNeighbouringVertex(vertices[0].get());
-    edges[1]->addNeighbouringVertex(vertices[3].get());
-
-    edges[2]->addNeighbouringVertex(vertices[1].get());
-    edges[2]->addNeighbouringVertex(vertices[4].get());
-
-    edges[3]->addNeighbouringVertex(vertices[2].get());
-    edges[3]->addNeighbouringVertex(vertices[3].get());
-
-    edges[4]->addNeighbouringVertex(vertices[4].get());
-    edges[4]->addNeighbouringVertex(vertices[5].get());
-
-    edges[5]->addNeighbouringVertex(vertices[2].get());
-    edges[5]->addNeighbouringVertex(vertices[7].get());
-
-    edges[6]->addNeighbouringVertex(vertices[3].get());
-    edges[6]->addNeighbouringVertex(vertices[8].get());
-
-    edges[7]->addNeighbouringVertex(vertices[4].get());
-    edges[7]->addNeighbouringVertex(vertices[9].get());
-
-    edges[8]->addNeighbouringVertex(vertices[5].get());
-    edges[8]->addNeighbouringVertex(vertices[10].get());
-
-    edges[9]->addNeighbouringVertex(vertices[6].get());
-    edges[9]->addNeighbouringVertex(vertices[7].get());
-
-    edges[10]->addNeighbouringVertex(vertices[8].get());
-    edges[10]->addNeighbouringVertex(vertices[9].get());
-
-    edges[11]->addNeighbouringVertex(vertices[10].get());
-    edges[11]->addNeighbouringVertex(vertices[11].get());
-
-    edges[12]->addNeighbouringVertex(vertices[6].get());
-    edges[12]->addNeighbouringVertex(vertices[12].get());
-
-    edges[13]->addNeighbouringVertex(vertices[7].get());
-    edges[13]->addNeighbouringVertex(vertices[13].get());
-
-    edges[14]->addNeighbouringVertex(vertices[8].get());
-    edges[14]->addNeighbouringVertex(vertices[14].get());
-
-    edges[15]->addNeighbouringVertex(vertices[9].get());
-    edges[15]->addNeighbouringVertex(vertices[15].get());
-
-    edges[16]->addNeighbouringVertex(vertices[10].get());
-    edges[16]->addNeighbouringVertex(vertices[16].get());
-
-    edges[17]->addNeighbouringVertex(vertices[11].get());
-    edges[17]->addNeighbouringVertex(vertices[17].get());
-
-    edges[18]->addNeighbouringVertex(vertices[13].get());
-    edges[18]->addNeighbouringVertex(vertices[14].get());
-
-    edges[19]->addNeighbouringVertex(vertices[15].get());
-    edges[19]->addNeighbouringVertex(vertices[16].get());
-
-    edges[20]->addNeighbouringVertex(vertices[12].get());
-    edges[20]->addNeighbouringVertex(vertices[18].get());
-
-    edges[21]->addNeighbouringVertex(vertices[13].get());
-    edges[21]->addNeighbouringVertex(vertices[19].get());
-
-    edges[22]->addNeighbouringVertex(vertices[14].get());
-    edges[22]->addNeighbouringVertex(vertices[20].get());
-
-    edges[23]->addNeighbouringVertex(vertices[15].get());
-    edges[23]->addNeighbouringVertex(vertices[21].get());
-
-    edges[24]->addNeighbouringVertex(vertices[16].get());
-    edges[24]->addNeighbouringVertex(vertices[22].get());
-
-    edges[25]->addNeighbouringVertex(vertices[17].get());
-    edges[25]->addNeighbouringVertex(vertices[23].get());
-
-    edges[26]->addNeighbouringVertex(vertices[18].get());
-    edges[26]->addNeighbouringVertex(vertices[19].get());
-
-    edges[27]->addNeighbouringVertex(vertices[20].get());
-    edges[27]->addNeighbouringVertex(vertices[21].get());
-
-    edges[28]->addNeighbouringVertex(vertices[22].get());
-    edges[28]->addNeighbouringVertex(vertices[23].get());
-
-    edges[29]->addNeighbouringVertex(vertices[18].get());
-    edges[29]->addNeighbouringVertex(vertices[24].get());
-
-    edges[30]->addNeighbouringVertex(vertices[19].get());
-    edges[30]->addNeighbouringVertex(vertices[25].get());
-
-    edges[31]->addNeighbouringVertex(vertices[20].get());
-    edges[31]->addNeighbouringVertex(vertices[26].get());
-
-    edges[32]->addNeighbouringVertex(vertices[21].get());
-    edges[32]->addNeighbouringVertex(vertices[27].get());
-
-    edges[33]->addNeighbouringVertex(vertices[22].get());
-    edges[33]->addNeighbouringVertex(vertices[28].get());
-
-    edges[34]->addNeighbouringVertex(vertices[23].get());
-    edges[34]->addNeighbouringVertex(vertices[29].get());
-
-    edges[35]->addNeighbouringVertex(vertices[25].get());
-    edges[35]->addNeighbouringVertex(vertices[26].get());
-
-    edges[36]->addNeighbouringVertex(vertices[27].get());
-    edges[36]->addNeighbouringVertex(vertices[28].get());
-
-    edges[37]->addNeighbouringVertex(vertices[24].get());
-    edges[37]->addNeighbouringVertex(vertices[30].get());
-
-    edges[38]->addNeighbouringVertex(vertices[25].get());
-    edges[38]->addNeighbouringVertex(vertices[31].get());
-
-    edges[39]->addNeighbouringVertex(vertices[26].get());
-    edges[39]->addNeighbouringVertex(vertices[32].get());
-
-    edges[40]->addNeighbouringVertex(vertices[27].get());
-    edges[40]->addNeighbouringVertex(vertices[33].get());
-
-    edges[41]->addNeighbouringVertex(vertices[28].get());
-    edges[41]->addNeighbouringVertex(vertices[34].get());
-
-    edges[42]->addNeighbouringVertex(vertices[29].get());
-    edges[42]->addNeighbouringVertex(vertices[35].get());
-
-    edges[43]->addNeighbouringVertex(vertices[30].get());
-    edges[43]->addNeighbouringVertex(vertices[31].get());
+ActionStatus Board::buildInitialResidence(Builder& builder, int vertexNumber) {
+    if (vertexNumber < 0 || vertexNumber >= NUM_VERTICES) {
+        return ActionStatus::INVALID_LOCATION;
+    }
+    Vertex* vertex = getMutableVertex(vertexNumber);
 
-    edges[44]->addNeighbouringVertex(vertices[32].get());
-    edges[44]->addNeighbouringVertex(vertices[33].get());
+    // check if can build residence on vertex
+    if (!canBuildInitialResidence(vertexNumber)) {
+        return ActionStatus::CANNOT_BUILD;
+    }
 
-    edges[45]->addNeighbouringVertex(vertices[34].get());
-    edges[45]->addNeighbouringVertex(vertices[35].get());
+    builder.tryBuildInitialResidence(*vertex);
+    vertex->buildResidence(Residence{builder.getBuilderNumber()});
+    markResidence(builder, vertexNumber);
+    return ActionStatus::SUCCESS;
+}
 
-    edges[46]->addNeighbouringVertex(vertices[30].get());
-    edges[46]->addNeighbouringVertex(vertices[36].get());
+ActionStatus Board::upgradeResidence(Builder& builder, int vertexNumber) {
+    if (vertexNumber < 0 || vertexNumber >= NUM_VERTICES) {
+        return ActionStatus::INVALID_LOCATION;
+    }
+    Vertex* vertex = getMutableVertex(vertexNumber);
 
-    edges[47]->addNeighbouringVertex(vertices[31].get());
-    edges[47]->addNeighbouringVertex(vertices[37].get());
+    // check if can upgrade residence on vertex
+    if (!vertex->canUpgradeResidence(builder)) {
+        return ActionStatus::CANNOT_BUILD;
+    }
 
-    edges[48]->addNeighbouringVertex(vertices[32].get());
-    edges[48]->addNeighbouringVertex(vertices[38].get());
+    // check if builder has resources to upgrade residence
+    if (!builder.tryUpgradeResidence(*vertex)) {
+        return ActionStatus::INSUFFICIENT_RESOURCES;
+    }
 
-    edges[49]->addNeighbouringVertex(vertices[33].get());
-    edges[49]->addNeighbouringVertex(vertices[39].get());
+    hash ^= residenceKey(vertexNumber, vertex->getResidence());
+    vertex->upgradeResidence();
+    hash ^= residenceKey(vertexNumber, vertex->getResidence());
+    refreshPayoutsAround(vertexNumber);
+    return ActionStatus::SUCCESS;
+}
 
-    edges[50]->addNeighbouringVertex(vertices[34].get());
-    edges[50]->addNeighbouringVertex(vertices[40].get());
+void Board::unbuildRoad(Builder& builder, int edgeNumber) {
+    int builderNumber = builder.getBuilderNumber();
+    builder.unbuildRoad();
+    getMutableEdge(edgeNumber)->buildRoad(Road{});
+    roadMasks.at(builderNumber) &= ~EdgeMask::bit(edgeNumber);
+    occupiedEdges &= ~EdgeMask::bit(edgeNumber);
+    hash ^= Zobrist::key(Zobrist::Feature::ROAD, edgeNumber, builderNumber);
+
+    // An endpoint stays reachable only while another of the builder's roads still touches it
+    for (int i = 0; i < Topology::VERTICES_PER_EDGE; i++) {
+        int vertexNumber = Topology::edgeVertices[edgeNumber * Topology::VERTICES_PER_EDGE + i];
+        bool touched = false;
+        for (int j = Topology::vertexEdgeOffsets[vertexNumber]; j < Topology::vertexEdgeOffsets[vertexNumber + 1]; j++) {
+            touched = touched || roadMasks[builderNumber].test(Topology::vertexEdges[j]);
+        }
+        if (!touched) {
+            roadEndpointMasks[builderNumber] &= ~vertexBit(vertexNumber);
+        }
+    }
+}
 
-    edges[51]->addNeighbouringVertex(vertices[35].get());
-    edges[51]->addNeighbouringVertex(vertices[41].get());
+void Board::unbuildResidence(Builder& builder, int vertexNumber) {
+    builder.unbuildResidence();
+    hash ^= residenceKey(vertexNumber, vertices.at(vertexNumber).getResidence());
+    getMutableVertex(vertexNumber)->buildResidence(Residence{});
+    residenceMasks.at(builder.getBuilderNumber()) &= ~vertexBit(vertexNumber);
+    occupiedVertices &= ~vertexBit(vertexNumber);
+    refreshPayoutsAround(vertexNumber);
+}
 
-    edges[52]->addNeighbouringVertex(vertices[37].get());
-    edges[52]->addNeighbouringVertex(vertices[38].get());
+void Board::downgradeResidence(Builder& builder, int vertexNumber) {
+    Vertex* vertex = getMutableVertex(vertexNumber);
+    const Residence& residence = vertex->getResidence();
+    builder.downgradeResidence();
+    hash ^= residenceKey(vertexNumber, residence);
+    vertex->buildResidence(Residence{residence.getOwner(), static_cast<ResidenceLevel>(static_cast<int>(residence.getLevel()) - 1)});
+    hash ^= residenceKey(vertexNumber, residence);
+    refreshPayoutsAround(vertexNumber);
+}
 
-    edges[53]->addNeighbouringVertex(vertices[39].get());
-    edges[53]->addNeighbouringVertex(vertices[40].get());
+bool Board::buildRoad(Builder& builder, int edgeNumber, std::ostream& out) {
+    return printBuildStatus(ActionType::BUILD_ROAD, buildRoad(builder, edgeNumber), out);
+}
 
-    edges[54]->addNeighbouringVertex(vertices[36].get());
-    edges[54]->addNeighbouringVertex(vertices[42].get());
+bool Board::buildResidence(Builder& builder, int vertexNumber, std::ostream& out) {
+    return printBuildStatus(ActionType::BUILD_RESIDENCE, buildResidence(builder, vertexNumber), out);
+}
 
-    edges[55]->addNeighbouringVertex(vertices[37].get());
-    edges[55]->addNeighbouringVertex(vertices[43].get());
+bool Board::buildInitialResidence(Builder& builder, int vertexNumber, std::ostream& out) {
+    return printBuildStatus(ActionType::BUILD_INITIAL_RESIDENCE, buildInitialResidence(builder, vertexNumber), out);
+}
 
-    edges[56]->addNeighbouringVertex(vertices[38].get());
-    edges[56]->addNeighbouringVertex(vertices[44].get());
+bool Board::upgradeResidence(Builder& builder, int vertexNumber, std::ostream& out) {
+    return printBuildStatus(ActionType::IMPROVE, upgradeResidence(builder, vertexNumber), out);
+}
 
-    edges[57]->addNeighbouringVertex(vertices[39].get());
-    edges[57]->addNeighbouringVertex(vertices[45].get());
+bool Board::printBuildStatus(ActionType type, ActionStatus status, std::ostream& out) {
+    switch (status) {
+        case ActionStatus::SUCCESS:
+            if (type == ActionType::BUILD_ROAD) {
+                out << "You have successfully built a road.\n";
+            }
+            else if (type == ActionType::BUILD_RESIDENCE) {
+                out << "You have successfully built a residence.\n";
+            }
+            else if (type == ActionType::IMPROVE) {
+                out << "You have successfully upgraded your residence.\n";
+            }
+            return true;
+        case ActionStatus::INVALID_LOCATION:
+            out << (type == ActionType::BUILD_ROAD ? "Invalid edge number." : "Invalid vertex number.") << '\n';
+            return false;
+        case ActionStatus::CANNOT_BUILD:
+            out << (type == ActionType::IMPROVE ? "You cannot upgrade this residence." : "You cannot build here.") << '\n';
+            return false;
+        default:
+            out << "You do not have enough resources.\n";
+            return false;
+    }
+}
 
-    edges[58]->addNeighbouringVertex(vertices[40].get());
-    edges[58]->addNeighbouringVertex(vertices[46].get());
+uint64_t Board::getHash() const {
+    return hash;
+}
 
-    edges[59]->addNeighbouringVertex(vertices[41].get());
-    edges[59]->addNeighbouringVertex(vertices[47].get());
+int Board::getGeeseTile() const {
+    return geeseTile;
+}
 
-    edges[60]->addNeighbouringVertex(vertices[42].get());
-    edges[60]->addNeighbouringVertex(vertices[43].get());
+int Board::rollWays(int tileValue) {
+    return tileValue < 2 || tileValue > MAX_ROLL || tileValue == 7 ? 0 : 6 - std::abs(7 - tileValue);
+}
 
-    edges[61]->addNeighbouringVertex(vertices[44].get());
-    edges[61]->addNeighbouringVertex(vertices[45].get());
+const ResourceBundle& Board::getVertexYield(int vertexNumber) const {
+    return vertexYields.at(vertexNumber);
+}
 
-    edges[62]->addNeighbouringVertex(vertices[46].get());
-    edges[62]->addNeighbouringVertex(vertices[47].get());
+const std::array<ResourceBundle, Board::NUM_VERTICES>& Board::getVertexYields() const {
+    return vertexYields;
+}
 
-    edges[63]->addNeighbouringVertex(vertices[43].get());
-    edges[63]->addNeighbouringVertex(vertices[48].get());
+void Board::setGeeseTile(int newGeeseTile) {
+    Tile& newTile = tiles.at(newGeeseTile);
+    int oldGeeseTile = geeseTile;
 
-    edges[64]->addNeighbouringVertex(vertices[44].get());
-    edges[64]->addNeighbouringVertex(vertices[49].get());
+    if (oldGeeseTile != -1) {
+        tiles[oldGeeseTile].setGeese(false);
+        hash ^= Zobrist::key(Zobrist::Feature::GEESE, oldGeeseTile);
+        addTileYield(oldGeeseTile, 1);
+    }
+    newTile.setGeese(true);
+    geeseTile = newGeeseTile;
+    hash ^= Zobrist::key(Zobrist::Feature::GEESE, newGeeseTile);
+    addTileYield(newGeeseTile, -1);
 
-    edges[65]->addNeighbouringVertex(vertices[45].get());
-    edges[65]->addNeighbouringVertex(vertices[50].get());
+    // Only the rows of the two tiles' values change
+    if (oldGeeseTile != -1 && tiles[oldGeeseTile].getTileValue() != newTile.getTileValue()) {
+        refreshPayouts(tiles[oldGeeseTile].getTileValue());
+    }
+    refreshPayouts(newTile.getTileValue());
+}
 
-    edges[66]->addNeighbouringVertex(vertices[46].get());
-    edges[66]->addNeighbouringVertex(vertices[51].get());
+BuilderInventoryUpdate Board::getResourcesFromDiceRoll(int rollNumber) const {
+    BuilderInventoryUpdate update;
+    if (rollNumber < 0 || rollNumber > MAX_ROLL) {
+        return update;
+    }
 
-    edges[67]->addNeighbouringVertex(vertices[48].get());
-    edges[67]->addNeighbouringVertex(vertices[49].get());
+    for (int i = payoutOffsets[rollNumber]; i < payoutOffsets[rollNumber + 1]; i++) {
+        const Payout& payout = payouts[i];
+        update[payout.builder][payout.resource] += payout.amount;
+    }
 
-    edges[68]->addNeighbouringVertex(vertices[50].get());
-    edges[68]->addNeighbouringVertex(vertices[51].get());
+    return update;
+}
 
-    edges[69]->addNeighbouringVertex(vertices[49].get());
-    edges[69]->addNeighbouringVertex(vertices[52].get());
+char Board::getBuilderColour(int builderNumber) const {
+    return builderColours.at(builderNumber);
+}
 
-    edges[70]->addNeighbouringVertex(vertices[50].get());
-    edges[70]->addNeighbouringVertex(vertices[53].get());
-
-    edges[71]->addNeighbouringVertex(vertices[52].get());
-    edges[71]->addNeighbouringVertex(vertices[53].get());
-}
-
-void Board::setupTiles() {
-    tiles[0]->addNeighbouringVertex(vertices[0].get());
-    tiles[0]->addNeighbouringVertex(vertices[1].get());
-    tiles[0]->addNeighbouringVertex(vertices[3].get());
-    tiles[0]->addNeighbouringVertex(vertices[4].get());
-    tiles[0]->addNeighbouringVertex(vertices[8].get());
-    tiles[0]->addNeighbouringVertex(vertices[9].get());
-
-    tiles[1]->addNeighbouringVertex(vertices[2].get());
-    tiles[1]->addNeighbouringVertex(vertices[3].get());
-    tiles[1]->addNeighbouringVertex(vertices[7].get());
-    tiles[1]->addNeighbouringVertex(vertices[8].get());
-    tiles[1]->addNeighbouringVertex(vertices[13].get());
-    tiles[1]->addNeighbouringVertex(vertices[14].get());
-
-    tiles[2]->addNeighbouringVertex(vertices[4].get());
-    tiles[2]->addNeighbouringVertex(vertices[5].get());
-    tiles[2]->addNeighbouringVertex(vertices[9].get());
-    tiles[2]->addNeighbouringVertex(vertices[10].get());
-    tiles[2]->addNeighbouringVertex(vertices[15].get());
-    tiles[2]->addNeighbouringVertex(vertices[16].get());
-
-    tiles[3]->addNeighbouringVertex(vertices[6].get());
-    tiles[3]->addNeighbouringVertex(vertices[7].get());
-    tiles[3]->addNeighbouringVertex(vertices[12].get());
-    tiles[3]->addNeighbouringVertex(vertices[13].get());
-    tiles[3]->addNeighbouringVertex(vertices[18].get());
-    tiles[3]->addNeighbouringVertex(vertices[19].get());
-
-    tiles[4]->addNeighbouringVertex(vertices[8].get());
-    tiles[4]->addNeighbouringVertex(vertices[9].get());
-    tiles[4]->addNeighbouringVertex(vertices[14].get());
-    tiles[4]->addNeighbouringVertex(vertices[15].get());
-    tiles[4]->addNeighbouringVertex(vertices[20].get());
-    tiles[4]->addNeighbouringVertex(vertices[21].get());
-
-    tiles[5]->addNeighbouringVertex(vertices[10].get());
-    tiles[5]->addNeighbouringVertex(vertices[11].get());
-    tiles[5]->addNeighbouringVertex(vertices[16].get());
-    tiles[5]->addNeighbouringVertex(vertices[17].get());
-    tiles[5]->addNeighbouringVertex(vertices[22].get());
-    tiles[5]->addNeighbouringVertex(vertices[23].get());
-
-    tiles[6]->addNeighbouringVertex(vertices[13].get());
-    tiles[6]->addNeighbouringVertex(vertices[14].get());
-    tiles[6]->addNeighbouringVertex(vertices[19].get());
-    tiles[6]->addNeighbouringVertex(vertices[20].get());
-    tiles[6]->addNeighbouringVertex(vertices[25].get());
-    tiles[6]->addNeighbouringVertex(vertices[26].get());
-
-    tiles[7]->addNeighbouringVertex(vertices[15].get());
-    tiles[7]->addNeighbouringVertex(vertices[16].get());
-    tiles[7]->addNeighbouringVertex(vertices[21].get());
-    tiles[7]->addNeighbouringVertex(vertices[22].get());
-    tiles[7]->addNeighbouringVertex(vertices[27].get());
-    tiles[7]->addNeighbouringVertex(vertices[28].get());
-
-    tiles[8]->addNeighbouringVertex(vertices[18].get());
-    tiles[8]->addNeighbouringVertex(vertices[19].get());
-    tiles[8]->addNeighbouringVertex(vertices[24].get());
-    tiles[8]->addNeighbouringVertex(vertices[25].get());
-    tiles[8]->addNeighbouringVertex(vertices[30].get());
-    tiles[8]->addNeighbouringVertex(vertices[31].get());
-
-    tiles[9]->addNeighbouringVertex(vertices[20].get());
-    tiles[9]->addNeighbouringVertex(vertices[21].get());
-    tiles[9]->addNeighbouringVertex(vertices[26].get());
-    tiles[9]->addNeighbouringVertex(vertices[27].get());
-    tiles[9]->addNeighbouringVertex(vertices[32].get());
-    tiles[9]->addNeighbouringVertex(vertices[33].get());
-
-    tiles[10]->addNeighbouringVertex(vertices[22].get());
-    tiles[10]->addNeighbouringVertex(vertices[23].get());
-    tiles[10]->addNeighbouringVertex(vertices[28].get());
-    tiles[10]->addNeighbouringVertex(vertices[29].get());
-    tiles[10]->addNeighbouringVertex(vertices[34].get());
-    tiles[10]->addNeighbouringVertex(vertices[35].get());
-
-    tiles[11]->addNeighbouringVertex(vertices[25].get());
-    tiles[11]->addNeighbouringVertex(vertices[26].get());
-    tiles[11]->addNeighbouringVertex(vertices[31].get());
-    tiles[11]->addNeighbouringVertex(vertices[32].get());
-    tiles[11]->addNeighbouringVertex(vertices[37].get());
-    tiles[11]->addNeighbouringVertex(vertices[38].get());
-
-    tiles[12]->addNeighbouringVertex(vertices[27].get());
-    tiles[12]->addNeighbouringVertex(vertices[28].get());
-    tiles[12]->addNeighbouringVertex(vertices[33].get());
-    tiles[12]->addNeighbouringVertex(vertices[34].get());
-    tiles[12]->addNeighbouringVertex(vertices[39].get());
-    tiles[12]->addNeighbouringVertex(vertices[40].get());
-
-    tiles[13]->addNeighbouringVertex(vertices[30].get());
-    tiles[13]->addNeighbouringVertex(vertices[31].get());
-    tiles[13]->addNeighbouringVertex(vertices[36].get());
-    tiles[13]->addNeighbouringVertex(vertices[37].get());
-    tiles[13]->addNeighbouringVertex(vertices[42].get());
-    tiles[13]->addNeighbouringVertex(vertices[43].get());
-
-    tiles[14]->addNeighbouringVertex(vertices[32].get());
-    tiles[14]->addNeighbouringVertex(vertices[33].get());
-    tiles[14]->addNeighbouringVertex(vertices[38].get());
-    tiles[14]->addNeighbouringVertex(vertices[39].get());
-    tiles[14]->addNeighbouringVertex(vertices[44].get());
-    tiles[14]->addNeighbouringVertex(vertices[45].get());
-
-    tiles[15]->addNeighbouringVertex(vertices[34].get());
-    tiles[15]->addNeighbouringVertex(vertices[35].get());
-    tiles[15]->addNeighbouringVertex(vertices[40].get());
-    tiles[15]->addNeighbouringVertex(vertices[41].get());
-    tiles[15]->addNeighbouringVertex(vertices[46].get());
-    tiles[15]->addNeighbouringVertex(vertices[47].get());
-
-    tiles[16]->addNeighbouringVertex(vertices[37].get());
-    tiles[16]->addNeighbouringVertex(vertices[38].get());
-    tiles[16]->addNeighbouringVertex(vertices[43].get());
-    tiles[16]->addNeighbouringVertex(vertices[44].get());
-    tiles[16]->addNeighbouringVertex(vertices[48].get());
-    tiles[16]->addNeighbouringVertex(vertices[49].get());
-
-    tiles[17]->addNeighbouringVertex(vertices[39].get());
-    tiles[17]->addNeighbouringVertex(vertices[40].get());
-    tiles[17]->addNeighbouringVertex(vertices[45].get());
-    tiles[17]->addNeighbouringVertex(vertices[46].get());
-    tiles[17]->addNeighbouringVertex(vertices[50].get());
-    tiles[17]->addNeighbouringVertex(vertices[51].get());
-
-    tiles[18]->addNeighbouringVertex(vertices[44].get());
-    tiles[18]->addNeighbouringVertex(vertices[45].get());
-    tiles[18]->addNeighbouringVertex(vertices[49].get());
-    tiles[18]->addNeighbouringVertex(vertices[50].get());
-    tiles[18]->addNeighbouringVertex(vertices[52].get());
-    tiles[18]->addNeighbouringVertex(vertices[53].get());
+void Board::printBoard(std::ostream& out) const {
+    BoardRenderer{}.print(*this, out);
 }
@@ -1,69 +1,194 @@
 #ifndef BOARD_H
 #define BOARD_H
 
+#include "../common/action.h"
+#include "../common/bitboard.h"
+#include "../common/fixedvector.h"
 #include "../common/forward.h"
 #include "../common/resource.h"
-#include "../game/game.h"
+#include "../common/resourcebundle.h"
+#include "../common/zobrist.h"
+#include "../game/builder.h"
+#include "../structures/residence.h"
+#include "../structures/road.h"
+#include "edge.h"
+#include "tile.h"
+#include "topology.h"
+#include "vertex.h"
+#include <array>
 #include <iostream>
 #include <memory>
 #include <vector>
 
+// One resource payout owed to a builder whenever its tile's value is rolled
+struct Payout {
+    int builder;
+    Resource resource;
+    int amount;
+};
+
 // Stores information used to initialize Board Tiles
 struct TileInitData {
     int tileValue;
     Resource resource;
 };
 
+// Most actions that can ever be legal at once: a road on every edge, a basement or upgrade on every vertex,
+// every one-for-one trade with each of the three other builders, and ending the turn
+const int MAX_LEGAL_ACTIONS = Topology::NUM_EDGES + Topology::NUM_VERTICES + 3 * ResourceBundle::NUM_RESOURCES * (ResourceBundle::NUM_RESOURCES - 1) + 1;
+using LegalActions = FixedVector<Action, MAX_LEGAL_ACTIONS>;
+
 class Board final {
+  public:
+    static const int NUM_TILES = Topology::NUM_TILES;
+    static const int NUM_EDGES = Topology::NUM_EDGES;
+    static const int NUM_VERTICES = Topology::NUM_VERTICES;
+    static const int MAX_BUILDERS = 4;
+    static const int MAX_ROLL = 12;
+    static const int MAX_PAYOUTS = NUM_TILES * Topology::VERTICES_PER_TILE; // One per tile corner, at most
+
   private:
-    std::vector<std::unique_ptr<AbstractTile>> tiles;
-    std::vector<std::unique_ptr<Vertex>> vertices;
-    std::vector<std::unique_ptr<Edge>> edges;
+    // Fixed-size, so copying a board never allocates
+    std::array<Tile, NUM_TILES> tiles;
+    std::array<Vertex, NUM_VERTICES> vertices;
+    std::array<Edge, NUM_EDGES> edges;
 
-    int geeseTile; // Tile number that contains geese
+    int geeseTile; // Tile number that contains geese; moving them only flips two tiles' flags
 
-    void setupVertices();
-    void setupEdges();
-    void setupTiles();
+    // Neighbourhood masks, computed from the topology at compile time
+    static constexpr std::array<VertexMask, NUM_VERTICES> spacingMasks = Topology::makeSpacingMasks();
+    static constexpr std::array<VertexMask, NUM_EDGES> endpointMasks = Topology::makeEndpointMasks();
+    static constexpr std::array<TileMask, NUM_VERTICES> vertexTileMasks = Topology::makeVertexTileMasks();
 
-    std::string printVertex(int) const;
-    std::string printEdge(int, bool) const;
-    std::string printTile(int) const;
-    std::string printResource(int) const;
-    std::string printGeese(int) const;
+    // Occupancy, kept in sync with the Vertex/Edge structures on every build; indexed by builderNumber
+    std::array<VertexMask, MAX_BUILDERS> residenceMasks;
+    std::array<EdgeMask, MAX_BUILDERS> roadMasks;
+    std::array<VertexMask, MAX_BUILDERS> roadEndpointMasks; // Every vertex touched by one of the builder's roads
+    VertexMask occupiedVertices;
+    EdgeMask occupiedEdges;
+    std::array<char, MAX_BUILDERS> builderColours; // Structures only record their owner's number; this maps it back for printing
+    uint64_t hash; // Zobrist hash of the tiles, structures and geese, updated alongside them
+    std::array<ResourceBundle, NUM_VERTICES> vertexYields; // See getVertexYield; the geese tile is left out
+
+    /**
+     * Everything paid out for each roll value, in compressed sparse row form like the topology: the payouts for
+     * roll r are payouts[payoutOffsets[r]] up to (but excluding) payouts[payoutOffsets[r + 1]].
+     * Fixed-size, so copying a board or rewinding it to a snapshot never allocates.
+     */
+    FixedVector<Payout, MAX_PAYOUTS> payouts;
+    std::array<int, MAX_ROLL + 2> payoutOffsets;
+
+    void markRoad(const Builder&, int);
+    void markResidence(const Builder&, int);
+    void refreshPayouts(int);
+    void refreshPayoutsAround(int);
+    void addTileYield(int, int); // Adds the tile's yield times the given sign to each of its vertices
+    static uint64_t residenceKey(int, const Residence&);
 
     void setRoad(Builder&, int);
     void setResidence(Builder&, int, char);
 
-  public:
-    static const int NUM_TILES = 19;
-    static const int NUM_EDGES = 72;
-    static const int NUM_VERTICES = 54;
+    // Structures only change through Board's own mutators, which keep the masks, payouts and hash in step with them
+    Vertex* getMutableVertex(int);
+    Edge* getMutableEdge(int);
 
+  public:
     /**
      * TileInitData #0 is meant for Tile #0, TileInitData #1 is meant for Tile #1, etc.
      * There must be 19 elements in the TileInitData array, with exactly ONE park tile.
      *  (The park tile must have a tileValue of 7)
      */
-    Board(std::vector<TileInitData>);
-    Board(std::vector<TileInitData>, std::vector<std::pair<Builder*, BuilderStructureData>>);
+    Board(const std::vector<TileInitData>&);
+    Board(const std::vector<TileInitData>&, const std::vector<std::pair<Builder*, BuilderStructureData>>&);
+    Board(const Board&) = default; // Structures only refer to each other by number, so a plain copy shares nothing
+    Board& operator=(const Board&) = delete;
     ~Board();
 
-    AbstractTile* getTile(int) const;
-    Vertex* getVertex(int) const;
-    Edge* getEdge(int) const;
+    std::vector<TileInitData> getTileInitData() const;
+
+    // Restoring only accepts snapshots of a board with the same tiles
+    BoardSnapshot snapshot() const;
+    void restore(const BoardSnapshot&);
+
+    const Tile* getTile(int) const;
+    const Vertex* getVertex(int) const;
+    const Edge* getEdge(int) const;
+
+    // Legality checks against the occupancy masks; locations must be in range
+    bool canBuildRoad(const Builder&, int) const;
+    bool canBuildResidence(const Builder&, int) const;
+    bool canBuildInitialResidence(int) const;
+
+    // Appends every road, basement and upgrade the builder can both legally place and afford right now,
+    // without probing locations one by one
+    void generateLegalActions(const Builder&, LegalActions&) const;
+
+    // Builders other than the given one with a residence on the tile, in the order of its corners
+    std::vector<int> getStealCandidates(int, const Builder&) const;
+
+    VertexMask getResidenceMask(int) const;
+    EdgeMask getRoadMask(int) const;
+
+    // Headless variants report the outcome instead of printing it
+    ActionStatus buildRoad(Builder&, int);
+    ActionStatus buildResidence(Builder&, int);
+    ActionStatus buildInitialResidence(Builder&, int);
+    ActionStatus upgradeResidence(Builder&, int);
+
+    // Exact inverses of the headless builds, for undoing the builder's most recent build on that location;
+    // refunds are left to the caller
+    void unbuildRoad(Builder&, int);
+    void unbuildResidence(Builder&, int);
+    void downgradeResidence(Builder&, int);
 
     bool buildRoad(Builder&, int, std::ostream&);
     bool buildResidence(Builder&, int, std::ostream&);
     bool buildInitialResidence(Builder&, int, std::ostream&);
     bool upgradeResidence(Builder&, int, std::ostream&);
 
+    // Prints the console message for the outcome of a build action, returning true on success
+    static bool printBuildStatus(ActionType, ActionStatus, std::ostream&);
+
+    // What each builder is owed for a roll; crediting it to their inventories is left to the caller
     BuilderInventoryUpdate getResourcesFromDiceRoll(int) const;
 
+    // Identifies the layout: equal boards always hash equal, whatever order they were built in
+    uint64_t getHash() const;
+
     int getGeeseTile() const;
     void setGeeseTile(int);
 
+    // Number of the 36 outcomes of two dice that produce the tile value; 0 for 7, which never produces
+    static int rollWays(int);
+
+    /**
+     * What a basement on the vertex would collect on an average roll, per resource, in 36ths of a resource:
+     * the sum of rollWays over its tiles, leaving out the tile blocked by the geese. Kept up to date as the
+     * geese move, so scoring every vertex is a single pass over this table.
+     */
+    const ResourceBundle& getVertexYield(int) const;
+    const std::array<ResourceBundle, NUM_VERTICES>& getVertexYields() const;
+
+    char getBuilderColour(int) const; // Colour letter of a builder owning structures on this board
+
+    // Draws the board with a throwaway BoardRenderer; keep a renderer around to redraw without allocating
     void printBoard(std::ostream&) const;
 };
 
+// Everything about a Board that changes during play; trivially copyable, so saving and restoring one is a memcpy
+struct BoardSnapshot {
+    std::array<Residence, Board::NUM_VERTICES> residences{};
+    std::array<Road, Board::NUM_EDGES> roads{};
+    int geeseTile = -1;
+    std::array<VertexMask, Board::MAX_BUILDERS> residenceMasks{};
+    std::array<EdgeMask, Board::MAX_BUILDERS> roadMasks{};
+    std::array<VertexMask, Board::MAX_BUILDERS> roadEndpointMasks{};
+    VertexMask occupiedVertices = 0;
+    EdgeMask occupiedEdges{};
+    std::array<char, Board::MAX_BUILDERS> builderColours{};
+    uint64_t hash = 0;
+    FixedVector<Payout, Board::MAX_PAYOUTS> payouts;
+    std::array<int, Board::MAX_ROLL + 2> payoutOffsets{};
+};
+
 #endif
@@ -0,0 +1,333 @@
+#include "boardrenderer.h"
+#include "../structures/residence.h"
+#include "../structures/road.h"
+#include "board.h"
+#include "edge.h"
+#include "tile.h"
+#include "vertex.h"
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <vector>
+
+namespace {
+const int CELL_WIDTH = 2;      // Vertex and edge numbers, structures and tile values
+const int WIDE_CELL_WIDTH = 9; // Resource names and geese
+
+// The board with every cell blank, and where each cell starts in it
+struct Layout {
+    std::string frame;
+    std::array<int, Board::NUM_VERTICES> vertexCells{};
+    std::array<int, Board::NUM_EDGES> edgeCells{};
+    std::array<int, Board::NUM_TILES> valueCells{};
+    std::array<int, Board::NUM_TILES> resourceCells{};
+    std::array<int, Board::NUM_TILES> geeseCells{};
+    std::array<std::string, PARK + 1> resourceNames; // Padded to WIDE_CELL_WIDTH
+    std::vector<int> lineStarts;
+};
+
+Layout makeLayout() {
+    Layout layout;
+    layout.lineStarts.push_back(0);
+    std::string& frame = layout.frame;
+    auto text = [&](const char* s) { frame += s; };
+    auto line = [&]() {
+        frame += '\n';
+        layout.lineStarts.push_back(frame.size());
+    };
+    auto cell = [&](int& offset, int width) {
+        offset = frame.size();
+        frame.append(width, ' ');
+    };
+    auto vertex = [&](int i) {
+        frame += '|';
+        cell(layout.vertexCells[i], CELL_WIDTH);
+        frame += '|';
+    };
+    auto edge = [&](int i, bool isHorizontal) {
+        if (isHorizontal) {
+            frame += "--";
+        }
+        cell(layout.edgeCells[i], CELL_WIDTH);
+        if (isHorizontal) {
+            frame += "--";
+        }
+    };
+    auto tile = [&](int i) {
+        frame += "  ";
+        cell(layout.valueCells[i], CELL_WIDTH);
+        frame += "  ";
+    };
+    auto resource = [&](int i) { cell(layout.resourceCells[i], WIDE_CELL_WIDTH); };
+    auto geese = [&](int i) { cell(layout.geeseCells[i], WIDE_CELL_WIDTH); };
+
+    text("                          "); vertex(0); edge(0, true); vertex(1); line();
+    text("                            |         |"); line();
+    text("                           "); edge(1, false); text("    0   "); edge(2, false); line();
+    text("                            |"); resource(0); text("|"); line();
+    text("                "); vertex(2); edge(3, true); vertex(3); tile(0); vertex(4); edge(4, true); vertex(5); line();
+    text("                  |         |"); geese(0); text("|         |"); line();
+    text("                 "); edge(5, false); text("    1   "); edge(6, false); text("        "); edge(7, false); text("    2   "); edge(8, false); line();
+    text("                  |"); resource(1); text("|         |"); resource(2); text("|"); line();
+    text("      "); vertex(6); edge(9, true); vertex(7); tile(1); vertex(8); edge(10, true); vertex(9); tile(2); vertex(10); edge(11, true); vertex(11); line();
+    text("        |         |"); geese(1); text("|         |"); geese(2); text("|         |"); line();
+    text("       "); edge(12, false); text("    3   "); edge(13, false); text("        "); edge(14, false); text("    4   "); edge(15, false); text("        "); edge(16, false); text("    5   "); edge(17, false); line();
+    text("        |"); resource(3); text("|         |"); resource(4); text("|         |"); resource(5); text("|"); line();
+    text("      "); vertex(12); tile(3); vertex(13); edge(18, true); vertex(14); tile(4); vertex(15); edge(19, true); vertex(16); tile(5); vertex(17); line();
+    text("        |"); geese(3); text("|         |"); geese(4); text("|         |"); geese(5); text("|"); line();
+    text("       "); edge(20, false); text("        "); edge(21, false); text("    6   "); edge(22, false); text("        "); edge(23, false); text("    7   "); edge(24, false); text("        "); edge(25, false); line();
+    text("        |         |"); resource(6); text("|         |"); resource(7); text("|         |"); line();
+    text("      "); vertex(18); edge(26, true); vertex(19); tile(6); vertex(20); edge(27, true); vertex(21); tile(7); vertex(22); edge(28, true); vertex(23); line();
+    text("        |         |"); geese(6); text("|         |"); geese(7); text("|         |"); line();
+    text("       "); edge(29, false); text("    8   "); edge(30, false); text("        "); edge(31, false); text("    9   "); edge(32, false); text("        "); edge(33, false); text("   10   "); edge(34, false); line();
+    text("        |"); resource(8); text("|         |"); resource(9); text("|         |"); resource(10); text("|"); line();
+    text("      "); vertex(24); tile(8); vertex(25); edge(35, true); vertex(26); tile(9); vertex(27); edge(36, true); vertex(28); tile(10); vertex(29); line();
+    text("        |"); geese(8); text("|         |"); geese(9); text("|         |"); geese(10); text("|"); line();
+    text("       "); edge(37, false); text("        "); edge(38, false); text("   11   "); edge(39, false); text("        "); edge(40, false); text("   12   "); edge(41, false); text("        "); edge(42, false); line();
+    text("        |         |"); resource(11); text("|         |"); resource(12); text("|         |"); line();
+    text("      "); vertex(30); edge(43, true); vertex(31); tile(11); vertex(32); edge(44, true); vertex(33); tile(12); vertex(34); edge(45, true); vertex(35); line();
+    text("        |         |"); geese(11); text("|         |"); geese(12); text("|         |"); line();
+    text("       "); edge(46, false); text("   13   "); edge(47, false); text("        "); edge(48, false); text("   14   "); edge(49, false); text("        "); edge(50, false); text("   15   "); edge(51, false); line();
+    text("        |"); resource(13); text("|         |"); resource(14); text("|         |"); resource(15); text("|"); line();
+    text("      "); vertex(36); tile(13); vertex(37); edge(52, true); vertex(38); tile(14); vertex(39); edge(53, true); vertex(40); tile(15); vertex(41); line();
+    text("        |"); geese(13); text("|         |"); geese(14); text("|         |"); geese(15); text("|"); line();
+    text("       "); edge(54, false); text("        "); edge(55, false); text("   16   "); edge(56, false); text("        "); edge(57, false); text("   17   "); edge(58, false); text("        "); edge(59, false); line();
+    text("        |         |"); resource(16); text("|         |"); resource(17); text("|         |"); line();
+    text("      "); vertex(42); edge(60, true); vertex(43); tile(16); vertex(44); edge(61, true); vertex(45); tile(17); vertex(46); edge(62, true); vertex(47); line();
+    text("                  |"); geese(16); text("|         |"); geese(17); text("|"); line();
+    text("                 "); edge(63, false); text("        "); edge(64, false); text("   18   "); edge(65, false); text("        "); edge(66, false); line();
+    text("                  |         |"); resource(18); text("|         |"); line();
+    text("                "); vertex(48); edge(67, true); vertex(49); tile(18); vertex(50); edge(68, true); vertex(51); line();
+    text("                            |"); geese(18); text("|"); line();
+    text("                           "); edge(69, false); text("        "); edge(70, false); line();
+    text("                            |         |"); line();
+    text("                          "); vertex(52); edge(71, true); vertex(53); line();
+
+    for (int i = 0; i <= PARK; i++) {
+        Resource resource = static_cast<Resource>(i);
+        std::string& name = layout.resourceNames[i];
+        name = resource == ENERGY ? " " : "  ";
+        name += resourceToString(resource);
+        name += resource <= GLASS ? "  " : "   ";
+    }
+
+    layout.lineStarts.pop_back(); // The frame ends in a newline
+    return layout;
+}
+
+const Layout& getLayout() {
+    static const Layout layout = makeLayout();
+    return layout;
+}
+
+int cellOffset(BoardRenderer::CellType type, int index) {
+    const Layout& layout = getLayout();
+    switch (type) {
+        case BoardRenderer::CellType::VERTEX:
+            return layout.vertexCells[index];
+        case BoardRenderer::CellType::EDGE:
+            return layout.edgeCells[index];
+        case BoardRenderer::CellType::VALUE:
+            return layout.valueCells[index];
+        case BoardRenderer::CellType::RESOURCE:
+            return layout.resourceCells[index];
+        default:
+            return layout.geeseCells[index];
+    }
+}
+
+constexpr int cellWidth(BoardRenderer::CellType type) {
+    return type == BoardRenderer::CellType::RESOURCE || type == BoardRenderer::CellType::GEESE ? WIDE_CELL_WIDTH : CELL_WIDTH;
+}
+
+// Writes a number of at most two digits right-aligned into a cell
+void putNumber(char* cell, int number) {
+    cell[0] = number < 10 ? ' ' : static_cast<char>('0' + number / 10);
+    cell[1] = static_cast<char>('0' + number % 10);
+}
+
+template <BoardRenderer::CellType type>
+void drawCell(const Board& board, int index, char* cell) {
+    if constexpr (type == BoardRenderer::CellType::VERTEX) {
+        const Vertex* vertex = board.getVertex(index);
+        if (vertex->hasResidence()) {
+            cell[0] = board.getBuilderColour(vertex->getResidence().getOwner());
+            cell[1] = vertex->getResidence().getResidenceLetter();
+        }
+        else {
+            putNumber(cell, index);
+        }
+    }
+    else if constexpr (type == BoardRenderer::CellType::EDGE) {
+        const Edge* edge = board.getEdge(index);
+        if (edge->hasRoad()) {
+            cell[0] = board.getBuilderColour(edge->getRoad().getOwner());
+            cell[1] = 'R';
+        }
+        else {
+            putNumber(cell, index);
+        }
+    }
+    else if constexpr (type == BoardRenderer::CellType::VALUE) {
+        int value = board.getTile(index)->getTileValue();
+        if (value == 7) {
+            cell[0] = cell[1] = ' ';
+        }
+        else {
+            putNumber(cell, value);
+        }
+    }
+    else if constexpr (type == BoardRenderer::CellType::RESOURCE) {
+        const std::string& name = getLayout().resourceNames[board.getTile(index)->getResource()];
+        std::copy(name.begin(), name.end(), cell);
+    }
+    else {
+        const char* geese = board.getTile(index)->hasGeese() ? "  GEESE  " : "         ";
+        std::copy(geese, geese + WIDE_CELL_WIDTH, cell);
+    }
+}
+
+// Draws every cell of one type into the frame
+template <BoardRenderer::CellType type, typename Offsets>
+void drawCells(const Board& board, const Offsets& offsets, char* frame) {
+    for (size_t i = 0; i < offsets.size(); i++) {
+        drawCell<type>(board, i, frame + offsets[i]);
+    }
+}
+
+// As drawCells, but only writes the cells that differ, calling onChange with the index of each one
+template <BoardRenderer::CellType type, typename Offsets, typename OnChange>
+void updateCells(const Board& board, const Offsets& offsets, char* frame, OnChange onChange) {
+    for (size_t i = 0; i < offsets.size(); i++) {
+        char cell[cellWidth(type)];
+        drawCell<type>(board, i, cell);
+        char* drawnCell = frame + offsets[i];
+        if (!std::equal(cell, cell + cellWidth(type), drawnCell)) {
+            std::copy(cell, cell + cellWidth(type), drawnCell);
+            onChange(i);
+        }
+    }
+}
+
+// Tile whose geese cell is filled in, or -1 if there is none
+int drawnGeeseTile(const std::string& frame) {
+    for (int i = 0; i < Board::NUM_TILES; i++) {
+        if (frame[cellOffset(BoardRenderer::CellType::GEESE, i) + 2] == 'G') {
+            return i;
+        }
+    }
+    return -1;
+}
+
+std::string_view trim(std::string_view text) {
+    size_t first = text.find_first_not_of(' ');
+    return first == std::string_view::npos ? std::string_view{} : text.substr(first, text.find_last_not_of(' ') - first + 1);
+}
+
+const char* cellTypeName(BoardRenderer::CellType type) {
+    switch (type) {
+        case BoardRenderer::CellType::VERTEX:
+            return "vertex";
+        case BoardRenderer::CellType::EDGE:
+            return "edge";
+        case BoardRenderer::CellType::VALUE:
+            return "value";
+        case BoardRenderer::CellType::RESOURCE:
+            return "resource";
+        default:
+            return "geese";
+    }
+}
+}
+
+BoardRenderer::BoardRenderer() : buffer{getLayout().frame}, drawn{false} {}
+BoardRenderer::~BoardRenderer() {}
+
+void BoardRenderer::findChanges(const Board& board) {
+    const Layout& layout = getLayout();
+    char* frame = buffer.data();
+    auto changed = [this](CellType type) {
+        return [this, type](int i) { changes.emplace_back(Change{type, i}); };
+    };
+
+    changes.clear();
+    updateCells<CellType::VERTEX>(board, layout.vertexCells, frame, changed(CellType::VERTEX));
+    updateCells<CellType::EDGE>(board, layout.edgeCells, frame, changed(CellType::EDGE));
+    updateCells<CellType::VALUE>(board, layout.valueCells, frame, changed(CellType::VALUE));
+    updateCells<CellType::RESOURCE>(board, layout.resourceCells, frame, changed(CellType::RESOURCE));
+    updateCells<CellType::GEESE>(board, layout.geeseCells, frame, changed(CellType::GEESE));
+    drawn = true;
+}
+
+bool BoardRenderer::hasDrawn() const {
+    return drawn;
+}
+
+const std::string& BoardRenderer::render(const Board& board) {
+    // Patching every cell costs no more than comparing it first would, so nothing is compared
+    const Layout& layout = getLayout();
+    char* frame = buffer.data();
+    drawCells<CellType::VERTEX>(board, layout.vertexCells, frame);
+    drawCells<CellType::EDGE>(board, layout.edgeCells, frame);
+    drawCells<CellType::VALUE>(board, layout.valueCells, frame);
+    drawCells<CellType::RESOURCE>(board, layout.resourceCells, frame);
+    drawCells<CellType::GEESE>(board, layout.geeseCells, frame);
+    drawn = true;
+    return buffer;
+}
+
+void BoardRenderer::print(const Board& board, std::ostream& out) {
+    render(board);
+    out.write(buffer.data(), buffer.size());
+}
+
+void BoardRenderer::printPatch(const Board& board, std::ostream& out) {
+    const Layout& layout = getLayout();
+    if (!drawn) {
+        // Clear the screen and draw the whole frame from its top left corner
+        out << "\x1b[H\x1b[2J";
+        print(board, out);
+        return;
+    }
+
+    findChanges(board);
+    if (changes.empty()) {
+        return;
+    }
+    for (const Change& change : changes) {
+        int offset = cellOffset(change.type, change.index);
+        int line = std::upper_bound(layout.lineStarts.begin(), layout.lineStarts.end(), offset) - layout.lineStarts.begin();
+        out << "\x1b[" << line << ';' << offset - layout.lineStarts[line - 1] + 1 << 'H';
+        out.write(buffer.data() + offset, cellWidth(change.type));
+    }
+    // Leave the cursor on the line below the frame, where a full print would have left it
+    out << "\x1b[" << layout.lineStarts.size() + 1 << ";1H";
+}
+
+void BoardRenderer::printDelta(const Board& board, std::ostream& out) {
+    if (!drawn) {
+        print(board, out);
+        return;
+    }
+
+    int previousGeese = drawnGeeseTile(buffer);
+    findChanges(board);
+    bool geeseMoved = false;
+    for (const Change& change : changes) {
+        if (change.type == CellType::GEESE) {
+            geeseMoved = true;
+            continue;
+        }
+        out << cellTypeName(change.type) << ' ' << change.index << " -> ";
+        if (change.type == CellType::VALUE) {
+            out << board.getTile(change.index)->getTileValue();
+        }
+        else {
+            out << trim(std::string_view{buffer}.substr(cellOffset(change.type, change.index), cellWidth(change.type)));
+        }
+        out << '\n';
+    }
+    if (geeseMoved) {
+        out << "geese " << previousGeese << " -> " << board.getGeeseTile() << '\n';
+    }
+}
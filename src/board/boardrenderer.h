@@ -0,0 +1,54 @@
+#ifndef BOARDRENDERER_H
+#define BOARDRENDERER_H
+
+#include "../common/fixedvector.h"
+#include "../common/forward.h"
+#include "board.h"
+#include <ostream>
+#include <string>
+
+/**
+ * Draws a Board as ASCII art. The frame of the drawing never changes, so it is laid out once, recording
+ * the offset of every cell that depends on the game (vertices, edges, tile values, resources and geese).
+ * Each render copies nothing but those cells into the renderer's buffer, which is then written in one call;
+ * keep a renderer around to redraw the same or another board without allocating.
+ *
+ * The buffer always holds the last frame drawn, so a renderer can also send just the cells that changed
+ * since then, for viewers that already have the rest on screen. A renderer that has not drawn anything
+ * yet sends the full frame instead, which is what a new viewer needs.
+ */
+class BoardRenderer final {
+  public:
+    enum class CellType { VERTEX, EDGE, VALUE, RESOURCE, GEESE };
+    static const int NUM_CELLS = Board::NUM_VERTICES + Board::NUM_EDGES + 3 * Board::NUM_TILES;
+
+  private:
+    struct Change {
+        CellType type;
+        int index;
+    };
+
+    std::string buffer;
+    bool drawn;
+    FixedVector<Change, NUM_CELLS> changes; // Cells that differed from the last frame, reused between calls
+
+    void findChanges(const Board&); // Also brings the buffer up to date
+
+  public:
+    BoardRenderer();
+    ~BoardRenderer();
+
+    bool hasDrawn() const;
+
+    // Full frame
+    const std::string& render(const Board&);
+    void print(const Board&, std::ostream&);
+
+    // Only what changed since the last frame this renderer drew. The patch is ANSI escape codes for a
+    // terminal showing that frame from its top left corner; the delta is one line per cell, such as
+    // "vertex 22 -> RT", with the geese reported as a single "geese 3 -> 9"
+    void printPatch(const Board&, std::ostream&);
+    void printDelta(const Board&, std::ostream&);
+};
+
+#endif
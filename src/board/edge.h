@@ -2,32 +2,24 @@
 #define EDGE_H
 
 #include "../common/forward.h"
-#include "abstracttile.h"
-#include "vertex.h"
-#include <iostream>
-#include <memory>
-#include <vector>
+#include "../structures/road.h"
 
 class Edge final {
   private:
     const int edgeNumber;
-    std::shared_ptr<Road> road;
-    std::vector<Vertex*> neighbouringVertices;
+    Road road;
 
   public:
     Edge(int);
-    ~Edge();
+    ~Edge() = default;
 
     bool operator==(const Edge&) const;
 
-    void addNeighbouringVertex(Vertex*);
-
     int getEdgeNumber() const;
-    std::shared_ptr<Road> getRoad() const;
-    std::vector<Vertex*> getNeighbouringVertices() const;
+    const Road& getRoad() const;
+    bool hasRoad() const;
 
-    bool canBuildRoad(Builder&) const;
-    void buildRoad(std::shared_ptr<Road>);
+    void buildRoad(Road);
 };
 
 #endif
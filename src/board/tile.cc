@@ -1,18 +1,9 @@
 #include "tile.h"
-#include "../common/inventoryupdate.h"
-#include "../game/builder.h"
-#include "../structures/residence.h"
-#include "vertex.h"
-#include <algorithm>
 
-Tile::Tile(int tileNumber, int tileValue, Resource resource) : AbstractTile(), tileNumber{tileNumber}, tileValue{tileValue}, resource{resource} {}
+Tile::Tile(int tileNumber, int tileValue, Resource resource) : AbstractTile(), tileNumber{tileNumber}, tileValue{tileValue}, resource{resource}, geese{false} {}
 
 Tile::~Tile() {}
 
-void Tile::addNeighbouringVertex(Vertex* vertex) {
-    neighbouringVertices.emplace_back(vertex);
-}
-
 int Tile::getTileNumber() const {
     return tileNumber;
 }
@@ -25,40 +16,10 @@ Resource Tile::getResource() const {
     return resource;
 }
 
-BuilderInventoryUpdate Tile::giveResourcesToBuilders() const {
-    // Assume that tileNumber was rolled by Dice
-    BuilderInventoryUpdate update;
-
-    for (Vertex* vertex : neighbouringVertices) {
-        if (vertex->getResidence() != nullptr) {
-            vertex->getResidence()->getOwner().inventory[resource] += vertex->getResidence()->getResourceMultiplier();
-            update[vertex->getResidence()->getOwner().getBuilderNumber()][resource] += vertex->getResidence()->getResourceMultiplier();
-        }
-    }
-
-    return update;
-}
-
-std::vector<int> Tile::getStealCandidates(Builder& builder) const {
-    std::vector<int> builders;
-
-    for (Vertex* vertex : neighbouringVertices) {
-        if (vertex->getResidence() != nullptr && vertex->getResidence()->getOwner().getBuilderNumber() != builder.getBuilderNumber() && vertex->getResidence()->getOwner().getTotalResourceQuantity() > 0) {
-            if (std::find(builders.begin(), builders.end(), vertex->getResidence()->getOwner().getBuilderNumber()) == builders.end()){
-                builders.emplace_back(vertex->getResidence()->getOwner().getBuilderNumber());
-            } 
-        }
-    }
-
-    return builders;
-}
-
-std::unique_ptr<AbstractTile> Tile::removeGeese() {
-    // Should never be reached with good implementation
-    throw std::logic_error("Invalid operation! Cannot remove geese from a non-geese tile.");
+void Tile::setGeese(bool hasGeese) {
+    geese = hasGeese;
 }
 
 bool Tile::hasGeese() const {
-    // Will be overridden by GeeseTile decorator when needed
-    return false;
+    return geese;
 }
@@ -4,29 +4,23 @@
 #include "../common/forward.h"
 #include "../common/resource.h"
 #include "abstracttile.h"
-#include "vertex.h"
 
 class Tile final : public AbstractTile {
   private:
     const int tileNumber;
     const int tileValue;
     const Resource resource;
-    std::vector<Vertex*> neighbouringVertices;
+    bool geese;
 
   public:
     Tile(int, int, Resource);
     ~Tile();
 
-    void addNeighbouringVertex(Vertex*) override;
-
     int getTileNumber() const override;
     int getTileValue() const override;
     Resource getResource() const override;
 
-    std::vector<int> getStealCandidates(Builder&) const override;
-    BuilderInventoryUpdate giveResourcesToBuilders() const override;
-
-    std::unique_ptr<AbstractTile> removeGeese() override;
+    void setGeese(bool) override;
     bool hasGeese() const override;
 };
 
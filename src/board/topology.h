@@ -0,0 +1,313 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include "../common/bitboard.h"
+#include <array>
+
+/**
+ * Fixed tile/vertex/edge adjacency of the board, shared by every Board instance.
+ * Vertex -> edge adjacency is stored in compressed sparse row form: the edges touching vertex i are
+ *  vertexEdges[vertexEdgeOffsets[i]] up to (but excluding) vertexEdges[vertexEdgeOffsets[i + 1]].
+ * Every edge joins exactly 2 vertices and every tile touches exactly 6, so those rows have a fixed stride.
+ */
+struct Topology final {
+    static constexpr int NUM_TILES = 19;
+    static constexpr int NUM_EDGES = 72;
+    static constexpr int NUM_VERTICES = 54;
+    static constexpr int VERTICES_PER_EDGE = 2;
+    static constexpr int VERTICES_PER_TILE = 6;
+    static constexpr int NUM_VERTEX_EDGES = NUM_EDGES * VERTICES_PER_EDGE;
+
+    static constexpr std::array<int, NUM_VERTICES + 1> vertexEdgeOffsets = {{
+        0, 2, 4, 6, 9, 12, 14, 16, 19, 22, 25, 28, 30, 32, 35, 38, 41, 44, 46, 49, 52, 55, 58, 61, 64, 66,
+        69, 72, 75, 78, 80, 83, 86, 89, 92, 95, 98, 100, 103, 106, 109, 112, 114, 116, 119, 122, 125, 128,
+        130, 132, 135, 138, 140, 142, 144,
+    }};
+
+    static constexpr std::array<int, NUM_VERTEX_EDGES> vertexEdges = {{
+        0, 1,
+        0, 2,
+        3, 5,
+        1, 3, 6,
+        2, 4, 7,
+        4, 8,
+        9, 12,
+        5, 9, 13,
+        6, 10, 14,
+        7, 10, 15,
+        8, 11, 16,
+        11, 17,
+        12, 20,
+        13, 18, 21,
+        14, 18, 22,
+        15, 19, 23,
+        16, 19, 24,
+        17, 25,
+        20, 26, 29,
+        21, 26, 30,
+        22, 27, 31,
+        23, 27, 32,
+        24, 28, 33,
+        25, 28, 34,
+        29, 37,
+        30, 35, 38,
+        31, 35, 39,
+        32, 36, 40,
+        33, 36, 41,
+        34, 42,
+        37, 43, 46,
+        38, 43, 47,
+        39, 44, 48,
+        40, 44, 49,
+        41, 45, 50,
+        42, 45, 51,
+        46, 54,
+        47, 52, 55,
+        48, 52, 56,
+        49, 53, 57,
+        50, 53, 58,
+        51, 59,
+        54, 60,
+        55, 60, 63,
+        56, 61, 64,
+        57, 61, 65,
+        58, 62, 66,
+        59, 62,
+        63, 67,
+        64, 67, 69,
+        65, 68, 70,
+        66, 68,
+        69, 71,
+        70, 71,
+    }};
+
+    static constexpr std::array<int, NUM_EDGES * VERTICES_PER_EDGE> edgeVertices = {{
+        0, 1,
+        0, 3,
+        1, 4,
+        2, 3,
+        4, 5,
+        2, 7,
+        3, 8,
+        4, 9,
+        5, 10,
+        6, 7,
+        8, 9,
+        10, 11,
+        6, 12,
+        7, 13,
+        8, 14,
+        9, 15,
+        10, 16,
+        11, 17,
+        13, 14,
+        15, 16,
+        12, 18,
+        13, 19,
+        14, 20,
+        15, 21,
+        16, 22,
+        17, 23,
+        18, 19,
+        20, 21,
+        22, 23,
+        18, 24,
+        19, 25,
+        20, 26,
+        21, 27,
+        22, 28,
+        23, 29,
+        25, 26,
+        27, 28,
+        24, 30,
+        25, 31,
+        26, 32,
+        27, 33,
+        28, 34,
+        29, 35,
+        30, 31,
+        32, 33,
+        34, 35,
+        30, 36,
+        31, 37,
+        32, 38,
+        33, 39,
+        34, 40,
+        35, 41,
+        37, 38,
+        39, 40,
+        36, 42,
+        37, 43,
+        38, 44,
+        39, 45,
+        40, 46,
+        41, 47,
+        42, 43,
+        44, 45,
+        46, 47,
+        43, 48,
+        44, 49,
+        45, 50,
+        46, 51,
+        48, 49,
+        50, 51,
+        49, 52,
+        50, 53,
+        52, 53,
+    }};
+
+    static constexpr std::array<int, NUM_TILES * VERTICES_PER_TILE> tileVertices = {{
+        0, 1, 3, 4, 8, 9,
+        2, 3, 7, 8, 13, 14,
+        4, 5, 9, 10, 15, 16,
+        6, 7, 12, 13, 18, 19,
+        8, 9, 14, 15, 20, 21,
+        10, 11, 16, 17, 22, 23,
+        13, 14, 19, 20, 25, 26,
+        15, 16, 21, 22, 27, 28,
+        18, 19, 24, 25, 30, 31,
+        20, 21, 26, 27, 32, 33,
+        22, 23, 28, 29, 34, 35,
+        25, 26, 31, 32, 37, 38,
+        27, 28, 33, 34, 39, 40,
+        30, 31, 36, 37, 42, 43,
+        32, 33, 38, 39, 44, 45,
+        34, 35, 40, 41, 46, 47,
+        37, 38, 43, 44, 48, 49,
+        39, 40, 45, 46, 50, 51,
+        44, 45, 49, 50, 52, 53,
+    }};
+
+    // Compile-time sanity checks of the tables above
+
+    static constexpr bool offsetsAreValid() {
+        if (vertexEdgeOffsets[0] != 0 || vertexEdgeOffsets[NUM_VERTICES] != NUM_VERTEX_EDGES) {
+            return false;
+        }
+        for (int i = 0; i < NUM_VERTICES; i++) {
+            // Every vertex touches 2 (on the coast) or 3 edges
+            int degree = vertexEdgeOffsets[i + 1] - vertexEdgeOffsets[i];
+            if (degree < 2 || degree > 3) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static constexpr bool edgeListsVertex(int edge, int vertex) {
+        return edgeVertices[edge * VERTICES_PER_EDGE] == vertex || edgeVertices[edge * VERTICES_PER_EDGE + 1] == vertex;
+    }
+
+    static constexpr bool vertexListsEdge(int vertex, int edge) {
+        for (int i = vertexEdgeOffsets[vertex]; i < vertexEdgeOffsets[vertex + 1]; i++) {
+            if (vertexEdges[i] == edge) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static constexpr bool adjacencyIsSymmetric() {
+        for (int i = 0; i < NUM_VERTICES; i++) {
+            for (int j = vertexEdgeOffsets[i]; j < vertexEdgeOffsets[i + 1]; j++) {
+                if (vertexEdges[j] < 0 || vertexEdges[j] >= NUM_EDGES || !edgeListsVertex(vertexEdges[j], i)) {
+                    return false;
+                }
+            }
+        }
+        for (int i = 0; i < NUM_EDGES; i++) {
+            for (int j = 0; j < VERTICES_PER_EDGE; j++) {
+                int vertex = edgeVertices[i * VERTICES_PER_EDGE + j];
+                if (vertex < 0 || vertex >= NUM_VERTICES || !vertexListsEdge(vertex, i)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static constexpr bool tilesAreValid() {
+        // Every vertex touches 1 to 3 tiles, and no tile lists the same vertex twice
+        int tileCounts[NUM_VERTICES] = {};
+        for (int i = 0; i < NUM_TILES; i++) {
+            for (int j = 0; j < VERTICES_PER_TILE; j++) {
+                int vertex = tileVertices[i * VERTICES_PER_TILE + j];
+                if (vertex < 0 || vertex >= NUM_VERTICES) {
+                    return false;
+                }
+                for (int k = 0; k < j; k++) {
+                    if (tileVertices[i * VERTICES_PER_TILE + k] == vertex) {
+                        return false;
+                    }
+                }
+                tileCounts[vertex]++;
+            }
+        }
+        for (int i = 0; i < NUM_VERTICES; i++) {
+            if (tileCounts[i] < 1 || tileCounts[i] > 3) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Derived bitboard tables
+
+    // The two vertices joined by each edge
+    static constexpr std::array<VertexMask, NUM_EDGES> makeEndpointMasks() {
+        std::array<VertexMask, NUM_EDGES> masks{};
+        for (int i = 0; i < NUM_EDGES; i++) {
+            masks[i] = vertexBit(edgeVertices[i * VERTICES_PER_EDGE]) | vertexBit(edgeVertices[i * VERTICES_PER_EDGE + 1]);
+        }
+        return masks;
+    }
+
+    // Each vertex plus every vertex one edge away from it
+    static constexpr std::array<VertexMask, NUM_VERTICES> makeSpacingMasks() {
+        std::array<VertexMask, NUM_VERTICES> masks{};
+        for (int i = 0; i < NUM_VERTICES; i++) {
+            masks[i] = vertexBit(i);
+            for (int j = vertexEdgeOffsets[i]; j < vertexEdgeOffsets[i + 1]; j++) {
+                int edge = vertexEdges[j];
+                masks[i] |= vertexBit(edgeVertices[edge * VERTICES_PER_EDGE]) | vertexBit(edgeVertices[edge * VERTICES_PER_EDGE + 1]);
+            }
+        }
+        return masks;
+    }
+
+    // Every tile touching each vertex
+    static constexpr std::array<TileMask, NUM_VERTICES> makeVertexTileMasks() {
+        std::array<TileMask, NUM_VERTICES> masks{};
+        for (int i = 0; i < NUM_TILES; i++) {
+            for (int j = 0; j < VERTICES_PER_TILE; j++) {
+                masks[tileVertices[i * VERTICES_PER_TILE + j]] |= tileBit(i);
+            }
+        }
+        return masks;
+    }
+
+    // Every tile sharing a side (two vertices) with each tile
+    static constexpr std::array<TileMask, NUM_TILES> makeTileNeighbourMasks() {
+        std::array<TileMask, NUM_TILES> masks{};
+        for (int i = 0; i < NUM_TILES; i++) {
+            for (int j = 0; j < NUM_TILES; j++) {
+                int shared = 0;
+                for (int k = 0; k < VERTICES_PER_TILE; k++) {
+                    for (int l = 0; l < VERTICES_PER_TILE; l++) {
+                        shared += tileVertices[i * VERTICES_PER_TILE + k] == tileVertices[j * VERTICES_PER_TILE + l];
+                    }
+                }
+                if (i != j && shared == 2) {
+                    masks[i] |= tileBit(j);
+                }
+            }
+        }
+        return masks;
+    }
+};
+
+static_assert(Topology::offsetsAreValid(), "vertex -> edge offsets must cover every incidence, 2 or 3 per vertex");
+static_assert(Topology::adjacencyIsSymmetric(), "vertex -> edge and edge -> vertex adjacency must agree");
+static_assert(Topology::tilesAreValid(), "every tile must touch 6 distinct vertices and every vertex 1 to 3 tiles");
+
+#endif
@@ -2,35 +2,27 @@
 #define VERTEX_H
 
 #include "../common/forward.h"
-#include "abstracttile.h"
-#include "edge.h"
-#include <memory>
-#include <vector>
+#include "../structures/residence.h"
 
 class Vertex final {
   private:
     int vertexNumber;
-    std::shared_ptr<Residence> residence;
-    std::vector<Edge*> neighbouringEdges;
+    Residence residence;
 
   public:
     Vertex(int);
-    ~Vertex();
+    ~Vertex() = default; // Trivial, so a board's vertices copy and free as plain memory
 
     bool operator==(const Vertex&) const;
 
-    void addNeighbouringEdge(Edge*);
-
     int getVertexNumber() const;
-    std::shared_ptr<Residence> getResidence() const;
-    std::vector<Edge*> getNeighbouringEdges() const;
+    const Residence& getResidence() const;
+    bool hasResidence() const;
 
-    bool canBuildResidence(Builder&) const;
-    bool canBuildInitialResidence() const;
-    bool canUpgradeResidence(Builder&) const;
+    bool canUpgradeResidence(const Builder&) const;
 
-    void buildResidence(std::shared_ptr<Residence>);
-    void upgradeResidence(std::shared_ptr<Residence>);
+    void buildResidence(Residence);
+    void upgradeResidence(); // In place, one level up
 };
 
 #endif
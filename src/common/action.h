@@ -0,0 +1,80 @@
+#ifndef ACTION_H
+#define ACTION_H
+
+#include "resource.h"
+#include "trade.h"
+#include <vector>
+
+// Phases of the turn state machine; each phase only accepts the actions listed beside it
+enum class TurnPhase {
+    INITIAL_PLACEMENT, // BUILD_INITIAL_RESIDENCE, following the snake draft
+    PRE_ROLL,          // LOAD_DICE, FAIR_DICE, ROLL
+    POST_ROLL,         // BUILD_ROAD, BUILD_RESIDENCE, IMPROVE, TRADE, END_TURN
+    GEESE_DISCARD,     // None; a 7 was rolled and the engine is discarding on every builder's behalf
+    GEESE_PLACEMENT,   // MOVE_GEESE
+    STEAL,             // STEAL, from one of the candidates reported by MOVE_GEESE
+    GAME_OVER          // None
+};
+
+enum class ActionType {
+    LOAD_DICE,
+    FAIR_DICE,
+    ROLL,
+    BUILD_INITIAL_RESIDENCE,
+    BUILD_ROAD,
+    BUILD_RESIDENCE,
+    IMPROVE,
+    TRADE,
+    MOVE_GEESE,
+    STEAL,
+    END_TURN
+};
+
+// A single typed request made by the current builder
+struct Action {
+    ActionType type;
+    int target = -1; // Roll value, tile/edge/vertex number, or builder number, depending on type
+    Trade trade;     // Only read for ActionType::TRADE; proposeeColour is ignored in favour of target
+};
+
+enum class ActionStatus {
+    SUCCESS,
+    INVALID_PHASE,                 // Action is not accepted in the current TurnPhase
+    INVALID_LOCATION,              // Location does not exist on the board (or geese are already there)
+    CANNOT_BUILD,                  // Location exists, but the rules forbid building there
+    INSUFFICIENT_RESOURCES,        // Acting builder cannot afford the action
+    TARGET_INSUFFICIENT_RESOURCES, // Trade proposee cannot afford the trade
+    INVALID_ROLL,                  // Loaded dice roll outside of 2 to 12
+    INVALID_TARGET,                // Builder number is not a valid choice for this action
+    INVALID_AMOUNT                 // Trade gives or takes fewer than one resource
+};
+
+enum class EventType {
+    DICE_ROLLED,         // builder rolled amount
+    RESOURCES_GAINED,    // builder gained amount of resource
+    RESOURCES_DISCARDED, // builder lost amount of resource to the geese
+    GEESE_MOVED,         // geese moved to tile target
+    STEAL_CANDIDATE,     // builder may be stolen from
+    RESOURCE_STOLEN,     // builder stole amount of resource from builder target
+    ROAD_BUILT,          // builder built a road on edge target
+    RESIDENCE_BUILT,     // builder built a basement on vertex target
+    RESIDENCE_IMPROVED,  // builder upgraded the residence on vertex target
+    TRADE_COMPLETED,     // builder traded with builder target
+    TURN_BEGAN,          // it is now builder's turn
+    GAME_WON             // builder reached 10 building points
+};
+
+struct GameEvent {
+    EventType type;
+    int builder;
+    int target;
+    Resource resource;
+    int amount;
+};
+
+struct ActionResult {
+    ActionStatus status;
+    std::vector<GameEvent> events; // Everything that happened as a consequence of the action, in order
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <cstdint>
+
+// One bit per vertex; bit i is set if vertex i is in the set (54 vertices fit in a single word)
+using VertexMask = uint64_t;
+
+constexpr VertexMask vertexBit(int vertexNumber) {
+    return VertexMask{1} << vertexNumber;
+}
+
+// One bit per tile, like VertexMask
+using TileMask = uint32_t;
+
+constexpr TileMask tileBit(int tileNumber) {
+    return TileMask{1} << tileNumber;
+}
+
+// Index of the lowest set bit; bits must be non-zero. Loop with bits &= bits - 1 to visit every set bit
+inline int lowestBit(uint64_t bits) {
+    return __builtin_ctzll(bits);
+}
+
+// One bit per edge; edges 0 to 63 live in lo and edges 64 to 127 live in hi (72 edges need two words)
+struct EdgeMask {
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+
+    static constexpr EdgeMask bit(int edgeNumber) {
+        return edgeNumber < 64 ? EdgeMask{uint64_t{1} << edgeNumber, 0} : EdgeMask{0, uint64_t{1} << (edgeNumber - 64)};
+    }
+
+    constexpr bool test(int edgeNumber) const {
+        return edgeNumber < 64 ? (lo >> edgeNumber) & 1 : (hi >> (edgeNumber - 64)) & 1;
+    }
+
+    constexpr bool any() const {
+        return (lo | hi) != 0;
+    }
+
+    constexpr EdgeMask operator&(const EdgeMask& rhs) const {
+        return EdgeMask{lo & rhs.lo, hi & rhs.hi};
+    }
+
+    constexpr EdgeMask operator~() const {
+        return EdgeMask{~lo, ~hi};
+    }
+
+    constexpr EdgeMask operator|(const EdgeMask& rhs) const {
+        return EdgeMask{lo | rhs.lo, hi | rhs.hi};
+    }
+
+    EdgeMask& operator|=(const EdgeMask& rhs) {
+        lo |= rhs.lo;
+        hi |= rhs.hi;
+        return *this;
+    }
+
+    EdgeMask& operator&=(const EdgeMask& rhs) {
+        lo &= rhs.lo;
+        hi &= rhs.hi;
+        return *this;
+    }
+
+    constexpr bool operator==(const EdgeMask& rhs) const {
+        return lo == rhs.lo && hi == rhs.hi;
+    }
+};
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef FIXEDVECTOR_H
+#define FIXEDVECTOR_H
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+
+// Vector with inline storage for at most N elements; never allocates
+template <typename T, std::size_t N>
+class FixedVector final {
+  private:
+    std::array<T, N> elements{};
+    std::size_t count = 0;
+
+  public:
+    void emplace_back(const T& element) {
+        if (count == N) {
+            throw std::length_error("FixedVector capacity exceeded");
+        }
+        elements[count++] = element;
+    }
+
+    void pop_back() {
+        if (count == 0) {
+            throw std::out_of_range("FixedVector is empty");
+        }
+        count--;
+    }
+
+    T& at(std::size_t i) {
+        if (i >= count) {
+            throw std::out_of_range("FixedVector index out of range");
+        }
+        return elements[i];
+    }
+
+    const T& at(std::size_t i) const {
+        if (i >= count) {
+            throw std::out_of_range("FixedVector index out of range");
+        }
+        return elements[i];
+    }
+
+    T& operator[](std::size_t i) { return elements[i]; }
+    const T& operator[](std::size_t i) const { return elements[i]; }
+
+    // Growing exposes whatever the new slots last held; callers overwrite them
+    void resize(std::size_t size) {
+        if (size > N) {
+            throw std::length_error("FixedVector capacity exceeded");
+        }
+        count = size;
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    void clear() { count = 0; }
+
+    T* begin() { return elements.data(); }
+    T* end() { return elements.data() + count; }
+    const T* begin() const { return elements.data(); }
+    const T* end() const { return elements.data() + count; }
+
+    bool operator==(const FixedVector& other) const {
+        if (count != other.count) {
+            return false;
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            if (!(elements[i] == other.elements[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+#endif
@@ -3,29 +3,46 @@
 
 // To break circular dependencies, all of our structs and classes are forward-declared here
 
+struct Action;
+struct ActionResult;
+struct BoardConstraints;
+struct BoardSnapshot;
 struct BuilderInventoryUpdate;
 struct BuilderResourceData;
+struct BuilderSnapshot;
 struct BuilderStructureData;
+struct EngineSnapshot;
+struct GameEvent;
+struct GeneratedBoards;
+struct PlacementPlan;
+struct SaveData;
+struct SavedBuilder;
 struct TileInitData;
 struct Trade;
 
 class AbstractTile;
-class Basement;
 class Board;
+class BoardGenerator;
+class BoardRenderer;
 class Builder;
+class CaptureSink;
+class CommandReader;
+class ConsoleSink;
 class Dice;
 class Edge;
+class Engine;
 class FairDice;
 class Game;
 class GameFactory;
-class GeeseTile;
-class House;
 class LoadedDice;
+class NullSink;
+class OutputSink;
+class PlacementSolver;
 class RandomEngine;
 class Residence;
 class Road;
+class SaveFile;
 class Tile;
-class Tower;
 class Vertex;
 
 #endif
@@ -1,11 +1,69 @@
 #include "randomengine.h"
+#include <stdexcept>
 
-std::default_random_engine RandomEngine::engine;
+static uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// Advances a SplitMix64 state and returns its next output, used to expand seeds into xoshiro state
+uint64_t RandomEngine::splitMix(uint64_t& x) {
+    uint64_t z = (x += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+RandomEngine::RandomEngine(uint64_t seed, uint64_t stream) {
+    // Hash the stream number into the seed so that neighbouring streams start from unrelated states
+    uint64_t streamMix = stream;
+    uint64_t x = seed ^ splitMix(streamMix);
+    for (uint64_t& word : state) {
+        word = splitMix(x);
+    }
+}
+
+RandomEngine::result_type RandomEngine::operator()() {
+    uint64_t result = rotl(state[1] * 5, 7) * 9;
+    uint64_t t = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+
+    return result;
+}
+
+int RandomEngine::nextInt(int bound) {
+    if (bound <= 0) {
+        throw std::invalid_argument("RandomEngine bound must be positive");
+    }
+
+    // Lemire's multiply-and-reject: the high half of a 32x32-bit product, rejecting the biased low range
+    uint32_t range = bound;
+    uint64_t product = ((*this)() >> 32) * range;
+    uint32_t low = static_cast<uint32_t>(product);
+    if (low < range) {
+        uint32_t threshold = -range % range;
+        while (low < threshold) {
+            product = ((*this)() >> 32) * range;
+            low = static_cast<uint32_t>(product);
+        }
+    }
+    return product >> 32;
+}
 
-void RandomEngine::setSeed(unsigned int seed) {
-    engine.seed(seed);
+bool RandomEngine::operator==(const RandomEngine& other) const {
+    for (int i = 0; i < 4; i++) {
+        if (state[i] != other.state[i]) {
+            return false;
+        }
+    }
+    return true;
 }
 
-std::default_random_engine& RandomEngine::getEngine() {
-    return engine;
+bool RandomEngine::operator!=(const RandomEngine& other) const {
+    return !(*this == other);
 }
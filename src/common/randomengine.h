@@ -1,16 +1,50 @@
 #ifndef RANDOMENGINE_H
 #define RANDOMENGINE_H
 
-#include <random>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <utility>
 
+/**
+ * xoshiro256** generator owned by a single game, so games never share random state and may run in parallel.
+ * Each (seed, stream) pair gives an independent sequence, e.g. one stream per game from one master seed.
+ * Bounded integers and shuffles are implemented here rather than through <random>, whose distributions
+ * are implementation-defined, so that a seed replays the same game on every platform.
+ */
 class RandomEngine final {
   private:
-    static std::default_random_engine engine;
+    uint64_t state[4];
+
+    static uint64_t splitMix(uint64_t&);
 
   public:
-    static void setSeed(unsigned int seed);
+    using result_type = uint64_t;
+
+    explicit RandomEngine(uint64_t seed, uint64_t stream = 0);
+
+    static constexpr result_type min() {
+        return 0;
+    }
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()();
+
+    // Uniformly distributed integer in [0, bound); bound must be positive
+    int nextInt(int bound);
+
+    // Fisher-Yates shuffle of [first, last)
+    template <typename RandomIt>
+    void shuffle(RandomIt first, RandomIt last) {
+        for (auto i = std::distance(first, last) - 1; i > 0; i--) {
+            std::swap(first[i], first[nextInt(i + 1)]);
+        }
+    }
 
-    static std::default_random_engine& getEngine();
+    bool operator==(const RandomEngine&) const;
+    bool operator!=(const RandomEngine&) const;
 };
 
 #endif
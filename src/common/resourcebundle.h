@@ -0,0 +1,97 @@
+#ifndef RESOURCEBUNDLE_H
+#define RESOURCEBUNDLE_H
+
+#include "resource.h"
+#include <array>
+#include <stdexcept>
+
+// A count of each of the five tradeable resources, indexed by Resource (PARK is never counted)
+struct ResourceBundle {
+    static const int NUM_RESOURCES = PARK;
+
+    std::array<int, NUM_RESOURCES> counts{};
+
+    constexpr ResourceBundle() = default;
+    constexpr ResourceBundle(int brick, int energy, int glass, int heat, int wifi) : counts{{brick, energy, glass, heat, wifi}} {}
+
+    constexpr int& operator[](Resource resource) { return counts[resource]; }
+    constexpr const int& operator[](Resource resource) const { return counts[resource]; }
+
+    // Bounds-checked access; throws for PARK
+    int& at(Resource resource) {
+        if (resource < 0 || resource >= NUM_RESOURCES) {
+            throw std::out_of_range("ResourceBundle has no entry for " + resourceToString(resource));
+        }
+        return counts[resource];
+    }
+
+    const int& at(Resource resource) const {
+        return const_cast<ResourceBundle*>(this)->at(resource);
+    }
+
+    constexpr int total() const {
+        int sum = 0;
+        for (int i = 0; i < NUM_RESOURCES; i++) {
+            sum += counts[i];
+        }
+        return sum;
+    }
+
+    // True if every count is at least the corresponding count in cost
+    constexpr bool canAfford(const ResourceBundle& cost) const {
+        bool affordable = true;
+        for (int i = 0; i < NUM_RESOURCES; i++) {
+            affordable &= counts[i] >= cost.counts[i];
+        }
+        return affordable;
+    }
+
+    constexpr bool empty() const {
+        return total() == 0;
+    }
+
+    constexpr ResourceBundle& operator+=(const ResourceBundle& rhs) {
+        for (int i = 0; i < NUM_RESOURCES; i++) {
+            counts[i] += rhs.counts[i];
+        }
+        return *this;
+    }
+
+    constexpr ResourceBundle& operator-=(const ResourceBundle& rhs) {
+        for (int i = 0; i < NUM_RESOURCES; i++) {
+            counts[i] -= rhs.counts[i];
+        }
+        return *this;
+    }
+
+    constexpr ResourceBundle operator+(const ResourceBundle& rhs) const {
+        ResourceBundle sum = *this;
+        return sum += rhs;
+    }
+
+    constexpr ResourceBundle operator-(const ResourceBundle& rhs) const {
+        ResourceBundle difference = *this;
+        return difference -= rhs;
+    }
+
+    constexpr bool operator==(const ResourceBundle& rhs) const {
+        for (int i = 0; i < NUM_RESOURCES; i++) {
+            if (counts[i] != rhs.counts[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr bool operator!=(const ResourceBundle& rhs) const {
+        return !(*this == rhs);
+    }
+};
+
+// Building costs, in BRICK, ENERGY, GLASS, HEAT, WIFI order
+inline constexpr ResourceBundle ROAD_COST{0, 0, 0, 1, 1};
+inline constexpr ResourceBundle BASEMENT_COST{1, 1, 1, 0, 1};
+inline constexpr ResourceBundle HOUSE_COST{0, 0, 2, 3, 0};
+inline constexpr ResourceBundle TOWER_COST{3, 2, 2, 2, 1};
+
+#endif
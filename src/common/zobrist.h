@@ -0,0 +1,38 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstdint>
+
+/**
+ * Keys for Zobrist hashing: every feature of a game state (a road, a residence, the geese, ...) owns a fixed
+ * pseudo-random 64-bit key, and a state hashes to the XOR of its features' keys, so adding or removing one
+ * feature updates the hash in O(1). Keys are derived from the feature itself rather than drawn from a seeded
+ * table, so hashes are the same in every run and on every platform and can be stored alongside saved games.
+ */
+struct Zobrist final {
+    enum class Feature : uint64_t {
+        TILE,            // tile number, resource, tile value
+        ROAD,            // edge number, builder number
+        RESIDENCE,       // vertex number, builder number, level
+        GEESE,           // tile number
+        CURRENT_BUILDER, // builder number
+        INVENTORY        // builder number, resource, bucketed count
+    };
+
+    // Counts of this many or more resources of one kind hash alike
+    static constexpr int INVENTORY_BUCKETS = 20;
+
+    // SplitMix64 finaliser over the packed feature; a, b and c must each fit in 16 bits
+    static constexpr uint64_t key(Feature feature, uint64_t a, uint64_t b = 0, uint64_t c = 0) {
+        uint64_t z = ((static_cast<uint64_t>(feature) << 48) | (a << 32) | (b << 16) | c) + 0x9e3779b97f4a7c15;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    static constexpr uint64_t inventoryKey(int builderNumber, int resource, int count) {
+        return key(Feature::INVENTORY, builderNumber, resource, count < INVENTORY_BUCKETS ? count : INVENTORY_BUCKETS - 1);
+    }
+};
+
+#endif
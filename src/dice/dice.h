@@ -8,7 +8,8 @@ class Dice {
     Dice();
     virtual ~Dice();
 
-    virtual int rollDice(int) = 0;
+    // Loaded dice return the requested roll; fair dice draw from the game's RandomEngine
+    virtual int rollDice(int, RandomEngine&) = 0;
 };
 
 #endif
@@ -1,12 +1,12 @@
 #include "fairdice.h"
 #include "../common/randomengine.h"
 
-FairDice::FairDice() : Dice(), distribution(1, 6) {}
+FairDice::FairDice() : Dice() {}
 FairDice::~FairDice() {}
 
-int FairDice::rollDice(int roll) {
-    int rollOne = distribution(RandomEngine::getEngine());
-    int rollTwo = distribution(RandomEngine::getEngine());
+int FairDice::rollDice(int roll, RandomEngine& rng) {
+    int rollOne = rng.nextInt(6) + 1;
+    int rollTwo = rng.nextInt(6) + 1;
 
     return rollOne + rollTwo;
 }
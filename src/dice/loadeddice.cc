@@ -3,6 +3,6 @@
 LoadedDice::LoadedDice() : Dice() {}
 LoadedDice::~LoadedDice() {}
 
-int LoadedDice::rollDice(int roll) {
+int LoadedDice::rollDice(int roll, RandomEngine&) {
     return roll;
 }
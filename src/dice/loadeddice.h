@@ -9,7 +9,7 @@ class LoadedDice final : public Dice {
     LoadedDice();
     ~LoadedDice();
 
-    int rollDice(int) override;
+    int rollDice(int, RandomEngine&) override;
 };
 
 #endif
@@ -0,0 +1,239 @@
+#include "boardgenerator.h"
+#include "../board/board.h"
+#include "../common/randomengine.h"
+#include "../common/resourcebundle.h"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+const int NUM_TILES = Topology::NUM_TILES;
+const int NUM_VALUED_TILES = NUM_TILES - 1; // Every tile but the park
+const int MAX_ROLL_WAYS = 5;                // Of a 6 or an 8
+
+// The same tiles as Game::generateRandomBoard
+const std::array<int, NUM_VALUED_TILES> deckValues = {{2, 3, 3, 4, 4, 5, 5, 6, 6, 8, 8, 9, 9, 10, 10, 11, 11, 12}};
+const std::array<Resource, NUM_TILES> deckResources = {{WIFI, WIFI, WIFI, HEAT, HEAT, HEAT, BRICK, BRICK, BRICK, BRICK, ENERGY, ENERGY, ENERGY, ENERGY, GLASS, GLASS, GLASS, GLASS, PARK}};
+const ResourceBundle deckTileCounts{4, 4, 4, 3, 3};
+
+int totalRollWays() {
+    int total = 0;
+    for (int value : deckValues) {
+        total += Board::rollWays(value);
+    }
+    return total;
+}
+const int TOTAL_ROLL_WAYS = totalRollWays();
+
+bool isHot(int value) {
+    return value == 6 || value == 8;
+}
+
+// Distance of a resource's rollWays from its share of the whole board's, scaled up by NUM_VALUED_TILES to stay exact
+int pipDeviation(int rollWays, Resource resource) {
+    return rollWays * NUM_VALUED_TILES - TOTAL_ROLL_WAYS * deckTileCounts[resource];
+}
+
+// Union-find over tiles, for growing same-resource clusters one tile at a time
+struct Clusters {
+    std::array<int, NUM_TILES> parent;
+    std::array<int, NUM_TILES> size;
+
+    int find(int tile) {
+        while (parent[tile] != tile) {
+            tile = parent[tile] = parent[parent[tile]];
+        }
+        return tile;
+    }
+
+    // Adds tile to the cluster of every tile in neighbours, returning the size of the result
+    int add(int tile, TileMask neighbours) {
+        parent[tile] = tile;
+        size[tile] = 1;
+        for (TileMask bits = neighbours; bits != 0; bits &= bits - 1) {
+            int root = find(lowestBit(bits));
+            if (root != tile) {
+                parent[root] = tile;
+                size[tile] += size[root];
+            }
+        }
+        return size[tile];
+    }
+};
+}
+
+BoardGenerator::BoardGenerator(BoardConstraints constraints) : constraints{constraints} {
+    if (constraints.maxClusterSize < 0 || constraints.maxPipDeviation < -1) {
+        throw std::invalid_argument("Board constraints must not be negative");
+    }
+}
+
+BoardGenerator::~BoardGenerator() {}
+
+bool BoardGenerator::tryGenerate(RandomEngine& rng, std::vector<TileInitData>& data) const {
+    std::array<Resource, NUM_TILES> resources = deckResources;
+    std::array<int, NUM_VALUED_TILES> values = deckValues;
+    int valuesDrawn = 0;
+
+    TileMask hotTiles = 0;
+    std::array<TileMask, ResourceBundle::NUM_RESOURCES> resourceTiles{};
+    Clusters clusters;
+    ResourceBundle rollWays;
+    ResourceBundle tilesLeft = deckTileCounts;
+    int allowedDeviation = constraints.maxPipDeviation * NUM_VALUED_TILES;
+
+    data.clear();
+    for (int tile = 0; tile < NUM_TILES; tile++) {
+        // Draw the next tile of a Fisher-Yates shuffle; the park always takes the 7
+        std::swap(resources[tile], resources[tile + rng.nextInt(NUM_TILES - tile)]);
+        Resource resource = resources[tile];
+        int value = 7;
+        if (resource != PARK) {
+            std::swap(values[valuesDrawn], values[valuesDrawn + rng.nextInt(NUM_VALUED_TILES - valuesDrawn)]);
+            value = values[valuesDrawn++];
+        }
+        data.push_back(TileInitData{value, resource});
+
+        // Only neighbours drawn so far can break a constraint; the rest are checked when they are drawn
+        TileMask drawnNeighbours = tileNeighbours[tile] & (tileBit(tile) - 1);
+        if (constraints.separateHotValues && isHot(value)) {
+            if (hotTiles & drawnNeighbours) {
+                return false;
+            }
+            hotTiles |= tileBit(tile);
+        }
+
+        if (resource == PARK) {
+            continue;
+        }
+
+        if (constraints.maxClusterSize > 0 && clusters.add(tile, drawnNeighbours & resourceTiles[resource]) > constraints.maxClusterSize) {
+            return false;
+        }
+        resourceTiles[resource] |= tileBit(tile);
+
+        if (constraints.maxPipDeviation >= 0) {
+            // Give up as soon as the resource is already too productive, or can no longer be productive enough
+            rollWays[resource] += Board::rollWays(value);
+            tilesLeft[resource]--;
+            if (pipDeviation(rollWays[resource], resource) > allowedDeviation || pipDeviation(rollWays[resource] + tilesLeft[resource] * MAX_ROLL_WAYS, resource) < -allowedDeviation) {
+                return false;
+            }
+        }
+    }
+
+    // Each resource's last tile checked its total exactly
+    return true;
+}
+
+std::vector<TileInitData> BoardGenerator::generate(RandomEngine& rng, long long* attempts) const {
+    std::vector<TileInitData> data;
+    data.reserve(NUM_TILES);
+    for (int i = 1; i <= MAX_ATTEMPTS; i++) {
+        if (tryGenerate(rng, data)) {
+            if (attempts) {
+                *attempts += i;
+            }
+            return data;
+        }
+    }
+    throw std::runtime_error("No board found that meets the constraints");
+}
+
+bool BoardGenerator::isSatisfiedBy(const std::vector<TileInitData>& data) const {
+    if (data.size() != NUM_TILES) {
+        return false;
+    }
+
+    TileMask hotTiles = 0;
+    std::array<TileMask, ResourceBundle::NUM_RESOURCES> resourceTiles{};
+    ResourceBundle rollWays;
+    for (int i = 0; i < NUM_TILES; i++) {
+        if (isHot(data[i].tileValue)) {
+            hotTiles |= tileBit(i);
+        }
+        if (data[i].resource != PARK) {
+            resourceTiles[data[i].resource] |= tileBit(i);
+            rollWays[data[i].resource] += Board::rollWays(data[i].tileValue);
+        }
+    }
+
+    for (int i = 0; i < NUM_TILES; i++) {
+        if (constraints.separateHotValues && (hotTiles & tileBit(i)) && (hotTiles & tileNeighbours[i])) {
+            return false;
+        }
+        if (constraints.maxClusterSize == 0 || data[i].resource == PARK) {
+            continue;
+        }
+
+        // Flood fill the tile's cluster
+        TileMask sameResource = resourceTiles[data[i].resource];
+        TileMask cluster = tileBit(i);
+        for (TileMask added = cluster; added != 0;) {
+            TileMask grown = cluster;
+            for (TileMask bits = added; bits != 0; bits &= bits - 1) {
+                grown |= tileNeighbours[lowestBit(bits)] & sameResource;
+            }
+            added = grown & ~cluster;
+            cluster = grown;
+        }
+        if (__builtin_popcount(cluster) > constraints.maxClusterSize) {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < ResourceBundle::NUM_RESOURCES; i++) {
+        Resource resource = static_cast<Resource>(i);
+        if (constraints.maxPipDeviation >= 0 && std::abs(pipDeviation(rollWays[resource], resource)) > constraints.maxPipDeviation * NUM_VALUED_TILES) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int BoardGenerator::getThreadCount(int threads, int count) {
+    int hardwareThreads = threads > 0 ? threads : static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1, std::min(hardwareThreads, count));
+}
+
+void BoardGenerator::generateShard(int shard, int shards, std::vector<std::vector<TileInitData>>& boards, uint64_t seed, long long& attempts, std::exception_ptr& error) const {
+    // Count attempts locally so that threads never write to neighbouring counters while drawing
+    long long localAttempts = 0;
+    try {
+        for (size_t i = shard; i < boards.size(); i += shards) {
+            // Board i always comes from stream i, whichever thread draws it
+            RandomEngine rng{seed, i};
+            boards[i] = generate(rng, &localAttempts);
+        }
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+    attempts = localAttempts;
+}
+
+GeneratedBoards BoardGenerator::generateMany(int count, uint64_t seed, int threads) const {
+    int shards = getThreadCount(threads, count);
+    GeneratedBoards results;
+    results.boards.resize(count);
+    std::vector<long long> shardAttempts(shards);
+    std::vector<std::exception_ptr> shardErrors(shards);
+    std::vector<std::thread> workers;
+
+    for (int i = 1; i < shards; i++) {
+        workers.emplace_back(&BoardGenerator::generateShard, this, i, shards, std::ref(results.boards), seed, std::ref(shardAttempts[i]), std::ref(shardErrors[i]));
+    }
+    generateShard(0, shards, results.boards, seed, shardAttempts[0], shardErrors[0]);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    for (int i = 0; i < shards; i++) {
+        if (shardErrors[i]) {
+            std::rethrow_exception(shardErrors[i]);
+        }
+        results.attempts += shardAttempts[i];
+    }
+    return results;
+}
@@ -0,0 +1,60 @@
+#ifndef BOARDGENERATOR_H
+#define BOARDGENERATOR_H
+
+#include "../board/board.h"
+#include "../board/topology.h"
+#include "../common/forward.h"
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+// Balance rules a generated board must meet
+struct BoardConstraints {
+    bool separateHotValues = true; // No two tiles valued 6 or 8 may share a side
+    int maxClusterSize = 2;        // Largest group of side-sharing tiles with the same resource; 0 for no limit
+    int maxPipDeviation = 3;       // Most a resource's total rollWays may stray from its share of the board's; -1 for no limit
+};
+
+// Boards drawn by BoardGenerator::generateMany, along with how many draws it took to find them
+struct GeneratedBoards {
+    std::vector<std::vector<TileInitData>> boards;
+    long long attempts = 0;
+};
+
+/**
+ * Draws random boards with the same tiles and values as Game::generateRandomBoard, rejecting those that break
+ * the constraints. Tiles are drawn one at a time (a lazy Fisher-Yates shuffle) and checked against the
+ * already-drawn neighbours as they go, so most rejected boards are abandoned after a few tiles; as every draw
+ * is thrown away whole, accepted boards are still uniform over those meeting the constraints.
+ * Batches are spread over several threads, with board i always drawn from random stream i of the seed.
+ */
+class BoardGenerator final {
+  public:
+    static const int MAX_ATTEMPTS = 1000000; // Per board, before the constraints are deemed unsatisfiable
+
+  private:
+    const BoardConstraints constraints;
+    static constexpr std::array<TileMask, Topology::NUM_TILES> tileNeighbours = Topology::makeTileNeighbourMasks();
+
+    bool tryGenerate(RandomEngine&, std::vector<TileInitData>&) const;
+    void generateShard(int shard, int shards, std::vector<std::vector<TileInitData>>&, uint64_t seed, long long& attempts, std::exception_ptr&) const;
+
+  public:
+    // Throws std::invalid_argument for a negative cluster size or a pip deviation below -1
+    BoardGenerator(BoardConstraints = BoardConstraints{});
+    ~BoardGenerator();
+
+    // Throws std::runtime_error if no board is found within MAX_ATTEMPTS draws; attempts, if given, counts the draws
+    std::vector<TileInitData> generate(RandomEngine&, long long* attempts = nullptr) const;
+
+    // Draws count boards on the given number of threads (0 for one per hardware thread)
+    GeneratedBoards generateMany(int count, uint64_t seed, int threads = 0) const;
+
+    // Checks a complete board from scratch
+    bool isSatisfiedBy(const std::vector<TileInitData>&) const;
+
+    static int getThreadCount(int threads, int count);
+};
+
+#endif
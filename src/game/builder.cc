@@ -1,25 +1,39 @@
 #include "builder.h"
 #include "../board/edge.h"
+#include "../board/vertex.h"
 #include "../dice/dice.h"
 #include "../dice/fairdice.h"
 #include "../dice/loadeddice.h"
-#include "../structures/basement.h"
-#include "../structures/house.h"
-#include "../structures/road.h"
-#include "../structures/tower.h"
+#include "../structures/residence.h"
 #include <sstream>
 #include <algorithm>
 
+// Dice keep no state of their own (fair rolls draw from the game's RandomEngine), so every builder shares these
+static LoadedDice loadedDice;
+static FairDice fairDice;
+
 Builder::Builder(int builderNumber, char builderColour) : builderNumber{builderNumber},
-    builderColour{builderColour}, hasLoadedDice{true}, dice{std::make_unique<LoadedDice>()},
-    inventory{{BRICK, 0}, {ENERGY, 0}, {GLASS, 0}, {HEAT, 0}, {WIFI, 0}} {}
+    builderColour{builderColour}, hasLoadedDice{true}, dice{&loadedDice},
+    buildingPoints{0}, inventory{} {}
 
 Builder::Builder(int builderNumber, char builderColour, BuilderResourceData brd) : builderNumber{builderNumber},
-    builderColour{builderColour}, hasLoadedDice{true}, dice{std::make_unique<LoadedDice>()},
-    inventory{{BRICK, brd.brickNum}, {ENERGY, brd.energyNum}, {GLASS, brd.glassNum}, {HEAT, brd.heatNum}, {WIFI, brd.wifiNum}} {}
+    builderColour{builderColour}, hasLoadedDice{true}, dice{&loadedDice},
+    buildingPoints{0}, inventory{brd.brickNum, brd.energyNum, brd.glassNum, brd.heatNum, brd.wifiNum} {}
 
 Builder::~Builder() {}
 
+BuilderSnapshot Builder::snapshot() const {
+    return BuilderSnapshot{inventory, residences, roads, buildingPoints, hasLoadedDice};
+}
+
+void Builder::restore(const BuilderSnapshot& snapshot) {
+    inventory = snapshot.inventory;
+    residences = snapshot.residences;
+    roads = snapshot.roads;
+    buildingPoints = snapshot.buildingPoints;
+    setDice(snapshot.hasLoadedDice);
+}
+
 bool Builder::operator==(const Builder& other) const {
     return builderNumber == other.builderNumber && builderColour == other.builderColour && residences == other.residences && roads == other.roads && inventory == other.inventory;
 }
@@ -33,11 +47,6 @@ char Builder::getBuilderColour() const {
 }
 
 int Builder::getBuildingPoints() const {
-    int buildingPoints = 0;
-    for (auto& residence : residences) {
-        buildingPoints += residence->getBuildingPoints();
-    }
-
     return buildingPoints;
 }
 
@@ -63,12 +72,8 @@ std::string Builder::getBuilderColourString() const {
     return colourString;
 }
 
-int Builder::getTotalResourceQuantity() {
-    int inventoryNum = 0;
-    for (auto& resource : inventory) {
-        inventoryNum += resource.second;
-    }
-    return inventoryNum;
+int Builder::getTotalResourceQuantity() const {
+    return inventory.total();
 }
 
 std::string Builder::getStatus() const {
@@ -81,39 +86,25 @@ std::string Builder::getStatus() const {
     return oss.str();
 }
 
-int Builder::rollDice(int roll) const {
-    return dice->rollDice(roll);
+int Builder::rollDice(int roll, RandomEngine& rng) const {
+    return dice->rollDice(roll, rng);
 }
 
 void Builder::setDice(bool isLoaded) {
     if (isLoaded) {
-        dice.reset(new LoadedDice());
+        dice = &loadedDice;
         hasLoadedDice = true;
     }
     else {
-        dice.reset(new FairDice());
+        dice = &fairDice;
         hasLoadedDice = false;
     }
 }
 
-bool Builder::getHasLoadedDice() {
+bool Builder::getHasLoadedDice() const {
     return hasLoadedDice;
 }
 
-int Builder::chooseGeeseSpot(std::istream& in, std::ostream& out) const {
-    int geesePosition;
-    out << "Choose where to place the GEESE." << std::endl;
-    in >> geesePosition;
-    return geesePosition;
-}
-
-char Builder::steal(std::istream& in, std::ostream& out) const {
-    char stealFrom;
-    out << "Choose a builder to steal from." << std::endl;
-    in >> stealFrom;
-    return stealFrom;
-}
-
 Trade Builder::proposeTrade(std::string proposee, int numGive, std::string resourceToGive, int numTake, std::string resourceToTake, std::ostream& out) const {
     Trade trade;
 
@@ -129,7 +120,7 @@ Trade Builder::proposeTrade(std::string proposee, int numGive, std::string resou
     trade.numToTake = numTake;
     trade.resourceToTake = resourceFromString(resourceToTake);
 
-    out << getBuilderColourString() << " offers " << trade.proposeeColour << " " << numGive << " " << resourceToGive << " for " << numTake << " " << resourceToTake << "." << std::endl;
+    out << getBuilderColourString() << " offers " << trade.proposeeColour << " " << numGive << " " << resourceToGive << " for " << numTake << " " << resourceToTake << ".\n";
     return trade;
 }
 
@@ -140,85 +131,69 @@ bool Builder::respondToTrade(std::istream& in, std::ostream& out) const {
     return response == "yes";
 }
 
-std::shared_ptr<Road> Builder::tryBuildRoad(Edge& edge) {
-    if (inventory.at(HEAT) < 1 || inventory.at(WIFI) < 1) {
-        return nullptr;
+bool Builder::tryBuildRoad(const Edge& edge) {
+    if (!inventory.canAfford(ROAD_COST)) {
+        return false;
     }
 
-    std::shared_ptr<Road> road = std::make_shared<Road>(*this, edge);
-    inventory.at(HEAT) -= 1;
-    inventory.at(WIFI) -= 1;
-    roads.emplace_back(road);
-    return road;
+    inventory -= ROAD_COST;
+    roads.emplace_back(edge.getEdgeNumber());
+    return true;
 }
 
-std::shared_ptr<Residence> Builder::tryBuildResidence(Vertex& vertex) {
-    if (inventory.at(BRICK) < 1 || inventory.at(ENERGY) < 1 || inventory.at(GLASS) < 1 || inventory.at(WIFI) < 1) {
-        return nullptr;
+bool Builder::tryBuildResidence(const Vertex& vertex) {
+    if (!inventory.canAfford(BASEMENT_COST)) {
+        return false;
     }
 
-    std::shared_ptr<Residence> residence = std::make_shared<Basement>(*this, vertex);
-    inventory.at(BRICK) -= 1;
-    inventory.at(ENERGY) -= 1;
-    inventory.at(GLASS) -= 1;
-    inventory.at(WIFI) -= 1;
-    residences.emplace_back(residence);
-    return residence;
+    inventory -= BASEMENT_COST;
+    return tryBuildInitialResidence(vertex);
 }
 
-std::shared_ptr<Residence> Builder::tryBuildInitialResidence(Vertex& vertex) {
-    std::shared_ptr<Residence> residence = std::make_shared<Basement>(*this, vertex);
-    residences.emplace_back(residence);
-    return residence;
+bool Builder::tryBuildInitialResidence(const Vertex& vertex) {
+    addResidence(vertex.getVertexNumber(), Residence{builderNumber});
+    return true;
 }
 
-std::shared_ptr<Residence> Builder::tryUpgradeResidence(Vertex& vertex) {
-    std::shared_ptr<Residence> residence = nullptr;
-
+bool Builder::tryUpgradeResidence(const Vertex& vertex) {
     // Cannot upgrade a non-existent residence!
-    if(vertex.getResidence() == nullptr) {
-        return nullptr;
+    switch (vertex.getResidence().getLevel()) {
+        case ResidenceLevel::BASEMENT:
+            if (!inventory.canAfford(HOUSE_COST)) {
+                return false;
+            }
+            inventory -= HOUSE_COST;
+            break;
+        case ResidenceLevel::HOUSE:
+            if (!inventory.canAfford(TOWER_COST)) {
+                return false;
+            }
+            inventory -= TOWER_COST;
+            break;
+        default:
+            return false;
     }
 
-    switch (vertex.getResidence()->getResidenceLetter()) {
-        case 'B':
-            if (inventory.at(GLASS) < 2 || inventory.at(HEAT) < 3) {
-                return nullptr;
-            }
+    // Every upgrade is worth one more building point
+    buildingPoints++;
+    return true;
+}
 
-            residence = std::make_shared<House>(*this, vertex);
-            inventory.at(GLASS) -= 2;
-            inventory.at(HEAT) -= 3;
-            for (size_t i = 0; i < residences.size(); i++) {
-                if (residences[i]->getLocation().getVertexNumber() == vertex.getVertexNumber()) {
-                    residences[i] = residence;
-                    return residence;
-                }
-            }
+void Builder::unbuildRoad() {
+    roads.pop_back();
+}
 
-            // Should not ever get reached
-            return nullptr;
-        case 'H':
-            if (inventory.at(BRICK) < 3 || inventory.at(ENERGY) < 2 || inventory.at(GLASS) < 2 || inventory.at(HEAT) < 2 || inventory.at(WIFI) < 1) {
-                return nullptr;
-            }
+void Builder::unbuildResidence() {
+    residences.pop_back();
+    buildingPoints -= Residence{builderNumber}.getBuildingPoints();
+}
 
-            residence = std::make_shared<Tower>(*this, vertex);
-            inventory.at(BRICK) -= 3;
-            inventory.at(ENERGY) -= 2;
-            inventory.at(GLASS) -= 2;
-            inventory.at(HEAT) -= 2;
-            inventory.at(WIFI) -= 1;
-            for (size_t i = 0; i < residences.size(); i++) {
-                if (residences[i]->getLocation().getVertexNumber() == vertex.getVertexNumber()) {
-                    residences[i] = residence;
-                    return residence;
-                }
-            }
+void Builder::downgradeResidence() {
+    // Every upgrade is worth exactly one point
+    buildingPoints--;
+}
 
-            // Should not ever get reached
-            return nullptr;
-        default:
-            return nullptr;
-    }
+void Builder::addResidence(int vertexNumber, const Residence& residence) {
+    residences.emplace_back(vertexNumber);
+    buildingPoints += residence.getBuildingPoints();
 }
@@ -1,12 +1,14 @@
 #ifndef BUILDER_H
 #define BUILDER_H
 
+#include "../board/topology.h"
+#include "../common/fixedvector.h"
 #include "../common/forward.h"
 #include "../common/resource.h"
+#include "../common/resourcebundle.h"
 #include "../common/trade.h"
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 // Stores information used to initialize builder
@@ -25,44 +27,67 @@ struct BuilderStructureData {
     BuilderStructureData(const std::vector<std::pair<int, char>>& residences, const std::vector<int>& roads) : residences{residences}, roads{roads} {}
 };
 
+// Everything about a Builder that changes during play; trivially copyable
+struct BuilderSnapshot {
+    ResourceBundle inventory;
+    FixedVector<int, Topology::NUM_VERTICES> residences;
+    FixedVector<int, Topology::NUM_EDGES> roads;
+    int buildingPoints = 0;
+    bool hasLoadedDice = true;
+};
+
 class Builder final {
   private:
     const int builderNumber;
     const char builderColour;
     bool hasLoadedDice;
-    std::unique_ptr<Dice> dice;
+    Dice* dice; // Shared and stateless, so builders copy freely
+    int buildingPoints; // Kept up to date as residences are built and upgraded
 
   public:
-    std::vector<std::shared_ptr<Residence>> residences;
-    std::vector<std::shared_ptr<Road>> roads;
-    std::unordered_map<Resource, int> inventory; // "PARK" should never be one of the keys in this map
+    // The structures themselves live on the board; builders only list where theirs are, in build order
+    FixedVector<int, Topology::NUM_VERTICES> residences;
+    FixedVector<int, Topology::NUM_EDGES> roads;
+    ResourceBundle inventory;
 
     Builder(int, char);
     Builder(int, char, BuilderResourceData);
+    Builder(const Builder&) = default;
     ~Builder();
 
     bool operator==(const Builder&) const;
 
+    BuilderSnapshot snapshot() const;
+    void restore(const BuilderSnapshot&);
+
     int getBuilderNumber() const;
     char getBuilderColour() const;
     std::string getBuilderColourString() const;
     int getBuildingPoints() const;
-    int getTotalResourceQuantity();
+    int getTotalResourceQuantity() const;
     std::string getStatus() const;
 
-    int rollDice(int) const;
+    int rollDice(int, RandomEngine&) const;
     void setDice(bool);
-    bool getHasLoadedDice();
+    bool getHasLoadedDice() const;
 
-    int chooseGeeseSpot(std::istream&, std::ostream&) const; // Select tile number to place geese on
-    char steal(std::istream&, std::ostream&) const; // Select which other Builder to steal from
     Trade proposeTrade(std::string, int, std::string, int, std::string, std::ostream&) const;
     bool respondToTrade(std::istream&, std::ostream&) const;
 
-    std::shared_ptr<Road> tryBuildRoad(Edge&);
-    std::shared_ptr<Residence> tryBuildResidence(Vertex&);
-    std::shared_ptr<Residence> tryBuildInitialResidence(Vertex&);
-    std::shared_ptr<Residence> tryUpgradeResidence(Vertex&);
+    // Each pays for and records the structure, returning false if it cannot be afforded;
+    // placing it on the Vertex or Edge is left to the caller
+    bool tryBuildRoad(const Edge&);
+    bool tryBuildResidence(const Vertex&);
+    bool tryBuildInitialResidence(const Vertex&);
+    bool tryUpgradeResidence(const Vertex&);
+
+    // Inverses of the builds above for the most recent such build, as when undoing it; refunds are left to the caller
+    void unbuildRoad();
+    void unbuildResidence();
+    void downgradeResidence();
+
+    // Records a residence placed without paying for it, as when loading a game
+    void addResidence(int, const Residence&);
 };
 
 #endif
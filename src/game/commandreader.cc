@@ -0,0 +1,64 @@
+#include "commandreader.h"
+#include <cctype>
+#include <charconv>
+
+CommandReader::CommandReader(std::istream& in) : in{in} {}
+
+bool CommandReader::readWord(std::string_view& word) {
+    // The sentry skips leading whitespace and flushes any tied output, such as a prompt on std::cout
+    std::istream::sentry sentry{in};
+    if (!sentry) {
+        return false;
+    }
+
+    std::streambuf* buffer = in.rdbuf();
+    token.clear();
+    int c = buffer->sgetc();
+    while (c != std::char_traits<char>::eof() && !std::isspace(c)) {
+        token.push_back(static_cast<char>(c));
+        c = buffer->snextc();
+    }
+    if (c == std::char_traits<char>::eof()) {
+        in.setstate(std::ios::eofbit);
+    }
+
+    word = token;
+    return true;
+}
+
+bool CommandReader::readInt(int& value) {
+    std::istream::sentry sentry{in};
+    if (!sentry) {
+        return false;
+    }
+
+    // Gather an optional sign and the digits after it, leaving anything else for the next read
+    std::streambuf* buffer = in.rdbuf();
+    token.clear();
+    int c = buffer->sgetc();
+    if (c == '+' || c == '-') {
+        token.push_back(static_cast<char>(c));
+        c = buffer->snextc();
+    }
+    while (c != std::char_traits<char>::eof() && std::isdigit(c)) {
+        token.push_back(static_cast<char>(c));
+        c = buffer->snextc();
+    }
+    if (c == std::char_traits<char>::eof()) {
+        in.setstate(std::ios::eofbit);
+    }
+
+    // from_chars rejects a leading '+', which operator>> accepts
+    const char* first = token.data() + (!token.empty() && token[0] == '+');
+    const char* last = token.data() + token.size();
+    std::from_chars_result result = std::from_chars(first, last, value);
+    if (result.ec != std::errc() || result.ptr != last) {
+        in.setstate(std::ios::failbit);
+        return false;
+    }
+    return true;
+}
+
+std::istream& CommandReader::getStream() {
+    return in;
+}
@@ -0,0 +1,30 @@
+#ifndef COMMANDREADER_H
+#define COMMANDREADER_H
+
+#include <istream>
+#include <string>
+#include <string_view>
+
+/**
+ * Whitespace-separated tokenizer for console commands, reading straight from the stream's buffer.
+ * Words come back as views into a buffer reused between reads, so a long command log is replayed
+ * without allocating per command. It consumes exactly what operator>> would (a word, or the sign and
+ * digits of a number) and sets the same fail/eof bits, so it can be mixed with plain stream reads
+ * and never reads ahead of the current token, which keeps interactive input working line by line.
+ */
+class CommandReader final {
+  private:
+    std::istream& in;
+    std::string token; // Backing storage for the last word read
+
+  public:
+    explicit CommandReader(std::istream&);
+
+    // The view is valid until the next read
+    bool readWord(std::string_view&);
+    bool readInt(int&);
+
+    std::istream& getStream();
+};
+
+#endif
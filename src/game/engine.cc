@@ -0,0 +1,636 @@
+#include "engine.h"
+#include "../board/abstracttile.h"
+#include "../common/inventoryupdate.h"
+#include "../common/zobrist.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+
+Engine::Engine(std::vector<TileInitData> data, RandomEngine rng) : currentBuilder{0}, phase{TurnPhase::INITIAL_PLACEMENT}, initialResidencesBuilt{0}, winner{-1}, rng{rng} {
+    board = std::make_unique<Board>(data);
+
+    builders.push_back(std::make_unique<Builder>(0, 'B'));
+    builders.push_back(std::make_unique<Builder>(1, 'R'));
+    builders.push_back(std::make_unique<Builder>(2, 'O'));
+    builders.push_back(std::make_unique<Builder>(3, 'Y'));
+}
+
+Engine::Engine(std::vector<TileInitData> data, std::vector<BuilderResourceData> resourceData, std::vector<BuilderStructureData> structureData, int currentBuilder, int geeseTile, RandomEngine rng) : currentBuilder{currentBuilder}, phase{TurnPhase::POST_ROLL}, initialResidencesBuilt{2 * NUM_BUILDERS}, winner{-1}, rng{rng} {
+    builders.push_back(std::make_unique<Builder>(0, 'B', resourceData[0]));
+    builders.push_back(std::make_unique<Builder>(1, 'R', resourceData[1]));
+    builders.push_back(std::make_unique<Builder>(2, 'O', resourceData[2]));
+    builders.push_back(std::make_unique<Builder>(3, 'Y', resourceData[3]));
+
+    std::vector<std::pair<Builder*, BuilderStructureData>> structures = {{builders.at(0).get(), structureData.at(0)}, {builders.at(1).get(), structureData.at(1)}, {builders.at(2).get(), structureData.at(2)}, {builders.at(3).get(), structureData.at(3)}};
+    board = std::make_unique<Board>(data, structures);
+    board->setGeeseTile(geeseTile);
+
+    // Saved games resume after the current builder's roll
+    for (int i = 0; i < NUM_BUILDERS && winner == -1; i++) {
+        if (builders[i]->getBuildingPoints() >= POINTS_TO_WIN) {
+            winner = i;
+            phase = TurnPhase::GAME_OVER;
+        }
+    }
+}
+
+Engine::Engine(const Engine& other) : board{std::make_unique<Board>(*other.board)}, currentBuilder{other.currentBuilder}, phase{other.phase},
+    initialResidencesBuilt{other.initialResidencesBuilt}, winner{other.winner}, stealCandidates{other.stealCandidates}, result{other.result}, rng{other.rng},
+    recordingUndo{other.recordingUndo}, undoJournal{other.undoJournal} {
+    for (const std::unique_ptr<Builder>& builder : other.builders) {
+        builders.push_back(std::make_unique<Builder>(*builder));
+    }
+}
+
+Engine::~Engine() {}
+
+EngineSnapshot Engine::snapshot() const {
+    EngineSnapshot snapshot;
+    snapshot.board = board->snapshot();
+    for (int i = 0; i < NUM_BUILDERS; i++) {
+        snapshot.builders[i] = builders[i]->snapshot();
+    }
+    snapshot.currentBuilder = currentBuilder;
+    snapshot.phase = phase;
+    snapshot.initialResidencesBuilt = initialResidencesBuilt;
+    snapshot.winner = winner;
+    for (int candidate : stealCandidates) {
+        snapshot.stealCandidates.emplace_back(candidate);
+    }
+    snapshot.rng = rng;
+    return snapshot;
+}
+
+void Engine::restore(const EngineSnapshot& snapshot) {
+    board->restore(snapshot.board);
+    for (int i = 0; i < NUM_BUILDERS; i++) {
+        builders[i]->restore(snapshot.builders[i]);
+    }
+    currentBuilder = snapshot.currentBuilder;
+    phase = snapshot.phase;
+    initialResidencesBuilt = snapshot.initialResidencesBuilt;
+    winner = snapshot.winner;
+    stealCandidates.assign(snapshot.stealCandidates.begin(), snapshot.stealCandidates.end());
+    rng = snapshot.rng;
+    result.events.clear();
+    undoJournal.clear();
+}
+
+void Engine::setUndoEnabled(bool enabled) {
+    recordingUndo = enabled;
+    undoJournal.clear();
+}
+
+bool Engine::canUndo() const {
+    return !undoJournal.empty();
+}
+
+void Engine::undo() {
+    if (undoJournal.empty()) {
+        throw std::logic_error("Nothing to undo");
+    }
+    const UndoRecord& record = undoJournal.back();
+    Builder& builder = *builders[record.currentBuilder];
+
+    switch (record.type) {
+        case ActionType::BUILD_ROAD:
+            board->unbuildRoad(builder, record.target);
+            break;
+        case ActionType::BUILD_INITIAL_RESIDENCE:
+        case ActionType::BUILD_RESIDENCE:
+            board->unbuildResidence(builder, record.target);
+            break;
+        case ActionType::IMPROVE:
+            board->downgradeResidence(builder, record.target);
+            break;
+        case ActionType::MOVE_GEESE:
+            board->setGeeseTile(record.geeseTile);
+            break;
+        default:
+            break;
+    }
+
+    for (int i = 0; i < NUM_BUILDERS; i++) {
+        builders[i]->inventory -= record.inventoryDeltas[i];
+    }
+    builder.setDice(record.hasLoadedDice);
+    currentBuilder = record.currentBuilder;
+    phase = record.phase;
+    initialResidencesBuilt = record.initialResidencesBuilt;
+    winner = record.winner;
+    stealCandidates.assign(record.stealCandidates.begin(), record.stealCandidates.end());
+    rng = record.rng;
+
+    result.events.clear();
+    undoJournal.pop_back();
+}
+
+void Engine::generateLegalActions(LegalActions& actions) const {
+    actions.clear();
+    const Builder& builder = *builders[currentBuilder];
+
+    switch (phase) {
+        case TurnPhase::INITIAL_PLACEMENT:
+            for (int i = 0; i < Board::NUM_VERTICES; i++) {
+                if (board->canBuildInitialResidence(i)) {
+                    actions.emplace_back(Action{ActionType::BUILD_INITIAL_RESIDENCE, i});
+                }
+            }
+            break;
+
+        case TurnPhase::PRE_ROLL:
+            actions.emplace_back(Action{ActionType::LOAD_DICE});
+            actions.emplace_back(Action{ActionType::FAIR_DICE});
+            if (builder.getHasLoadedDice()) {
+                for (int roll = 2; roll <= 12; roll++) {
+                    actions.emplace_back(Action{ActionType::ROLL, roll});
+                }
+            }
+            else {
+                actions.emplace_back(Action{ActionType::ROLL});
+            }
+            break;
+
+        case TurnPhase::POST_ROLL:
+            board->generateLegalActions(builder, actions);
+            for (int i = 0; i < NUM_BUILDERS; i++) {
+                if (i == currentBuilder) {
+                    continue;
+                }
+                for (int give = 0; give < ResourceBundle::NUM_RESOURCES; give++) {
+                    for (int take = 0; take < ResourceBundle::NUM_RESOURCES; take++) {
+                        Resource toGive = static_cast<Resource>(give);
+                        Resource toTake = static_cast<Resource>(take);
+                        if (give != take && builder.inventory[toGive] > 0 && builders[i]->inventory[toTake] > 0) {
+                            actions.emplace_back(Action{ActionType::TRADE, i, Trade{"", 1, toGive, 1, toTake}});
+                        }
+                    }
+                }
+            }
+            actions.emplace_back(Action{ActionType::END_TURN});
+            break;
+
+        case TurnPhase::GEESE_PLACEMENT:
+            for (int i = 0; i < Board::NUM_TILES; i++) {
+                if (i != getGeeseLocation()) {
+                    actions.emplace_back(Action{ActionType::MOVE_GEESE, i});
+                }
+            }
+            break;
+
+        case TurnPhase::STEAL:
+            for (int candidate : stealCandidates) {
+                actions.emplace_back(Action{ActionType::STEAL, candidate});
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+const ActionResult& Engine::apply(const Action& action) {
+    result.events.clear();
+
+    if (!acceptsAction(action.type)) {
+        result.status = ActionStatus::INVALID_PHASE;
+        return result;
+    }
+
+    // Everything the action might change that cannot be recomputed from the action itself; journalled in place,
+    // and only when undo is on, as the record is too big to build for every action
+    if (recordingUndo) {
+        undoJournal.emplace_back();
+        UndoRecord& record = undoJournal.back();
+        record.type = action.type;
+        record.target = action.target;
+        for (int i = 0; i < NUM_BUILDERS; i++) {
+            record.inventoryDeltas[i] = builders[i]->inventory;
+        }
+        record.currentBuilder = currentBuilder;
+        record.phase = phase;
+        record.initialResidencesBuilt = initialResidencesBuilt;
+        record.winner = winner;
+        record.geeseTile = board->getGeeseTile();
+        record.hasLoadedDice = builders[currentBuilder]->getHasLoadedDice();
+        for (int candidate : stealCandidates) {
+            record.stealCandidates.emplace_back(candidate);
+        }
+        record.rng = rng;
+    }
+
+    switch (action.type) {
+        case ActionType::LOAD_DICE:
+            result.status = setDice(true);
+            break;
+        case ActionType::FAIR_DICE:
+            result.status = setDice(false);
+            break;
+        case ActionType::ROLL:
+            result.status = roll(action.target);
+            break;
+        case ActionType::BUILD_INITIAL_RESIDENCE:
+        case ActionType::BUILD_ROAD:
+        case ActionType::BUILD_RESIDENCE:
+        case ActionType::IMPROVE:
+            result.status = build(action.type, action.target);
+            break;
+        case ActionType::TRADE:
+            result.status = trade(action.target, action.trade);
+            break;
+        case ActionType::MOVE_GEESE:
+            result.status = moveGeese(action.target);
+            break;
+        case ActionType::STEAL:
+            result.status = steal(action.target);
+            break;
+        case ActionType::END_TURN:
+            result.status = endTurn();
+            break;
+    }
+
+    if (recordingUndo && result.status != ActionStatus::SUCCESS) {
+        undoJournal.pop_back();
+    }
+    else if (recordingUndo) {
+        UndoRecord& record = undoJournal.back();
+        for (int i = 0; i < NUM_BUILDERS; i++) {
+            record.inventoryDeltas[i] = builders[i]->inventory - record.inventoryDeltas[i];
+        }
+    }
+
+    return result;
+}
+
+bool Engine::acceptsAction(ActionType type) const {
+    switch (phase) {
+        case TurnPhase::INITIAL_PLACEMENT:
+            return type == ActionType::BUILD_INITIAL_RESIDENCE;
+        case TurnPhase::PRE_ROLL:
+            return type == ActionType::LOAD_DICE || type == ActionType::FAIR_DICE || type == ActionType::ROLL;
+        case TurnPhase::POST_ROLL:
+            return type == ActionType::BUILD_ROAD || type == ActionType::BUILD_RESIDENCE || type == ActionType::IMPROVE || type == ActionType::TRADE || type == ActionType::END_TURN;
+        case TurnPhase::GEESE_PLACEMENT:
+            return type == ActionType::MOVE_GEESE;
+        case TurnPhase::STEAL:
+            return type == ActionType::STEAL;
+        default:
+            return false;
+    }
+}
+
+void Engine::addEvent(EventType type, int builder, int target, Resource resource, int amount) {
+    result.events.push_back(GameEvent{type, builder, target, resource, amount});
+}
+
+// One card drawn uniformly from the inventory, i.e. a resource picked with probability proportional to its count;
+// the inventory must not be empty
+Resource Engine::drawRandomResource(const ResourceBundle& inventory) {
+    int card = rng.nextInt(inventory.total());
+    for (int j = 0; j < ResourceBundle::NUM_RESOURCES; j++) {
+        Resource resource = static_cast<Resource>(j);
+        if (card < inventory[resource]) {
+            return resource;
+        }
+        card -= inventory[resource];
+    }
+    throw std::logic_error("Card drawn outside of inventory");
+}
+
+namespace {
+// Inventories of up to this many cards discard by exact hypergeometric draws; every C(n, k) in the table fits in 63 bits
+const int MAX_TABLED_CARDS = 64;
+
+constexpr int binomialIndex(int n, int k) {
+    return n * (n + 1) / 2 + k;
+}
+
+// Pascal's triangle up to MAX_TABLED_CARDS, one row after another
+constexpr std::array<uint64_t, binomialIndex(MAX_TABLED_CARDS + 1, 0)> makeBinomials() {
+    std::array<uint64_t, binomialIndex(MAX_TABLED_CARDS + 1, 0)> binomials{};
+    for (int n = 0; n <= MAX_TABLED_CARDS; n++) {
+        binomials[binomialIndex(n, 0)] = binomials[binomialIndex(n, n)] = 1;
+        for (int k = 1; k < n; k++) {
+            binomials[binomialIndex(n, k)] = binomials[binomialIndex(n - 1, k - 1)] + binomials[binomialIndex(n - 1, k)];
+        }
+    }
+    return binomials;
+}
+constexpr std::array<uint64_t, binomialIndex(MAX_TABLED_CARDS + 1, 0)> binomials = makeBinomials();
+
+uint64_t choose(int n, int k) {
+    return binomials[binomialIndex(n, k)];
+}
+
+// Uniformly distributed integer in [0, bound), by masking and rejecting; bound must be at least 2
+uint64_t nextBelow(RandomEngine& rng, uint64_t bound) {
+    uint64_t mask = ~uint64_t{0} >> __builtin_clzll(bound - 1);
+    while (true) {
+        uint64_t value = rng() & mask;
+        if (value < bound) {
+            return value;
+        }
+    }
+}
+
+/**
+ * Successes among count cards drawn from total, of which successes are successes, by inverting the cumulative
+ * distribution exactly in integers: the weight of x successes is C(successes, x) * C(total - successes, count - x),
+ * and these weights add up to C(total, count). Total must be at most MAX_TABLED_CARDS.
+ */
+int drawHypergeometric(RandomEngine& rng, int total, int successes, int count) {
+    int failures = total - successes;
+    int low = std::max(0, count - failures);
+    int high = std::min(successes, count);
+    if (low == high) {
+        return low;
+    }
+
+    uint64_t card = nextBelow(rng, choose(total, count));
+    int x = low;
+    for (; x < high; x++) {
+        uint64_t weight = choose(successes, x) * choose(failures, count - x);
+        if (card < weight) {
+            break;
+        }
+        card -= weight;
+    }
+    return x;
+}
+}
+
+/**
+ * Draws count cards without replacement, i.e. the multivariate hypergeometric distribution of shuffling every
+ * card and taking a prefix, without listing cards. Each resource's share is a univariate hypergeometric draw
+ * from the cards left once the previous resources' shares are known, so a draw takes one random number per
+ * resource rather than one per card, and stays in integers so that a seed replays identically everywhere.
+ * Drawing more than half the cards picks the ones kept instead. Larger inventories than the table covers draw
+ * one weighted pick over the five counts at a time, which is faster than exact weights in wider integers.
+ */
+ResourceBundle Engine::drawRandomResources(ResourceBundle inventory, int count) {
+    int total = inventory.total();
+    if (2 * count > total) {
+        return inventory - drawRandomResources(inventory, total - count);
+    }
+
+    ResourceBundle drawn;
+    if (total > MAX_TABLED_CARDS) {
+        for (int i = 0; i < count; i++) {
+            Resource resource = drawRandomResource(inventory);
+            inventory[resource]--;
+            drawn[resource]++;
+        }
+        return drawn;
+    }
+
+    for (int j = 0; j < ResourceBundle::NUM_RESOURCES && count > 0; j++) {
+        Resource resource = static_cast<Resource>(j);
+        drawn[resource] = drawHypergeometric(rng, total, inventory[resource], count);
+        // The rest of the draw comes from the other resources' cards
+        total -= inventory[resource];
+        count -= drawn[resource];
+    }
+    return drawn;
+}
+
+ActionStatus Engine::setDice(bool isLoaded) {
+    builders.at(currentBuilder)->setDice(isLoaded);
+    return ActionStatus::SUCCESS;
+}
+
+ActionStatus Engine::roll(int loaded) {
+    Builder& builder = *builders.at(currentBuilder);
+
+    if (builder.getHasLoadedDice() && (loaded < 2 || loaded > 12)) {
+        return ActionStatus::INVALID_ROLL;
+    }
+
+    int roll = builder.rollDice(loaded, rng);
+    addEvent(EventType::DICE_ROLLED, currentBuilder, -1, Resource::PARK, roll);
+
+    if (roll == 7) {
+        phase = TurnPhase::GEESE_DISCARD;
+        discardToGeese();
+        return ActionStatus::SUCCESS;
+    }
+
+    // distribute resources
+    BuilderInventoryUpdate update = board->getResourcesFromDiceRoll(roll);
+
+    for (int i = 0; i < NUM_BUILDERS; i++) {
+        builders[i]->inventory += update[i];
+        for (int j = 0; j < ResourceBundle::NUM_RESOURCES; j++) {
+            Resource resource = static_cast<Resource>(j);
+            if (update[i][resource] > 0) {
+                addEvent(EventType::RESOURCES_GAINED, i, -1, resource, update[i][resource]);
+            }
+        }
+    }
+
+    phase = TurnPhase::POST_ROLL;
+    return ActionStatus::SUCCESS;
+}
+
+void Engine::discardToGeese() {
+    // Every builder with 10 or more resources loses half of them to the geese
+    for (int i = 0; i < NUM_BUILDERS; i++) {
+        int total = builders[i]->getTotalResourceQuantity();
+        ResourceBundle discarded = drawRandomResources(builders[i]->inventory, total >= 10 ? total / 2 : 0);
+        builders[i]->inventory -= discarded;
+
+        for (int j = 0; j < ResourceBundle::NUM_RESOURCES; j++) {
+            Resource resource = static_cast<Resource>(j);
+            if (discarded[resource] > 0) {
+                addEvent(EventType::RESOURCES_DISCARDED, i, -1, resource, discarded[resource]);
+            }
+        }
+    }
+
+    phase = TurnPhase::GEESE_PLACEMENT;
+}
+
+ActionStatus Engine::build(ActionType type, int location) {
+    Builder& builder = *builders.at(currentBuilder);
+    ActionStatus status;
+    EventType event = EventType::RESIDENCE_BUILT;
+
+    switch (type) {
+        case ActionType::BUILD_INITIAL_RESIDENCE:
+            status = board->buildInitialResidence(builder, location);
+            break;
+        case ActionType::BUILD_ROAD:
+            status = board->buildRoad(builder, location);
+            event = EventType::ROAD_BUILT;
+            break;
+        case ActionType::BUILD_RESIDENCE:
+            status = board->buildResidence(builder, location);
+            break;
+        default:
+            status = board->upgradeResidence(builder, location);
+            event = EventType::RESIDENCE_IMPROVED;
+            break;
+    }
+
+    if (status != ActionStatus::SUCCESS) {
+        return status;
+    }
+    addEvent(event, currentBuilder, location, Resource::PARK, 0);
+
+    // Points only change on builds, and only the acting builder's, so this is the one place a game can be won
+    if (builder.getBuildingPoints() >= POINTS_TO_WIN) {
+        winner = currentBuilder;
+    }
+
+    if (type == ActionType::BUILD_INITIAL_RESIDENCE) {
+        // Snake draft: ascending builderNumber in the first round, descending in the second, then builder 0 starts
+        initialResidencesBuilt++;
+        if (initialResidencesBuilt == 2 * NUM_BUILDERS) {
+            currentBuilder = 0;
+            phase = TurnPhase::PRE_ROLL;
+            addEvent(EventType::TURN_BEGAN, currentBuilder, -1, Resource::PARK, 0);
+        }
+        else if (initialResidencesBuilt >= NUM_BUILDERS) {
+            currentBuilder = 2 * NUM_BUILDERS - 1 - initialResidencesBuilt;
+        }
+        else {
+            currentBuilder = initialResidencesBuilt;
+        }
+    }
+    else if (winner != -1) {
+        phase = TurnPhase::GAME_OVER;
+        addEvent(EventType::GAME_WON, winner, -1, Resource::PARK, 0);
+    }
+
+    return status;
+}
+
+ActionStatus Engine::trade(int proposeeNumber, const Trade& trade) {
+    if (proposeeNumber < 0 || proposeeNumber >= NUM_BUILDERS) {
+        return ActionStatus::INVALID_TARGET;
+    }
+    // A negative amount would move resources the other way without checking who can afford them
+    if (trade.numToGive <= 0 || trade.numToTake <= 0) {
+        return ActionStatus::INVALID_AMOUNT;
+    }
+
+    Builder& builder = *builders.at(currentBuilder);
+    Builder& proposee = *builders.at(proposeeNumber);
+
+    // Nobody ever owns any PARK, so it can never be traded
+    if (trade.resourceToGive == Resource::PARK || builder.inventory.at(trade.resourceToGive) < trade.numToGive) {
+        return ActionStatus::INSUFFICIENT_RESOURCES;
+    }
+    if (trade.resourceToTake == Resource::PARK || proposee.inventory.at(trade.resourceToTake) < trade.numToTake) {
+        return ActionStatus::TARGET_INSUFFICIENT_RESOURCES;
+    }
+
+    ResourceBundle given;
+    ResourceBundle taken;
+    given[trade.resourceToGive] = trade.numToGive;
+    taken[trade.resourceToTake] = trade.numToTake;
+
+    builder.inventory += taken - given;
+    proposee.inventory += given - taken;
+
+    addEvent(EventType::TRADE_COMPLETED, currentBuilder, proposeeNumber, Resource::PARK, 0);
+    return ActionStatus::SUCCESS;
+}
+
+ActionStatus Engine::moveGeese(int tile) {
+    if (tile < 0 || tile >= Board::NUM_TILES || tile == getGeeseLocation()) {
+        return ActionStatus::INVALID_LOCATION;
+    }
+
+    board->setGeeseTile(tile);
+    stealCandidates = board->getStealCandidates(tile, *builders.at(currentBuilder));
+
+    // Only builders with something to steal can be stolen from
+    stealCandidates.erase(std::remove_if(stealCandidates.begin(), stealCandidates.end(), [this](int candidate) {
+        return builders[candidate]->getTotalResourceQuantity() == 0;
+    }), stealCandidates.end());
+
+    addEvent(EventType::GEESE_MOVED, currentBuilder, tile, Resource::PARK, 0);
+    for (int candidate : stealCandidates) {
+        addEvent(EventType::STEAL_CANDIDATE, candidate, tile, Resource::PARK, 0);
+    }
+
+    phase = stealCandidates.empty() ? TurnPhase::POST_ROLL : TurnPhase::STEAL;
+    return ActionStatus::SUCCESS;
+}
+
+ActionStatus Engine::steal(int victimNumber) {
+    if (std::find(stealCandidates.begin(), stealCandidates.end(), victimNumber) == stealCandidates.end()) {
+        return ActionStatus::INVALID_TARGET;
+    }
+
+    Builder& builder = *builders.at(currentBuilder);
+    Builder& victim = *builders.at(victimNumber);
+
+    Resource resourceToSteal = drawRandomResource(victim.inventory);
+    builder.inventory[resourceToSteal]++;
+    victim.inventory[resourceToSteal]--;
+    stealCandidates.clear();
+    phase = TurnPhase::POST_ROLL;
+
+    addEvent(EventType::RESOURCE_STOLEN, currentBuilder, victimNumber, resourceToSteal, 1);
+    return ActionStatus::SUCCESS;
+}
+
+ActionStatus Engine::endTurn() {
+    currentBuilder++;
+    if (currentBuilder == NUM_BUILDERS) {
+        currentBuilder = 0;
+    }
+    phase = TurnPhase::PRE_ROLL;
+
+    addEvent(EventType::TURN_BEGAN, currentBuilder, -1, Resource::PARK, 0);
+    return ActionStatus::SUCCESS;
+}
+
+int Engine::getCurrentBuilder() const {
+    return currentBuilder;
+}
+
+const Builder& Engine::getBuilder(int builderNumber) const {
+    return *builders.at(builderNumber);
+}
+
+const std::vector<const Builder*> Engine::getBuilders() const {
+    std::vector<const Builder*> builders;
+    for (const std::unique_ptr<Builder>& b : this->builders) {
+        builders.push_back(b.get());
+    }
+
+    return builders;
+}
+
+const std::vector<int>& Engine::getStealCandidates() const {
+    return stealCandidates;
+}
+
+TurnPhase Engine::getPhase() const {
+    return phase;
+}
+
+int Engine::getGeeseLocation() const {
+    return board->getGeeseTile();
+}
+
+const Board& Engine::getBoard() const {
+    return *board;
+}
+
+uint64_t Engine::stateHash() const {
+    uint64_t hash = board->getHash() ^ Zobrist::key(Zobrist::Feature::CURRENT_BUILDER, currentBuilder);
+    for (int i = 0; i < NUM_BUILDERS; i++) {
+        for (int j = 0; j < ResourceBundle::NUM_RESOURCES; j++) {
+            hash ^= Zobrist::inventoryKey(i, j, builders[i]->inventory[static_cast<Resource>(j)]);
+        }
+    }
+    return hash;
+}
+
+int Engine::getWinner() const {
+    return winner;
+}
@@ -0,0 +1,136 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include "../board/board.h"
+#include "../common/action.h"
+#include "../common/forward.h"
+#include "../common/randomengine.h"
+#include "../common/resource.h"
+#include "builder.h"
+#include <array>
+#include <memory>
+#include <vector>
+
+// Everything about an Engine that changes during play; trivially copyable, so a game can be saved and
+// rewound any number of times without allocating
+struct EngineSnapshot {
+    static const int NUM_BUILDERS = 4;
+
+    BoardSnapshot board;
+    std::array<BuilderSnapshot, NUM_BUILDERS> builders{};
+    int currentBuilder = 0;
+    TurnPhase phase = TurnPhase::INITIAL_PLACEMENT;
+    int initialResidencesBuilt = 0;
+    int winner = -1;
+    FixedVector<int, NUM_BUILDERS> stealCandidates;
+    RandomEngine rng{0};
+};
+
+// Journal entry for one successful action: what it was, plus everything it changed that the action alone
+// does not determine, so that it can be reversed in place without copying the game
+struct UndoRecord {
+    static const int NUM_BUILDERS = 4;
+
+    ActionType type = ActionType::END_TURN;
+    int target = -1;
+    std::array<ResourceBundle, NUM_BUILDERS> inventoryDeltas{}; // Covers costs, rolls, discards, trades and steals
+    int currentBuilder = 0;
+    TurnPhase phase = TurnPhase::INITIAL_PLACEMENT;
+    int initialResidencesBuilt = 0;
+    int winner = -1;
+    int geeseTile = -1;
+    bool hasLoadedDice = true; // Current builder's, before the action
+    FixedVector<int, NUM_BUILDERS> stealCandidates;
+    RandomEngine rng{0};
+};
+
+/**
+ * Headless rules engine: owns the Board and Builders and advances the game one typed Action at a time.
+ * Nothing here reads from or writes to a stream; front ends (e.g. the console Game) translate their
+ * input into Actions and render the returned ActionResult.
+ *
+ * Turns are an explicit TurnPhase state machine rather than a chain of calls, so the engine holds no
+ * state on the call stack and may be paused between any two actions (e.g. to interleave many games).
+ */
+class Engine final {
+  private:
+    std::unique_ptr<Board> board;
+    std::vector<std::unique_ptr<Builder>> builders;
+    int currentBuilder; // Index of current builder in builders
+    TurnPhase phase;
+    int initialResidencesBuilt; // Progress through the snake draft of initial basements
+    int winner;                 // Raised by the build that takes a builder to POINTS_TO_WIN, so nobody polls for it
+    std::vector<int> stealCandidates; // Builders the current builder may steal from after moving the geese
+    ActionResult result; // Reused between actions so that its event buffer is only allocated once
+    RandomEngine rng;     // This game's own random stream, used for fair dice and geese discards
+    bool recordingUndo = false;
+    std::vector<UndoRecord> undoJournal; // Most recent action last
+
+    Resource drawRandomResource(const ResourceBundle&);
+    ResourceBundle drawRandomResources(ResourceBundle, int);
+
+    bool acceptsAction(ActionType) const;
+    void discardToGeese();
+
+    ActionStatus setDice(bool);
+    ActionStatus roll(int);
+    ActionStatus build(ActionType, int);
+    ActionStatus trade(int, const Trade&);
+    ActionStatus moveGeese(int);
+    ActionStatus steal(int);
+    ActionStatus endTurn();
+
+    void addEvent(EventType, int, int, Resource, int);
+
+  public:
+    static const int NUM_BUILDERS = 4;
+    static const int POINTS_TO_WIN = 10;
+
+    Engine(std::vector<TileInitData>, RandomEngine);
+    Engine(std::vector<TileInitData>, std::vector<BuilderResourceData>, std::vector<BuilderStructureData>, int currentBuilder, int geeseTile, RandomEngine);
+    Engine(const Engine&); // Independent copy, including the random stream; shares nothing with the original
+    Engine& operator=(const Engine&) = delete;
+    ~Engine();
+
+    // Restoring only accepts snapshots of an engine playing on the same tiles
+    EngineSnapshot snapshot() const;
+    void restore(const EngineSnapshot&);
+
+    /**
+     * Make/unmake support for search: while enabled, every successful action is journalled so that undo()
+     * can reverse the most recent one in place, restoring the exact prior state (random stream included)
+     * in constant time. Disabling the journal, or restoring a snapshot, discards it.
+     */
+    void setUndoEnabled(bool);
+    bool canUndo() const;
+    void undo(); // Throws std::logic_error if there is nothing to undo
+
+    /**
+     * Replaces the contents of actions with every action the current builder may take that would succeed,
+     * apart from the roll value of a fair roll. Loaded dice offer each roll from 2 to 12, and trades are
+     * limited to one-for-one swaps with builders holding the resource asked for.
+     */
+    void generateLegalActions(LegalActions&) const;
+
+    // Applies action on behalf of the current builder; the returned reference is valid until the next call
+    const ActionResult& apply(const Action&);
+
+    int getCurrentBuilder() const;
+    const Builder& getBuilder(int) const;
+    const std::vector<const Builder*> getBuilders() const;
+    TurnPhase getPhase() const;
+    const std::vector<int>& getStealCandidates() const;
+    int getGeeseLocation() const;
+    const Board& getBoard() const;
+    int getWinner() const; // Builder number of the winner, or -1 if nobody has won yet
+
+    /**
+     * Zobrist hash of what a saved game records: tiles, structures, geese, whose turn it is and each builder's
+     * inventory, bucketed per resource (see Zobrist::INVENTORY_BUCKETS). Equal states hash equal however they
+     * were reached, including through a save and load; the turn phase, dice choice and random stream are left out.
+     * The board's share is kept up to date as it changes; the rest is a fixed 21 keys per call.
+     */
+    uint64_t stateHash() const;
+};
+
+#endif
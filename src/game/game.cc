@@ -1,45 +1,35 @@
 #include "game.h"
 #include "../board/edge.h"
-#include "../common/inventoryupdate.h"
 #include "../common/randomengine.h"
 #include "../structures/residence.h"
 #include "../structures/road.h"
 #include "builder.h"
-#include <fstream>
-#include <map>
+#include "commandreader.h"
+#include "outputsink.h"
+#include "savefile.h"
+#include <array>
 
-Game::Game() : currentBuilder{0} {
-    board = std::make_unique<Board>(generateRandomBoard());
+Game::Game(std::vector<TileInitData> data, RandomEngine rng) : engine{data, rng} {}
 
-    builders.push_back(std::make_unique<Builder>(0, 'B'));
-    builders.push_back(std::make_unique<Builder>(1, 'R'));
-    builders.push_back(std::make_unique<Builder>(2, 'O'));
-    builders.push_back(std::make_unique<Builder>(3, 'Y'));
-}
+Game::Game(std::vector<TileInitData> data, std::vector<BuilderResourceData> resourceData, std::vector<BuilderStructureData> structureData, int currentBuilder, int geeseTile, RandomEngine rng) : engine{data, resourceData, structureData, currentBuilder, geeseTile, rng} {}
 
-Game::Game(std::vector<TileInitData> data) : currentBuilder{0} {
-    board = std::make_unique<Board>(data);
+Game::Game(const Game& other) : engine{other.engine} {}
 
-    builders.push_back(std::make_unique<Builder>(0, 'B'));
-    builders.push_back(std::make_unique<Builder>(1, 'R'));
-    builders.push_back(std::make_unique<Builder>(2, 'O'));
-    builders.push_back(std::make_unique<Builder>(3, 'Y'));
-}
+Game::~Game() {}
 
-Game::Game(std::vector<TileInitData> data, std::vector<BuilderResourceData> resourceData, std::vector<BuilderStructureData> structureData, int currentBuilder, int geeseTile) : currentBuilder{currentBuilder} {
-    builders.push_back(std::make_unique<Builder>(0, 'B', resourceData[0]));
-    builders.push_back(std::make_unique<Builder>(1, 'R', resourceData[1]));
-    builders.push_back(std::make_unique<Builder>(2, 'O', resourceData[2]));
-    builders.push_back(std::make_unique<Builder>(3, 'Y', resourceData[3]));
+std::unique_ptr<Game> Game::clone() const {
+    return std::make_unique<Game>(*this);
+}
 
-    std::vector<std::pair<Builder*, BuilderStructureData>> structures = {{builders.at(0).get(), structureData.at(0)}, {builders.at(1).get(), structureData.at(1)}, {builders.at(2).get(), structureData.at(2)}, {builders.at(3).get(), structureData.at(3)}};
-    board = std::make_unique<Board>(data, structures);
-    board->setGeeseTile(geeseTile);
+EngineSnapshot Game::snapshot() const {
+    return engine.snapshot();
 }
 
-Game::~Game() {}
+void Game::restore(const EngineSnapshot& snapshot) {
+    engine.restore(snapshot);
+}
 
-std::vector<TileInitData> Game::generateRandomBoard() {
+std::vector<TileInitData> Game::generateRandomBoard(RandomEngine& rng) {
     std::vector<TileInitData> data;
     std::vector<int> tileValues = {2, 3, 3, 4, 4, 5, 5, 6, 6, 8, 8, 9, 9, 10, 10, 11, 11, 12};
     std::vector<Resource> resources;
@@ -51,7 +41,7 @@ std::vector<TileInitData> Game::generateRandomBoard() {
     resources.insert(resources.end(), 4, Resource::GLASS);
 
     // Shuffle resources
-    shuffle(resources.begin(), resources.end(), RandomEngine::getEngine());
+    rng.shuffle(resources.begin(), resources.end());
     for (int i = 0; i < 18; i++) {
         data.push_back(TileInitData{tileValues[i], resources[i]});
     }
@@ -60,445 +50,435 @@ std::vector<TileInitData> Game::generateRandomBoard() {
     data.push_back(TileInitData{7, Resource::PARK});
 
     // Reshuffle the geese tile back into the board
-    shuffle(data.begin(), data.end(), RandomEngine::getEngine());
+    rng.shuffle(data.begin(), data.end());
     return data;
 }
 
+uint64_t Game::stateHash() const {
+    return engine.stateHash();
+}
+
 int Game::getCurrentBuilder() const {
-    return currentBuilder;
+    return engine.getCurrentBuilder();
 }
 
 const std::vector<const Builder*> Game::getBuilders() const {
-    std::vector<const Builder*> builders;
-    for (const std::unique_ptr<Builder>& b : this->builders) {
-        builders.push_back(b.get());
-    }
-
-    return builders;
+    return engine.getBuilders();
 }
 
 int Game::getGeeseLocation() const {
-    return board->getGeeseTile();
+    return engine.getGeeseLocation();
 }
 
 const Board& Game::getBoard() const {
-    return *board;
+    return engine.getBoard();
 }
 
-Builder& Game::getBuilder(std::string colour) {
-    if (colour == "Blue") {
-        return *builders.at(0);
-    }
-    else if (colour == "Red") {
-        return *builders.at(1);
-    }
-    else if (colour == "Orange") {
-        return *builders.at(2);
-    }
-    else if (colour == "Yellow") {
-        return *builders.at(3);
+Engine& Game::getEngine() {
+    return engine;
+}
+
+int Game::getBuilderNumber(std::string_view colour) const {
+    for (int i = 0; i < NUM_BUILDERS; i++) {
+        if (engine.getBuilder(i).getBuilderColourString() == colour) {
+            return i;
+        }
     }
 
     throw std::invalid_argument("Invalid colour");
 }
 
-void Game::facilitateTrade(Builder& proposee, Trade trade, std::ostream& out) {
-    Builder& builder = *builders.at(currentBuilder);
-
-    if (builder.inventory[trade.resourceToGive] >= trade.numToGive && proposee.inventory[trade.resourceToTake] >= trade.numToTake) {
-        for (int i = 0; i < trade.numToGive; i++) {
-            builder.inventory[trade.resourceToGive]--;
-            proposee.inventory[trade.resourceToGive]++;
-        }
-        for (int i = 0; i < trade.numToTake; i++) {
-            builder.inventory[trade.resourceToTake]++;
-            proposee.inventory[trade.resourceToTake]--;
-        }
-        out << "Trade completed." << std::endl;
-    }
-    else if (builder.inventory[trade.resourceToGive] < trade.numToGive) {
-        out << "You do not have enough " << trade.resourceToGive << " to trade." << std::endl;
-    }
-    else if (proposee.inventory[trade.resourceToTake] < trade.numToTake) {
-        out << proposee.getBuilderColourString() << " does not have enough " << trade.resourceToTake << " to trade." << std::endl;
-    }
+const Builder& Game::getActiveBuilder() const {
+    return engine.getBuilder(engine.getCurrentBuilder());
 }
 
-void Game::buildInitialResidences(std::istream& in, std::ostream& out) {
-    int vertex;
+// Prints a "Builder <colour> gained:" style block for every builder affected by events of the given type
+void Game::printResourceChanges(const ActionResult& result, EventType type, OutputSink& sink) const {
+    if (sink.isSilent()) {
+        return;
+    }
 
-    // First round of building, in ascending order of builderNumber
+    std::ostream& out = sink.getStream();
     for (int i = 0; i < NUM_BUILDERS; i++) {
-        out << "Builder " << builders[i]->getBuilderColourString() << ", where do you want to build a basement?" << std::endl;
-        in >> vertex;
+        int total = 0;
+        for (const GameEvent& event : result.events) {
+            if (event.type == type && event.builder == i) {
+                total += event.amount;
+            }
+        }
 
-        while (!board->buildInitialResidence(*builders[i], vertex, out)) {
-            out << "Builder " << builders[i]->getBuilderColourString() << ", where do you want to build a basement?" << std::endl;
-            in >> vertex;
+        if (total == 0) {
+            continue;
         }
-    }
 
-    // Second round of building, in descending order of builderNumber
-    for (int i = NUM_BUILDERS - 1; i >= 0; i--) {
-        out << "Builder " << builders[i]->getBuilderColourString() << ", where do you want to build a basement?" << std::endl;
-        in >> vertex;
+        if (type == EventType::RESOURCES_GAINED) {
+            out << "Builder " << engine.getBuilder(i).getBuilderColourString() << " gained:\n";
+        }
+        else {
+            out << "Builder " << engine.getBuilder(i).getBuilderColourString() << " loses " << total << " resources to the geese. They lose:\n";
+        }
 
-        while (!board->buildInitialResidence(*builders[i], vertex, out)) {
-            out << "Builder " << builders[i]->getBuilderColourString() << ", where do you want to build a basement?" << std::endl;
-            in >> vertex;
+        for (const GameEvent& event : result.events) {
+            if (event.type == type && event.builder == i) {
+                out << event.amount << " " << event.resource << '\n';
+            }
         }
     }
 }
 
-// "half" = true means discard half of total resources, "half" = false means steal just one
-std::vector<Resource> Game::discardRandomResource(Builder& builder, bool half) {
-    std::vector<Resource> builderResources;
-    for (auto const& resource : builder.inventory) {
-        for (int i = 0; i < resource.second; i++) {
-            builderResources.push_back(resource.first);
-        }
+// Prints whatever the current builder should be asked upon entering the current phase
+void Game::promptForPhase(OutputSink& sink) const {
+    if (sink.isSilent()) {
+        return;
     }
 
-    std::shuffle(builderResources.begin(), builderResources.end(), RandomEngine::getEngine());
-    std::vector<Resource> resourcesToDiscard;
-
-    if (half && builderResources.size() >= 10) { // discard half
-        for (size_t i = 0; i < builderResources.size() / 2; i++) {
-            resourcesToDiscard.push_back(builderResources[i]);
-        }
-    }
-    else if (!half) { // steal one
-        resourcesToDiscard.push_back(builderResources[0]);
+    const Builder& builder = getActiveBuilder();
+    std::ostream& out = sink.getStream();
+
+    switch (engine.getPhase()) {
+        case TurnPhase::INITIAL_PLACEMENT:
+            out << "Builder " << builder.getBuilderColourString() << ", where do you want to build a basement?\n";
+            break;
+        case TurnPhase::PRE_ROLL:
+            out << "Builder " << builder.getBuilderColourString() << "'s turn.\n";
+            out << builder.getStatus() << '\n';
+            break;
+        case TurnPhase::GEESE_PLACEMENT:
+            out << "Choose where to place the GEESE.\n";
+            break;
+        case TurnPhase::STEAL:
+            out << "Choose a builder to steal from.\n";
+            break;
+        default:
+            return;
     }
-
-    // An empty return vector means we tried to discard half when the builder had less than 10 resources
-    return resourcesToDiscard;
+    sink.prompt();
 }
 
-void Game::moveGeese(std::istream& in, std::ostream& out) {
-    Builder& builder = *builders.at(currentBuilder);
-
-    for (int i = 0; i < NUM_BUILDERS; i++) {
-        std::vector<Resource> discard = discardRandomResource(*builders[i], true);
-        std::map<Resource, int> discardNum;
-
-        if (discard.size() > 0) {
-            out << "Builder " << builders[i]->getBuilderColourString() << " loses " << discard.size() << " resources to the geese. They lose:" << std::endl;
+bool Game::placeInitialResidence(CommandReader& reader, OutputSink& sink) {
+    int vertex;
+    if (!reader.readInt(vertex)) {
+        return false;
+    }
 
-            for (size_t j = 0; j < discard.size(); j++) {
-                builders[i]->inventory[discard[j]]--;
-                discardNum[discard[j]]++;
-            }
+    // The engine walks builders through the snake draft (ascending, then descending builderNumber)
+    const ActionResult& result = engine.apply(Action{ActionType::BUILD_INITIAL_RESIDENCE, vertex});
+    Board::printBuildStatus(ActionType::BUILD_INITIAL_RESIDENCE, result.status, sink.getStream());
 
-            // print out discarded resources
-            for (auto const& resource : discardNum) {
-                out << resource.second << " " << resource.first << std::endl;
-            }
-        }
+    if (engine.getPhase() != TurnPhase::INITIAL_PLACEMENT && !sink.isSilent()) {
+        renderer.print(getBoard(), sink.getStream());
     }
+    promptForPhase(sink);
+    return true;
+}
 
+bool Game::moveGeese(CommandReader& reader, OutputSink& sink) {
     int tile;
-    out << "Choose where to place the GEESE." << std::endl;
-    in >> tile;
-    while (tile == getGeeseLocation()) {
-        out << "Choose somewhere else to place the GEESE." << std::endl;
-        in >> tile;
+    if (!reader.readInt(tile)) {
+        return false;
     }
 
-    board->setGeeseTile(tile);
+    std::ostream& out = sink.getStream();
+    if (engine.apply(Action{ActionType::MOVE_GEESE, tile}).status != ActionStatus::SUCCESS) {
+        out << "Choose somewhere else to place the GEESE.\n";
+        sink.prompt();
+        return true;
+    }
 
-    AbstractTile* t = board->getTile(tile);
-    std::vector<int> neighbouringBuilders = t->getStealCandidates(builder);
+    const Builder& builder = getActiveBuilder();
+    const std::vector<int>& neighbouringBuilders = engine.getStealCandidates();
 
     if (neighbouringBuilders.size() == 0) {
-        out << "Builder " << builder.getBuilderColourString() << " has no builders to steal from." << std::endl;
-        return;
+        out << "Builder " << builder.getBuilderColourString() << " has no builders to steal from.\n";
+        return true;
     }
     else{
         out << "Builder " << builder.getBuilderColourString() << " can choose to steal from:";
     }
 
     for (size_t i = 0; i < neighbouringBuilders.size() - 1; i++) {
-        out << " " << builders[neighbouringBuilders[i]]->getBuilderColourString() << ",";
+        out << " " << engine.getBuilder(neighbouringBuilders[i]).getBuilderColourString() << ",";
     }
-    out << " " << builders[neighbouringBuilders[neighbouringBuilders.size() - 1]]->getBuilderColourString() << std::endl;
+    out << " " << engine.getBuilder(neighbouringBuilders[neighbouringBuilders.size() - 1]).getBuilderColourString() << '\n';
 
-    out << "Choose a builder to steal from." << std::endl;
+    promptForPhase(sink);
+    return true;
+}
+
+bool Game::stealResource(CommandReader& reader, OutputSink& sink) {
+    std::string_view builderToStealFromColour;
+    if (!reader.readWord(builderToStealFromColour)) {
+        return false;
+    }
 
-    std::string builderToStealFromColour;
-    in >> builderToStealFromColour;
-    Builder& builderToStealFrom = getBuilder(builderToStealFromColour);
+    const ActionResult& result = engine.apply(Action{ActionType::STEAL, getBuilderNumber(builderToStealFromColour)});
+    if (result.status != ActionStatus::SUCCESS) {
+        promptForPhase(sink);
+        return true;
+    }
 
-    Resource resourceToSteal = discardRandomResource(builderToStealFrom, false)[0];
-    builder.inventory[resourceToSteal]++;
-    builderToStealFrom.inventory[resourceToSteal]--;
-    out << "Builder " << builder.getBuilderColourString() << " steals " << resourceToString(resourceToSteal) << " from builder " << builderToStealFrom.getBuilderColourString() << std::endl;
+    const GameEvent& stolen = result.events.front();
+    sink.getStream() << "Builder " << getActiveBuilder().getBuilderColourString() << " steals " << resourceToString(stolen.resource) << " from builder " << engine.getBuilder(stolen.target).getBuilderColourString() << '\n';
+    return true;
 }
 
+// Files ending in SaveFile::BINARY_EXTENSION are saved in the binary format, anything else as text
 void Game::save(std::string filename) {
-    std::ofstream outputFile{filename};
-    outputFile << getCurrentBuilder() << std::endl;
+    SaveFile::write(filename, SaveFile::fromEngine(engine));
+}
 
-    for (const Builder* b : getBuilders()) {
-        // Resource inventory
-        outputFile << b->inventory.at(Resource::BRICK) << " " << b->inventory.at(Resource::ENERGY) << " " << b->inventory.at(Resource::GLASS) << " " << b->inventory.at(Resource::HEAT) << " " << b->inventory.at(Resource::WIFI) << " ";
+bool Game::loadDice(CommandReader&, OutputSink&) {
+    engine.apply(Action{ActionType::LOAD_DICE});
+    return true;
+}
 
-        // Roads
-        outputFile << "r";
-        for (const std::shared_ptr<Road>& r : b->roads) {
-            outputFile << " " << r->getLocation().getEdgeNumber();
-        }
+bool Game::fairDice(CommandReader&, OutputSink&) {
+    engine.apply(Action{ActionType::FAIR_DICE});
+    return true;
+}
+
+bool Game::roll(CommandReader& reader, OutputSink& sink) {
+    const Builder& builder = getActiveBuilder();
+    std::ostream& out = sink.getStream();
+    int loaded = 0;
 
-        // Residences
-        outputFile << " h";
-        for (const std::shared_ptr<Residence>& h : b->residences) {
-            outputFile << " " << h->getLocation().getVertexNumber() << " " << h->getResidenceLetter();
+    if (builder.getHasLoadedDice()) {
+        while (loaded < 2 || loaded > 12) {
+            out << "Input a roll between 2 and 12:\n";
+            sink.prompt();
+            if (!reader.readInt(loaded)) {
+                return false;
+            }
+            if (loaded < 2 || loaded > 12) {
+                out << "Invalid roll.\n";
+            }
         }
+    }
 
-        outputFile << std::endl;
+    const ActionResult& result = engine.apply(Action{ActionType::ROLL, loaded});
+    int roll = result.events.front().amount;
+    out << "Builder " << builder.getBuilderColourString() << " rolled " << roll << '\n';
+
+    if (roll == 7) {
+        printResourceChanges(result, EventType::RESOURCES_DISCARDED, sink);
+    }
+    else if (result.events.size() == 1) {
+        out << "No builder gained resources.\n";
     }
+    else {
+        printResourceChanges(result, EventType::RESOURCES_GAINED, sink);
+    }
+    promptForPhase(sink);
+    return true;
+}
 
-    for (int i = 0; i < Board::NUM_TILES - 1; i++) {
-        outputFile << static_cast<int>(getBoard().getTile(i)->getResource()) << " " << getBoard().getTile(i)->getTileValue() << " ";
+bool Game::printBoard(CommandReader&, OutputSink& sink) {
+    if (!sink.isSilent()) {
+        renderer.print(getBoard(), sink.getStream());
     }
+    return true;
+}
 
-    outputFile << (int)(getBoard().getTile(Board::NUM_TILES - 1)->getResource()) << " " << getBoard().getTile(Board::NUM_TILES - 1)->getTileValue() << std::endl;
-    outputFile << getGeeseLocation() << std::endl;
-    outputFile.close();
+bool Game::printStatus(CommandReader&, OutputSink& sink) {
+    if (sink.isSilent()) {
+        return true;
+    }
+    for (const Builder* b : getBuilders()) {
+        sink.getStream() << b->getStatus() << '\n';
+    }
+    return true;
 }
 
-void Game::beginTurn(std::istream& in, std::ostream& out) {
-    Builder& builder = *builders.at(currentBuilder);
-    std::string command;
-    int roll;
-    int loaded = 0;
+bool Game::printResidences(CommandReader&, OutputSink& sink) {
+    if (sink.isSilent()) {
+        return true;
+    }
+    const Builder& builder = getActiveBuilder();
+    std::ostream& out = sink.getStream();
+    out << "Builder " << builder.getBuilderColourString() << " has built:\n";
+    for (int vertex : builder.residences) {
+        out << vertex << " " << getBoard().getVertex(vertex)->getResidence().getResidenceLetter() << '\n';
+    }
+    return true;
+}
 
-    out << "Builder " << builder.getBuilderColourString() << "'s turn." << std::endl;
-    out << builder.getStatus() << std::endl;
+bool Game::buildRoad(CommandReader& reader, OutputSink& sink) {
+    int edge;
+    if (!reader.readInt(edge)) {
+        return false;
+    }
+    Board::printBuildStatus(ActionType::BUILD_ROAD, engine.apply(Action{ActionType::BUILD_ROAD, edge}).status, sink.getStream());
+    return true;
+}
 
-    while (in >> command) {
-        if (command == "load") {
-            builder.setDice(true);
-        }
-        else if (command == "fair") {
-            builder.setDice(false);
-        }
-        else if (command == "roll") {
-            if (builder.getHasLoadedDice()) {
-                while (loaded < 2 || loaded > 12) {
-                    out << "Input a roll between 2 and 12:" << std::endl;
-                    in >> loaded;
-                    if (loaded < 2 || loaded > 12) {
-                        out << "Invalid roll." << std::endl;
-                    }
-                }
-            }
+bool Game::buildResidence(CommandReader& reader, OutputSink& sink) {
+    int vertex;
+    if (!reader.readInt(vertex)) {
+        return false;
+    }
+    Board::printBuildStatus(ActionType::BUILD_RESIDENCE, engine.apply(Action{ActionType::BUILD_RESIDENCE, vertex}).status, sink.getStream());
+    return true;
+}
 
-            roll = builder.rollDice(loaded);
-            out << "Builder " << builder.getBuilderColourString() << " rolled " << roll << std::endl;
+bool Game::improve(CommandReader& reader, OutputSink& sink) {
+    int vertex;
+    if (!reader.readInt(vertex)) {
+        return false;
+    }
+    Board::printBuildStatus(ActionType::IMPROVE, engine.apply(Action{ActionType::IMPROVE, vertex}).status, sink.getStream());
+    return true;
+}
 
-            if (roll == 7) {
-                moveGeese(in, out);
-            }
-            else { // distribute resources
-                BuilderInventoryUpdate b = board->getResourcesFromDiceRoll(roll);
-
-                if (!b.changed()) {
-                    out << "No builder gained resources." << std::endl;
-                }
-                else {
-                    // Output resources gained
-                    if (b.builder1Inventory.at(Resource::BRICK) > 0 || b.builder1Inventory.at(Resource::ENERGY) > 0 || b.builder1Inventory.at(Resource::GLASS) > 0 || b.builder1Inventory.at(Resource::HEAT) > 0 || b.builder1Inventory.at(Resource::WIFI) > 0) {
-                        out << "Builder " << builders.at(0)->getBuilderColourString() << " gained:" << std::endl;
-                        if (b.builder1Inventory.at(Resource::BRICK) > 0) {
-                            out << b.builder1Inventory.at(Resource::BRICK) << " BRICK" << std::endl;
-                        }
-                        if (b.builder1Inventory.at(Resource::ENERGY) > 0) {
-                            out << b.builder1Inventory.at(Resource::ENERGY) << " ENERGY" << std::endl;
-                        }
-                        if (b.builder1Inventory.at(Resource::GLASS) > 0) {
-                            out << b.builder1Inventory.at(Resource::GLASS) << " GLASS" << std::endl;
-                        }
-                        if (b.builder1Inventory.at(Resource::HEAT) > 0) {
-                            out << b.builder1Inventory.at(Resource::HEAT) << " HEAT" << std::endl;
-                        }
-                        if (b.builder1Inventory.at(Resource::WIFI) > 0) {
-                            out << b.builder1Inventory.at(Resource::WIFI) << " WIFI" << std::endl;
-                        }
-                    }
-
-                    if (b.builder2Inventory.at(Resource::BRICK) > 0 || b.builder2Inventory.at(Resource::ENERGY) > 0 || b.builder2Inventory.at(Resource::GLASS) > 0 || b.builder2Inventory.at(Resource::HEAT) > 0 || b.builder2Inventory.at(Resource::WIFI) > 0) {
-                        out << "Builder " << builders.at(1)->getBuilderColourString() << " gained:" << std::endl;
-                        if (b.builder2Inventory.at(Resource::BRICK) > 0) {
-                            out << b.builder2Inventory.at(Resource::BRICK) << " BRICK" << std::endl;
-                        }
-                        if (b.builder2Inventory.at(Resource::ENERGY) > 0) {
-                            out << b.builder2Inventory.at(Resource::ENERGY) << " ENERGY" << std::endl;
-                        }
-                        if (b.builder2Inventory.at(Resource::GLASS) > 0) {
-                            out << b.builder2Inventory.at(Resource::GLASS) << " GLASS" << std::endl;
-                        }
-                        if (b.builder2Inventory.at(Resource::HEAT) > 0) {
-                            out << b.builder2Inventory.at(Resource::HEAT) << " HEAT" << std::endl;
-                        }
-                        if (b.builder2Inventory.at(Resource::WIFI) > 0) {
-                            out << b.builder2Inventory.at(Resource::WIFI) << " WIFI" << std::endl;
-                        }
-                    }
-
-                    if (b.builder3Inventory.at(Resource::BRICK) > 0 || b.builder3Inventory.at(Resource::ENERGY) > 0 || b.builder3Inventory.at(Resource::GLASS) > 0 || b.builder3Inventory.at(Resource::HEAT) > 0 || b.builder3Inventory.at(Resource::WIFI) > 0) {
-                        out << "Builder " << builders.at(2)->getBuilderColourString() << " gained:" << std::endl;
-                        if (b.builder3Inventory.at(Resource::BRICK) > 0) {
-                            out << b.builder3Inventory.at(Resource::BRICK) << " BRICK" << std::endl;
-                        }
-                        if (b.builder3Inventory.at(Resource::ENERGY) > 0) {
-                            out << b.builder3Inventory.at(Resource::ENERGY) << " ENERGY" << std::endl;
-                        }
-                        if (b.builder3Inventory.at(Resource::GLASS) > 0) {
-                            out << b.builder3Inventory.at(Resource::GLASS) << " GLASS" << std::endl;
-                        }
-                        if (b.builder3Inventory.at(Resource::HEAT) > 0) {
-                            out << b.builder3Inventory.at(Resource::HEAT) << " HEAT" << std::endl;
-                        }
-                        if (b.builder3Inventory.at(Resource::WIFI) > 0) {
-                            out << b.builder3Inventory.at(Resource::WIFI) << " WIFI" << std::endl;
-                        }
-                    }
-
-                    if (b.builder4Inventory.at(Resource::BRICK) > 0 || b.builder4Inventory.at(Resource::ENERGY) > 0 || b.builder4Inventory.at(Resource::GLASS) > 0 || b.builder4Inventory.at(Resource::HEAT) > 0 || b.builder4Inventory.at(Resource::WIFI) > 0) {
-                        out << "Builder " << builders.at(3)->getBuilderColourString() << " gained:" << std::endl;
-                        if (b.builder4Inventory.at(Resource::BRICK) > 0) {
-                            out << b.builder4Inventory.at(Resource::BRICK) << " BRICK" << std::endl;
-                        }
-                        if (b.builder4Inventory.at(Resource::ENERGY) > 0) {
-                            out << b.builder4Inventory.at(Resource::ENERGY) << " ENERGY" << std::endl;
-                        }
-                        if (b.builder4Inventory.at(Resource::GLASS) > 0) {
-                            out << b.builder4Inventory.at(Resource::GLASS) << " GLASS" << std::endl;
-                        }
-                        if (b.builder4Inventory.at(Resource::HEAT) > 0) {
-                            out << b.builder4Inventory.at(Resource::HEAT) << " HEAT" << std::endl;
-                        }
-                        if (b.builder4Inventory.at(Resource::WIFI) > 0) {
-                            out << b.builder4Inventory.at(Resource::WIFI) << " WIFI" << std::endl;
-                        }
-                    }
-                }
-            }
-            duringTurn(in, out);
-            return;
-        }
-        else {
-            out << "Invalid command." << std::endl;
+bool Game::trade(CommandReader& reader, OutputSink& sink) {
+    std::string_view word;
+    int numGive;
+    int numTake;
+
+    // Each word is copied out before the next read reuses the reader's buffer
+    if (!reader.readWord(word)) {
+        return false;
+    }
+    std::string proposeeColour{word};
+    if (!reader.readInt(numGive) || !reader.readWord(word)) {
+        return false;
+    }
+    std::string give{word};
+    if (!reader.readInt(numTake) || !reader.readWord(word)) {
+        return false;
+    }
+    std::string take{word};
+
+    // The proposee's answer is read straight from the stream, so the question is flushed by respondToTrade
+    std::ostream& out = sink.getStream();
+    const Builder& builder = getActiveBuilder();
+    Trade trade = builder.proposeTrade(proposeeColour, numGive, give, numTake, take, out);
+    int proposee = getBuilderNumber(trade.proposeeColour);
+    if (engine.getBuilder(proposee).respondToTrade(reader.getStream(), out)) {
+        switch (engine.apply(Action{ActionType::TRADE, proposee, trade}).status) {
+            case ActionStatus::SUCCESS:
+                out << "Trade completed.\n";
+                break;
+            case ActionStatus::INSUFFICIENT_RESOURCES:
+                out << "You do not have enough " << trade.resourceToGive << " to trade.\n";
+                break;
+            case ActionStatus::INVALID_AMOUNT:
+                out << "You must trade at least one of each resource.\n";
+                break;
+            default:
+                out << trade.proposeeColour << " does not have enough " << trade.resourceToTake << " to trade.\n";
+                break;
         }
     }
+    return true;
 }
 
-void Game::duringTurn(std::istream& in, std::ostream& out) {
-    std::string command;
+bool Game::endTurn(CommandReader&, OutputSink& sink) {
+    engine.apply(Action{ActionType::END_TURN});
+    promptForPhase(sink);
+    return true;
+}
 
-    while (builders[0]->getBuildingPoints() < 10 && builders[1]->getBuildingPoints() < 10 && builders[2]->getBuildingPoints() < 10 && builders[3]->getBuildingPoints() < 10 && in >> command) {
-        Builder& builder = *builders.at(currentBuilder);
+bool Game::saveGame(CommandReader& reader, OutputSink&) {
+    std::string_view fileName;
+    if (!reader.readWord(fileName)) {
+        return false;
+    }
+    save(std::string{fileName});
+    return true;
+}
 
-        if (command == "board") {
-            board->printBoard(out);
-        }
-        else if (command == "status") {
-            for (size_t i = 0; i < builders.size(); i++) {
-                out << builders[i]->getStatus() << std::endl;
-            }
-        }
-        else if (command == "residences") {
-            out << "Builder " << builder.getBuilderColourString() << " has built:" << std::endl;
-            for (size_t i = 0; i < builder.residences.size(); i++) {
-                out << std::to_string(builder.residences[i]->getLocation().getVertexNumber()) << " " << builder.residences[i]->getResidenceLetter() << std::endl;
-            }
-        }
-        else if (command.substr(0, 10) == "build-road") {
-            int edge;
-            in >> edge;
-            board->buildRoad(builder, edge, out);
-        }
-        else if (command.substr(0, 9) == "build-res") {
-            int vertex;
-            in >> vertex;
-            board->buildResidence(builder, vertex, out);
-        }
-        else if (command.substr(0, 7) == "improve") {
-            int vertex;
-            in >> vertex;
-            board->upgradeResidence(builder, vertex, out);
-        }
-        else if (command.substr(0, 5) == "trade") {
-            std::string proposeeColour;
-            in >> proposeeColour;
-            int numGive;
-            in >> numGive;
-            std::string give;
-            in >> give; 
-            int numTake;
-            in >> numTake;
-            std::string take;
-            in >> take;
-
-            Trade trade = builder.proposeTrade(proposeeColour, numGive, give, numTake, take, out);
-            Builder& proposee = getBuilder(proposeeColour);
-            if (proposee.respondToTrade(in, out)) {
-                facilitateTrade(proposee, trade, out);
-            }
-        }
-        else if (command == "next") {
-            nextTurn(in, out);
-            return;
-        }
-        else if (command.substr(0, 4) == "save") {
-            std::string fileName;
-            in >> fileName;
-            save(fileName);
-        }
-        else if (command == "help") {
-            out << std::endl;
-            out << "Valid commands:" << std::endl;
-            out << "board" << std::endl;
-            out << "status" << std::endl;
-            out << "residences" << std::endl;
-            out << "build-road <edge#>" << std::endl;
-            out << "build-res <housing#>" << std::endl;
-            out << "improve <housing#>" << std::endl;
-            out << "trade <colour> <give> <take>" << std::endl;
-            out << "next" << std::endl;
-            out << "save <file>" << std::endl;
-            out << "help" << std::endl;
-            out << std::endl;
-        }
-        else {
-            out << "Invalid command." << std::endl;
+bool Game::printHelp(CommandReader&, OutputSink& sink) {
+    sink.getStream() << "\n"
+                        "Valid commands:\n"
+                        "board\n"
+                        "status\n"
+                        "residences\n"
+                        "build-road <edge#>\n"
+                        "build-res <housing#>\n"
+                        "improve <housing#>\n"
+                        "trade <colour> <give> <take>\n"
+                        "next\n"
+                        "save <file>\n"
+                        "help\n"
+                        "\n";
+    return true;
+}
+
+bool Game::runCommand(CommandReader& reader, OutputSink& sink) {
+    // Every word command, with the phase that accepts it; compared length first, so most entries cost one integer comparison
+    static const std::array<Command, 13> commands = {{
+        {"load", false, TurnPhase::PRE_ROLL, &Game::loadDice},
+        {"fair", false, TurnPhase::PRE_ROLL, &Game::fairDice},
+        {"roll", false, TurnPhase::PRE_ROLL, &Game::roll},
+        {"board", false, TurnPhase::POST_ROLL, &Game::printBoard},
+        {"status", false, TurnPhase::POST_ROLL, &Game::printStatus},
+        {"residences", false, TurnPhase::POST_ROLL, &Game::printResidences},
+        {"build-road", true, TurnPhase::POST_ROLL, &Game::buildRoad},
+        {"build-res", true, TurnPhase::POST_ROLL, &Game::buildResidence},
+        {"improve", true, TurnPhase::POST_ROLL, &Game::improve},
+        {"trade", true, TurnPhase::POST_ROLL, &Game::trade},
+        {"next", false, TurnPhase::POST_ROLL, &Game::endTurn},
+        {"save", true, TurnPhase::POST_ROLL, &Game::saveGame},
+        {"help", false, TurnPhase::POST_ROLL, &Game::printHelp},
+    }};
+
+    std::string_view word;
+    if (!reader.readWord(word)) {
+        return false;
+    }
+
+    TurnPhase phase = engine.getPhase();
+    for (const Command& command : commands) {
+        bool matches = command.prefix ? word.substr(0, command.name.size()) == command.name : word == command.name;
+        if (matches && command.phase == phase) {
+            return (this->*command.handler)(reader, sink);
         }
     }
+
+    sink.getStream() << "Invalid command.\n";
+    return true;
 }
 
-void Game::nextTurn(std::istream& in, std::ostream& out) {
-    currentBuilder++;
-    if (currentBuilder == 4) {
-        currentBuilder = 0;
+bool Game::step(CommandReader& reader, OutputSink& sink) {
+    switch (engine.getPhase()) {
+        case TurnPhase::INITIAL_PLACEMENT:
+            return placeInitialResidence(reader, sink);
+        case TurnPhase::PRE_ROLL:
+        case TurnPhase::POST_ROLL:
+            return runCommand(reader, sink);
+        case TurnPhase::GEESE_PLACEMENT:
+            return moveGeese(reader, sink);
+        case TurnPhase::STEAL:
+            return stealResource(reader, sink);
+        default:
+            return false;
     }
-    beginTurn(in, out);
 }
 
-bool Game::play(std::istream& in, std::ostream& out, bool newGame) {
+// Reads and handles a single command for the current TurnPhase; returns false once input runs out
+bool Game::step(std::istream& in, OutputSink& sink) {
+    CommandReader reader{in};
+    return step(reader, sink);
+}
+
+bool Game::play(std::istream& in, OutputSink& sink, bool newGame) {
+    std::ostream& out = sink.getStream();
     if (newGame){
-        board->printBoard(out);
-        buildInitialResidences(in, out);
-        board->printBoard(out);
-        beginTurn(in, out);
+        if (!sink.isSilent()) {
+            renderer.print(getBoard(), out);
+        }
+        promptForPhase(sink);
     } else {
-        Builder& builder = *builders.at(currentBuilder);
-        out << "Builder " << builder.getBuilderColourString() << "'s turn." << std::endl;
-        duringTurn(in, out);    
+        out << "Builder " << getActiveBuilder().getBuilderColourString() << "'s turn.\n";
+        sink.prompt();
     }
-    if (builders[0]->getBuildingPoints() == 10 || builders[1]->getBuildingPoints() == 10 || builders[2]->getBuildingPoints() == 10 || builders[3]->getBuildingPoints() == 10) {
-        Builder& builder = *builders.at(currentBuilder);
-        out << "Player " << builder.getBuilderColourString() << " wins!" << std::endl;
+
+    CommandReader reader{in};
+    while (engine.getPhase() != TurnPhase::GAME_OVER && step(reader, sink)) {}
+
+    if (engine.getPhase() == TurnPhase::GAME_OVER) {
+        out << "Player " << engine.getBuilder(engine.getWinner()).getBuilderColourString() << " wins!\n";
+        sink.prompt();
         return true;
     }
     return false;
@@ -2,48 +2,93 @@
 #define GAME_H
 
 #include "../board/board.h"
+#include "../board/boardrenderer.h"
+#include "../common/action.h"
 #include "../common/forward.h"
 #include "../common/resource.h"
 #include "../common/trade.h"
 #include "builder.h"
+#include "engine.h"
 #include <algorithm>
 #include <chrono>
 #include <memory>
-#include <random>
+#include <string_view>
 #include <vector>
 
+// Console front end: reads commands from an istream, drives the Engine and narrates the results
 class Game final {
   private:
-    std::unique_ptr<Board> board;
-    std::vector<std::unique_ptr<Builder>> builders;
-    int currentBuilder; // Index of current builder in builders
+    Engine engine;
+    BoardRenderer renderer; // Reused for every redraw of the board
 
-    std::vector<TileInitData> generateRandomBoard();
+    // A word command typed by the current builder, and the phase in which it is accepted; prefix commands
+    // also accept any word that starts with their name
+    struct Command {
+        std::string_view name;
+        bool prefix;
+        TurnPhase phase;
+        bool (Game::*handler)(CommandReader&, OutputSink&);
+    };
 
-    Builder& getBuilder(std::string);
-    std::vector<Resource> discardRandomResource(Builder&, bool);
+    int getBuilderNumber(std::string_view) const;
+    const Builder& getActiveBuilder() const;
 
-    void beginTurn(std::istream&, std::ostream&);
-    void duringTurn(std::istream&, std::ostream&);
-    void buildInitialResidences(std::istream&, std::ostream&);
-    void moveGeese(std::istream&, std::ostream&);
-    void facilitateTrade(Builder&, Trade, std::ostream&);
-    void nextTurn(std::istream&, std::ostream&);
+    void printResourceChanges(const ActionResult&, EventType, OutputSink&) const;
+
+    void promptForPhase(OutputSink&) const;
+
+    // Each handles a single command, returning false once input runs out
+    bool placeInitialResidence(CommandReader&, OutputSink&);
+    bool moveGeese(CommandReader&, OutputSink&);
+    bool stealResource(CommandReader&, OutputSink&);
+
+    // Word commands, looked up in the table in runCommand
+    bool runCommand(CommandReader&, OutputSink&);
+    bool loadDice(CommandReader&, OutputSink&);
+    bool fairDice(CommandReader&, OutputSink&);
+    bool roll(CommandReader&, OutputSink&);
+    bool printBoard(CommandReader&, OutputSink&);
+    bool printStatus(CommandReader&, OutputSink&);
+    bool printResidences(CommandReader&, OutputSink&);
+    bool buildRoad(CommandReader&, OutputSink&);
+    bool buildResidence(CommandReader&, OutputSink&);
+    bool improve(CommandReader&, OutputSink&);
+    bool trade(CommandReader&, OutputSink&);
+    bool endTurn(CommandReader&, OutputSink&);
+    bool saveGame(CommandReader&, OutputSink&);
+    bool printHelp(CommandReader&, OutputSink&);
+
+    bool step(CommandReader&, OutputSink&);
 
   public:
-    static const int NUM_BUILDERS = 4;
+    static const int NUM_BUILDERS = Engine::NUM_BUILDERS;
 
-    Game();
-    Game(std::vector<TileInitData>);
-    Game(std::vector<TileInitData>, std::vector<BuilderResourceData>, std::vector<BuilderStructureData>, int currentBuilder, int GeeseTile);
+    static std::vector<TileInitData> generateRandomBoard(RandomEngine&);
+
+    Game(std::vector<TileInitData>, RandomEngine);
+    Game(std::vector<TileInitData>, std::vector<BuilderResourceData>, std::vector<BuilderStructureData>, int currentBuilder, int GeeseTile, RandomEngine);
+    Game(const Game&);
+    Game& operator=(const Game&) = delete;
     ~Game();
 
+    // Independent copy for tree search and what-if analysis; moves made on it never touch this game
+    std::unique_ptr<Game> clone() const;
+
+    // Cheap save points for trying out moves on this game and rewinding them
+    EngineSnapshot snapshot() const;
+    void restore(const EngineSnapshot&);
+
+    uint64_t stateHash() const; // See Engine::stateHash
+
     int getCurrentBuilder() const;
     const std::vector<const Builder*> getBuilders() const;
     int getGeeseLocation() const;
     const Board& getBoard() const;
+    Engine& getEngine();
 
-    bool play(std::istream&, std::ostream&, bool);
+    // Output goes to the given sink; see ConsoleSink, NullSink and CaptureSink
+    bool step(std::istream&, OutputSink&);
+    bool play(std::istream&, OutputSink&, bool);
     void save(std::string);
 };
 
@@ -4,65 +4,29 @@
 #include "../structures/road.h"
 #include "builder.h"
 #include "game.h"
+#include "savefile.h"
 #include <fstream>
-#include <sstream>
 
-GameFactory::GameFactory() {}
+GameFactory::GameFactory(uint64_t seed) : seed{seed}, gamesCreated{0} {}
 
 GameFactory::~GameFactory() {}
 
+RandomEngine GameFactory::nextStream() {
+    return RandomEngine{seed, gamesCreated++};
+}
+
 std::unique_ptr<Game> GameFactory::loadFromGame(std::string filename) {
-    std::vector<TileInitData> tileData;
+    SaveData data = SaveFile::read(filename);
+
     std::vector<BuilderResourceData> builderResourceData;
     std::vector<BuilderStructureData> builderStructureData;
-
-    std::string currentBuilder; // builderNumber as a string
-    std::ifstream dataFile{filename};
-    getline(dataFile, currentBuilder);
-
-    // Builder status
-    std::string line;
-    for (int i = 0; i < Game::NUM_BUILDERS; i++) {
-        getline(dataFile, line);
-        std::istringstream ss{line};
-
-        int brickNum, energyNum, glassNum, heatNum, wifiNum;
-        ss >> brickNum >> energyNum >> glassNum >> heatNum >> wifiNum;
-        builderResourceData.push_back(BuilderResourceData{brickNum, energyNum, glassNum, heatNum, wifiNum});
-
-        std::string token;
-        ss >> token; // ignore one token, should be 'r'
-        std::vector<int> roads;
-        ss >> token;
-        while (token != "h") {
-            roads.push_back(std::stoi(token));
-            ss >> token;
-        }
-
-        std::vector<std::pair<int, char>> residences;
-        int vertexNum;
-        char residenceType;
-
-        while (ss >> vertexNum >> residenceType) {
-            residences.emplace_back(vertexNum, residenceType);
-        }
-
-        builderStructureData.emplace_back(residences, roads);
-    }
-
-    // Resource layout
-    getline(dataFile, line);
-    std::istringstream ss{line};
-    Resource resource;
-    int tileValue;
-    while (ss >> resource >> tileValue) {
-        tileData.push_back(TileInitData{tileValue, resource});
+    for (const SavedBuilder& b : data.builders) {
+        builderResourceData.push_back(BuilderResourceData{b.resources[BRICK], b.resources[ENERGY], b.resources[GLASS], b.resources[HEAT], b.resources[WIFI]});
+        builderStructureData.emplace_back(std::vector<std::pair<int, char>>(b.residences.begin(), b.residences.end()), std::vector<int>(b.roads.begin(), b.roads.end()));
     }
+    std::vector<TileInitData> tileData(data.tiles.begin(), data.tiles.end());
 
-    int geeseTile;
-    dataFile >> geeseTile;
-    dataFile.close();
-    return std::make_unique<Game>(tileData, builderResourceData, builderStructureData, std::stoi(currentBuilder), geeseTile);
+    return std::make_unique<Game>(tileData, builderResourceData, builderStructureData, data.currentBuilder, data.geeseTile, nextStream());
 }
 
 std::unique_ptr<Game> GameFactory::loadFromBoard(std::string filename) {
@@ -76,9 +40,12 @@ std::unique_ptr<Game> GameFactory::loadFromBoard(std::string filename) {
     }
 
     dataFile.close();
-    return std::make_unique<Game>(data);
+    return std::make_unique<Game>(data, nextStream());
 }
 
 std::unique_ptr<Game> GameFactory::loadFromRandomBoard() {
-    return std::make_unique<Game>();
+    // The board is drawn from the same stream the game then plays with
+    RandomEngine rng = nextStream();
+    std::vector<TileInitData> data = Game::generateRandomBoard(rng);
+    return std::make_unique<Game>(data, rng);
 }
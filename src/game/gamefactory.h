@@ -2,16 +2,25 @@
 #define GAMEFACTORY_H
 
 #include "../common/forward.h"
+#include "../common/randomengine.h"
 #include "game.h"
+#include <cstdint>
 #include <memory>
 #include <string>
 
+// Every game created gets the next random stream derived from the factory's seed
 class GameFactory final {
+  private:
+    const uint64_t seed;
+    uint64_t gamesCreated;
+
+    RandomEngine nextStream();
+
   public:
-    GameFactory();
+    GameFactory(uint64_t seed);
     ~GameFactory();
 
-    std::unique_ptr<Game> loadFromGame(std::string);  // Pre-existing game data, which includes Builder turns, residences, points, etc.
+    std::unique_ptr<Game> loadFromGame(std::string);  // Pre-existing game data, which includes Builder turns, residences, points, etc. (text or binary)
     std::unique_ptr<Game> loadFromBoard(std::string); // Pre-existing board configuration, which only includes resource placement
     std::unique_ptr<Game> loadFromRandomBoard();      // Randomly generated board configuration
 };
@@ -0,0 +1,45 @@
+#include "outputsink.h"
+
+OutputSink::OutputSink() {}
+OutputSink::~OutputSink() {}
+
+bool OutputSink::isSilent() const {
+    return false;
+}
+
+void OutputSink::prompt() {}
+
+ConsoleSink::ConsoleSink(std::ostream& out) : out{out} {}
+ConsoleSink::~ConsoleSink() {
+    out.flush();
+}
+
+std::ostream& ConsoleSink::getStream() {
+    return out;
+}
+
+void ConsoleSink::prompt() {
+    out.flush();
+}
+
+NullSink::NullSink() : stream{nullptr} {}
+NullSink::~NullSink() {}
+
+std::ostream& NullSink::getStream() {
+    return stream;
+}
+
+bool NullSink::isSilent() const {
+    return true;
+}
+
+CaptureSink::CaptureSink() {}
+CaptureSink::~CaptureSink() {}
+
+std::ostream& CaptureSink::getStream() {
+    return stream;
+}
+
+std::string CaptureSink::getOutput() const {
+    return stream.str();
+}
@@ -0,0 +1,62 @@
+#ifndef OUTPUTSINK_H
+#define OUTPUTSINK_H
+
+#include <ostream>
+#include <sstream>
+#include <string>
+
+/**
+ * Destination for everything the console front end prints. Lines end in '\n' rather than std::endl,
+ * so the sink decides when output reaches its device: prompt() marks the point where a builder is
+ * about to be asked for input, and silent sinks let callers skip formatting altogether.
+ */
+class OutputSink {
+  public:
+    OutputSink();
+    virtual ~OutputSink();
+
+    virtual std::ostream& getStream() = 0;
+    virtual bool isSilent() const; // Nothing written is kept, so there is no point formatting it
+    virtual void prompt();         // A prompt has been written and input is about to be read
+};
+
+// Writes to a terminal or file stream, flushing only at prompts
+class ConsoleSink final : public OutputSink {
+  private:
+    std::ostream& out;
+
+  public:
+    explicit ConsoleSink(std::ostream&);
+    ~ConsoleSink();
+
+    std::ostream& getStream() override;
+    void prompt() override;
+};
+
+// Discards everything; for batch runs that only care about the final state of the game
+class NullSink final : public OutputSink {
+  private:
+    std::ostream stream; // Has no buffer, so anything written to it is dropped before being formatted
+
+  public:
+    NullSink();
+    ~NullSink();
+
+    std::ostream& getStream() override;
+    bool isSilent() const override;
+};
+
+// Keeps everything written in memory, for tests and headless replays
+class CaptureSink final : public OutputSink {
+  private:
+    std::ostringstream stream;
+
+  public:
+    CaptureSink();
+    ~CaptureSink();
+
+    std::ostream& getStream() override;
+    std::string getOutput() const;
+};
+
+#endif
@@ -0,0 +1,333 @@
+#include "savefile.h"
+#include "../board/abstracttile.h"
+#include "../board/edge.h"
+#include "../board/vertex.h"
+#include "../common/bitboard.h"
+#include "../structures/residence.h"
+#include "../structures/road.h"
+#include "engine.h"
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+const std::string SaveFile::BINARY_EXTENSION = ".svb";
+
+static const char BINARY_MAGIC[4] = {'C', 'T', 'S', 'V'};
+
+// Residence letters in the order their masks are stored
+static const char RESIDENCE_LETTERS[3] = {'B', 'H', 'T'};
+
+// Fills the build order slots that no structure takes
+static const char UNUSED_SLOT = static_cast<char>(0xFF);
+
+// Little-endian fixed-width field writers and readers; both are only called once the total size has been checked
+template <typename T>
+static void putInt(char*& out, T value) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::memcpy(out, &value, sizeof(T));
+#else
+    for (size_t i = 0; i < sizeof(T); i++) {
+        out[i] = static_cast<char>(value >> (8 * i));
+    }
+#endif
+    out += sizeof(T);
+}
+
+template <typename T>
+static T getInt(const char*& in) {
+    T value = 0;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::memcpy(&value, in, sizeof(T));
+#else
+    for (size_t i = 0; i < sizeof(T); i++) {
+        value |= static_cast<T>(static_cast<unsigned char>(in[i])) << (8 * i);
+    }
+#endif
+    in += sizeof(T);
+    return value;
+}
+
+SaveData SaveFile::fromEngine(const Engine& engine) {
+    SaveData data;
+    data.currentBuilder = engine.getCurrentBuilder();
+    data.geeseTile = engine.getGeeseLocation();
+
+    for (int i = 0; i < NUM_BUILDERS; i++) {
+        const Builder& b = engine.getBuilder(i);
+        SavedBuilder& saved = data.builders[i];
+        saved.resources = b.inventory;
+        for (int vertex : b.residences) {
+            saved.residences.emplace_back({vertex, engine.getBoard().getVertex(vertex)->getResidence().getResidenceLetter()});
+        }
+        for (int edge : b.roads) {
+            saved.roads.emplace_back(edge);
+        }
+    }
+
+    for (int i = 0; i < Board::NUM_TILES; i++) {
+        const AbstractTile* tile = engine.getBoard().getTile(i);
+        data.tiles.emplace_back(TileInitData{tile->getTileValue(), tile->getResource()});
+    }
+
+    return data;
+}
+
+void SaveFile::writeText(std::ostream& out, const SaveData& data) {
+    out << data.currentBuilder << std::endl;
+
+    for (const SavedBuilder& b : data.builders) {
+        // Resource inventory
+        out << b.resources[BRICK] << " " << b.resources[ENERGY] << " " << b.resources[GLASS] << " " << b.resources[HEAT] << " " << b.resources[WIFI] << " ";
+
+        // Roads
+        out << "r";
+        for (int edge : b.roads) {
+            out << " " << edge;
+        }
+
+        // Residences
+        out << " h";
+        for (const std::pair<int, char>& residence : b.residences) {
+            out << " " << residence.first << " " << residence.second;
+        }
+
+        out << std::endl;
+    }
+
+    for (size_t i = 0; i < data.tiles.size(); i++) {
+        out << static_cast<int>(data.tiles[i].resource) << " " << data.tiles[i].tileValue << (i + 1 < data.tiles.size() ? " " : "");
+    }
+    out << std::endl;
+    out << data.geeseTile << std::endl;
+}
+
+SaveData SaveFile::readText(std::istream& in) {
+    SaveData data;
+
+    std::string currentBuilder; // builderNumber as a string
+    getline(in, currentBuilder);
+    data.currentBuilder = std::stoi(currentBuilder);
+
+    // Builder status
+    std::string line;
+    for (SavedBuilder& b : data.builders) {
+        getline(in, line);
+        std::istringstream ss{line};
+
+        ss >> b.resources[BRICK] >> b.resources[ENERGY] >> b.resources[GLASS] >> b.resources[HEAT] >> b.resources[WIFI];
+
+        std::string token;
+        ss >> token; // ignore one token, should be 'r'
+        ss >> token;
+        while (token != "h") {
+            b.roads.emplace_back(std::stoi(token));
+            ss >> token;
+        }
+
+        int vertexNum;
+        char residenceType;
+        while (ss >> vertexNum >> residenceType) {
+            b.residences.emplace_back({vertexNum, residenceType});
+        }
+    }
+
+    // Resource layout
+    getline(in, line);
+    std::istringstream ss{line};
+    Resource resource;
+    int tileValue;
+    while (ss >> resource >> tileValue) {
+        data.tiles.emplace_back(TileInitData{tileValue, resource});
+    }
+
+    in >> data.geeseTile;
+    return data;
+}
+
+std::string SaveFile::encodeBinary(const SaveData& data) {
+    if (data.tiles.size() != Board::NUM_TILES) {
+        throw std::invalid_argument("Binary saves need a complete board");
+    }
+
+    std::string bytes(BINARY_SIZE, '\0');
+    char* out = &bytes[0];
+
+    std::memcpy(out, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    out += sizeof(BINARY_MAGIC);
+    putInt<uint16_t>(out, BINARY_VERSION);
+    putInt<uint8_t>(out, data.currentBuilder);
+    putInt<uint8_t>(out, data.geeseTile);
+
+    // The build order lists every structure once, so no two builders may share one
+    EdgeMask allRoads;
+    VertexMask allResidences = 0;
+    for (const SavedBuilder& b : data.builders) {
+        for (int amount : b.resources.counts) {
+            if (amount < 0 || amount > UINT16_MAX) {
+                throw std::invalid_argument("Resource count does not fit the binary layout");
+            }
+            putInt<uint16_t>(out, amount);
+        }
+
+        EdgeMask roads;
+        for (int edge : b.roads) {
+            if (edge < 0 || edge >= Board::NUM_EDGES || allRoads.test(edge)) {
+                throw std::invalid_argument("Invalid or repeated road");
+            }
+            roads |= EdgeMask::bit(edge);
+            allRoads |= EdgeMask::bit(edge);
+        }
+        putInt<uint64_t>(out, roads.lo);
+        putInt<uint64_t>(out, roads.hi);
+
+        VertexMask residences[3] = {};
+        for (const std::pair<int, char>& residence : b.residences) {
+            int level = residence.second == 'B' ? 0 : residence.second == 'H' ? 1 : residence.second == 'T' ? 2 : -1;
+            if (level == -1 || residence.first < 0 || residence.first >= Board::NUM_VERTICES || (allResidences & vertexBit(residence.first))) {
+                throw std::invalid_argument("Invalid or repeated residence");
+            }
+            residences[level] |= vertexBit(residence.first);
+            allResidences |= vertexBit(residence.first);
+        }
+        for (VertexMask mask : residences) {
+            putInt<uint64_t>(out, mask);
+        }
+    }
+
+    // Unused order slots stay at UNUSED_SLOT
+    char* roadOrder = out;
+    char* residenceOrder = out + Board::NUM_EDGES;
+    std::memset(out, UNUSED_SLOT, ORDER_SIZE);
+    for (const SavedBuilder& b : data.builders) {
+        for (int edge : b.roads) {
+            putInt<uint8_t>(roadOrder, edge);
+        }
+        for (const std::pair<int, char>& residence : b.residences) {
+            putInt<uint8_t>(residenceOrder, residence.first);
+        }
+    }
+    out += ORDER_SIZE;
+
+    for (const TileInitData& tile : data.tiles) {
+        putInt<uint8_t>(out, tile.resource);
+        putInt<uint8_t>(out, tile.tileValue);
+    }
+
+    return bytes;
+}
+
+SaveData SaveFile::decodeBinary(const char* in, size_t size) {
+    if (size != BINARY_SIZE || std::memcmp(in, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+        throw std::invalid_argument("Not a binary save");
+    }
+    in += sizeof(BINARY_MAGIC);
+    if (getInt<uint16_t>(in) != BINARY_VERSION) {
+        throw std::invalid_argument("Unsupported binary save version");
+    }
+
+    SaveData data;
+    data.currentBuilder = getInt<uint8_t>(in);
+    data.geeseTile = getInt<uint8_t>(in);
+    if (data.currentBuilder >= NUM_BUILDERS || data.geeseTile >= Board::NUM_TILES) {
+        throw std::invalid_argument("Binary save is corrupt");
+    }
+
+    std::array<EdgeMask, NUM_BUILDERS> roads;
+    std::array<std::array<VertexMask, 3>, NUM_BUILDERS> residences;
+    EdgeMask allRoads;
+    VertexMask allResidences = 0;
+    for (int i = 0; i < NUM_BUILDERS; i++) {
+        for (int& amount : data.builders[i].resources.counts) {
+            amount = getInt<uint16_t>(in);
+        }
+
+        roads[i] = EdgeMask{getInt<uint64_t>(in), getInt<uint64_t>(in)};
+        for (VertexMask& mask : residences[i]) {
+            mask = getInt<uint64_t>(in);
+        }
+        VertexMask anyResidence = residences[i][0] | residences[i][1] | residences[i][2];
+        bool overlapping = (residences[i][0] & residences[i][1]) || (residences[i][0] & residences[i][2]) || (residences[i][1] & residences[i][2]);
+        if ((roads[i].hi >> (Board::NUM_EDGES - 64)) != 0 || (anyResidence >> Board::NUM_VERTICES) != 0 || overlapping || (allRoads & roads[i]).any() || (allResidences & anyResidence)) {
+            throw std::invalid_argument("Binary save is corrupt");
+        }
+        allRoads |= roads[i];
+        allResidences |= anyResidence;
+    }
+
+    // Each builder's structures in build order; every one must be in their masks exactly once
+    const char* roadOrder = in;
+    const char* residenceOrder = in + Board::NUM_EDGES;
+    for (int i = 0; i < NUM_BUILDERS; i++) {
+        SavedBuilder& b = data.builders[i];
+        for (int count = __builtin_popcountll(roads[i].lo) + __builtin_popcountll(roads[i].hi); count > 0; count--) {
+            int edge = getInt<uint8_t>(roadOrder);
+            if (edge >= Board::NUM_EDGES || !roads[i].test(edge)) {
+                throw std::invalid_argument("Binary save is corrupt");
+            }
+            roads[i] &= ~EdgeMask::bit(edge);
+            b.roads.emplace_back(edge);
+        }
+
+        for (int count = __builtin_popcountll(residences[i][0] | residences[i][1] | residences[i][2]); count > 0; count--) {
+            int vertex = getInt<uint8_t>(residenceOrder);
+            int level = vertex >= Board::NUM_VERTICES ? -1 : residences[i][0] & vertexBit(vertex) ? 0 : residences[i][1] & vertexBit(vertex) ? 1 : residences[i][2] & vertexBit(vertex) ? 2 : -1;
+            if (level == -1) {
+                throw std::invalid_argument("Binary save is corrupt");
+            }
+            residences[i][level] &= ~vertexBit(vertex);
+            b.residences.emplace_back({vertex, RESIDENCE_LETTERS[level]});
+        }
+    }
+    for (; roadOrder < in + Board::NUM_EDGES; roadOrder++) {
+        if (*roadOrder != UNUSED_SLOT) {
+            throw std::invalid_argument("Binary save is corrupt");
+        }
+    }
+    for (; residenceOrder < in + ORDER_SIZE; residenceOrder++) {
+        if (*residenceOrder != UNUSED_SLOT) {
+            throw std::invalid_argument("Binary save is corrupt");
+        }
+    }
+    in += ORDER_SIZE;
+
+    for (int i = 0; i < Board::NUM_TILES; i++) {
+        uint64_t resource = getInt<uint8_t>(in);
+        int tileValue = getInt<uint8_t>(in);
+        if (resource > PARK || tileValue < 2 || tileValue > 12) {
+            throw std::invalid_argument("Binary save is corrupt");
+        }
+        data.tiles.emplace_back(TileInitData{tileValue, static_cast<Resource>(resource)});
+    }
+
+    return data;
+}
+
+void SaveFile::write(const std::string& filename, const SaveData& data) {
+    bool binary = filename.size() >= BINARY_EXTENSION.size() && filename.compare(filename.size() - BINARY_EXTENSION.size(), BINARY_EXTENSION.size(), BINARY_EXTENSION) == 0;
+    if (binary) {
+        std::ofstream file{filename, std::ios::binary};
+        std::string bytes = encodeBinary(data);
+        file.write(bytes.data(), bytes.size());
+    }
+    else {
+        std::ofstream file{filename};
+        writeText(file, data);
+    }
+}
+
+SaveData SaveFile::read(const std::string& filename) {
+    std::ifstream file{filename, std::ios::binary};
+
+    // Binary saves are read straight into a buffer one byte longer than the layout, so longer files are caught
+    std::array<char, BINARY_SIZE + 1> bytes;
+    file.read(bytes.data(), sizeof(BINARY_MAGIC));
+    if (file.gcount() == sizeof(BINARY_MAGIC) && std::memcmp(bytes.data(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0) {
+        file.read(bytes.data() + sizeof(BINARY_MAGIC), bytes.size() - sizeof(BINARY_MAGIC));
+        return decodeBinary(bytes.data(), sizeof(BINARY_MAGIC) + file.gcount());
+    }
+
+    file.clear();
+    file.seekg(0);
+    return readText(file);
+}
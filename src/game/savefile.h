@@ -0,0 +1,72 @@
+#ifndef SAVEFILE_H
+#define SAVEFILE_H
+
+#include "../board/board.h"
+#include "../common/fixedvector.h"
+#include "../common/forward.h"
+#include "../common/resourcebundle.h"
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+
+struct SavedBuilder {
+    ResourceBundle resources;
+    FixedVector<std::pair<int, char>, Board::NUM_VERTICES> residences; // Vertex and residence letter, in build order
+    FixedVector<int, Board::NUM_EDGES> roads;                          // Edge numbers, in build order
+};
+
+// Everything a saved game records; fixed-size so that decoding a save never allocates
+struct SaveData {
+    static const int NUM_BUILDERS = 4;
+
+    int currentBuilder = 0;
+    std::array<SavedBuilder, NUM_BUILDERS> builders{};
+    FixedVector<TileInitData, Board::NUM_TILES> tiles;
+    int geeseTile = 0;
+};
+
+/**
+ * Reads and writes saved games in two formats:
+ * - text (.sv and anything else): the original human-readable format, one builder per line
+ * - binary (.svb): a versioned, fixed-size little-endian snapshot, for loading large archives of positions
+ *
+ * Binary layout, BINARY_SIZE bytes in total:
+ *   header     "CTSV", uint16 version, uint8 current builder, uint8 geese tile
+ *   builders   per builder: 5 x uint16 resources, then uint64 words for roads (edges 0-63, 64-127),
+ *              basements, houses and towers (one bit per vertex)
+ *   order      one uint8 edge per road, builder 0's in build order and then each other builder's in turn,
+ *              padded with 0xFF to one slot per edge; then the same for residences by vertex
+ *   tiles      per tile: uint8 resource, uint8 tile value
+ * The masks say how many structures each builder owns, and no two builders may share one, so the order
+ * fits a slot per edge and vertex and saves load back in the order they were built.
+ */
+class SaveFile final {
+  private:
+    static const int NUM_BUILDERS = SaveData::NUM_BUILDERS;
+
+  public:
+    static constexpr uint16_t BINARY_VERSION = 2;
+    static constexpr size_t HEADER_SIZE = 8;
+    static constexpr size_t BUILDER_SIZE = 5 * 2 + 5 * 8;
+    static constexpr size_t ORDER_SIZE = Board::NUM_EDGES + Board::NUM_VERTICES;
+    static constexpr size_t TILE_SIZE = 2;
+    static constexpr size_t BINARY_SIZE = HEADER_SIZE + NUM_BUILDERS * BUILDER_SIZE + ORDER_SIZE + Board::NUM_TILES * TILE_SIZE;
+    static const std::string BINARY_EXTENSION;
+
+    static SaveData fromEngine(const Engine&);
+
+    static void writeText(std::ostream&, const SaveData&);
+    static SaveData readText(std::istream&);
+
+    // Binary decoding checks the size, header and every field's range, throwing std::invalid_argument on bad input
+    static std::string encodeBinary(const SaveData&);
+    static SaveData decodeBinary(const char*, size_t);
+
+    // Picks the format from the file name when writing, and from the file's header when reading
+    static void write(const std::string& filename, const SaveData&);
+    static SaveData read(const std::string& filename);
+};
+
+#endif
@@ -1,6 +1,6 @@
-#include "common/randomengine.h"
 #include "game/game.h"
 #include "game/gamefactory.h"
+#include "game/outputsink.h"
 #include <cassert>
 #include <chrono>
 #include <iostream>
@@ -35,17 +35,12 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    // Create the game
-    if (args["-seed"].empty()) {
-        RandomEngine::setSeed(1); //set to default to same 
-    }
-    else {
-        RandomEngine::setSeed(std::stoul(args["-seed"]));
-    }
-    GameFactory factory;
+    // Create the game; without a seed, every run plays out the same
+    GameFactory factory{args["-seed"].empty() ? 1 : std::stoull(args["-seed"])};
     std::unique_ptr<Game> game;
 
-    // Game loop
+    // Game loop; the console is only flushed when a builder is asked for input
+    ConsoleSink console{std::cout};
     bool newGame = true;
     while (true) {
         if (!args["-load"].empty()) {
@@ -63,13 +58,12 @@ int main(int argc, char* argv[]) {
             return 1;
         }
         // Play game, returns true if finished and false if unfinished
-        if (game->play(std::cin, std::cout, newGame)) {
+        if (game->play(std::cin, console, newGame)) {
             std::cout << "Would you like to play again?" << std::endl;
             std::string resp;
             while (std::cin >> resp) {
                 if (resp == "yes") {
-                    // Restart a new game with random configuration and new seed
-                    args["-seed"] = "";
+                    // Restart a new game with random configuration, which takes the factory's next random stream
                     args["-load"] = "";
                     args["-board"] = "";
                     args["-random-board"] = "T";
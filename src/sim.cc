@@ -0,0 +1,110 @@
+#include "game/boardgenerator.h"
+#include "sim/simulator.h"
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+int main(int argc, char* argv[]) {
+    std::unordered_map<std::string, std::string> args;
+
+    // Process the command-line arguments; every tag comes with a value
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-games" || arg == "-seed" || arg == "-threads" || arg == "-max-turns" || arg == "-players" || arg == "-boards") {
+            if (i + 1 < argc) {
+                args[arg] = argv[i + 1];
+                i++;
+            }
+            else {
+                std::cout << "Error: Missing value for " << arg << " tag." << std::endl;
+                return 1;
+            }
+        }
+        else {
+            std::cout << "Error: Unrecognized tag " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    SimulationConfig config;
+    int boards = 0;
+    try {
+        if (!args["-games"].empty()) {
+            config.games = std::stoi(args["-games"]);
+        }
+        if (!args["-seed"].empty()) {
+            config.seed = std::stoull(args["-seed"]);
+        }
+        if (!args["-threads"].empty()) {
+            config.threads = std::stoi(args["-threads"]);
+        }
+        if (!args["-max-turns"].empty()) {
+            config.maxTurns = std::stoi(args["-max-turns"]);
+        }
+        if (!args["-boards"].empty()) {
+            boards = std::stoi(args["-boards"]);
+        }
+    }
+    catch (const std::logic_error&) {
+        std::cout << "Error: Expected a number." << std::endl;
+        return 1;
+    }
+    if (config.games <= 0 || config.threads < 0 || config.maxTurns <= 0 || boards < 0) {
+        std::cout << "Error: -games and -max-turns must be positive, and -threads and -boards must not be negative." << std::endl;
+        return 1;
+    }
+
+    // Board generation mode: draw balanced boards instead of playing, and report how fast they come
+    if (boards > 0) {
+        try {
+            BoardGenerator generator;
+
+            auto start = std::chrono::steady_clock::now();
+            GeneratedBoards results = generator.generateMany(boards, config.seed, config.threads);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            std::cout << "Generated " << results.boards.size() << " boards on " << BoardGenerator::getThreadCount(config.threads, boards) << " threads in " << elapsed.count() << "s (" << boards / elapsed.count() << " boards/s, " << static_cast<double>(results.attempts) / boards << " draws per board)" << std::endl;
+        }
+        catch (const std::exception& e) {
+            std::cout << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // Players are given as a comma-separated list, one per seat
+    if (!args["-players"].empty()) {
+        std::istringstream players{args["-players"]};
+        std::string player;
+        int seat = 0;
+        while (std::getline(players, player, ',')) {
+            if (seat == SimulationConfig::NUM_SEATS) {
+                std::cout << "Error: Expected " << SimulationConfig::NUM_SEATS << " players." << std::endl;
+                return 1;
+            }
+            config.players[seat++] = player;
+        }
+        if (seat != SimulationConfig::NUM_SEATS) {
+            std::cout << "Error: Expected " << SimulationConfig::NUM_SEATS << " players." << std::endl;
+            return 1;
+        }
+    }
+
+    try {
+        Simulator simulator{config};
+
+        auto start = std::chrono::steady_clock::now();
+        SimulationResults results = simulator.run();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << "Simulated " << results.games << " games on " << simulator.getThreadCount() << " threads in " << elapsed.count() << "s (" << results.games / elapsed.count() << " games/s)" << std::endl;
+        results.print(std::cout, config);
+    }
+    catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,178 @@
+#include "placementsolver.h"
+#include "../board/board.h"
+#include "../common/resourcebundle.h"
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+// Every basement rules out itself and at most 3 neighbours, so the last builder always has somewhere left to build
+static_assert((PlacementPlan::NUM_PICKS - 1) * 4 < Topology::NUM_VERTICES, "the draft must never run out of vertices");
+
+int PlacementPlan::getPickBuilder(int pick) {
+    return pick < NUM_BUILDERS ? pick : NUM_PICKS - 1 - pick;
+}
+
+PlacementSolver::PlacementSolver(const Board& board, int threads) : threads{threads}, spacingMasks{Topology::makeSpacingMasks()} {
+    for (int i = 0; i < Board::MAX_BUILDERS; i++) {
+        if (board.getResidenceMask(i) != 0) {
+            throw std::invalid_argument("Initial placements can only be planned on an empty board");
+        }
+    }
+
+    for (int i = 0; i < NUM_VERTICES; i++) {
+        for (int j = 0; j < NUM_VERTICES; j++) {
+            if (spacingMasks[i] & vertexBit(j)) {
+                pairScores[i * NUM_VERTICES + j] = -1;
+                continue;
+            }
+
+            ResourceBundle yield = board.getVertexYield(i);
+            int diversity = 0;
+            for (int k = 0; k < ResourceBundle::NUM_RESOURCES; k++) {
+                yield.counts[k] += board.getVertexYield(j).counts[k];
+                diversity += yield.counts[k] > 0;
+            }
+            pairScores[i * NUM_VERTICES + j] = yield.total() + DIVERSITY_BONUS * diversity;
+            partners[i].push_back(j);
+            if (i < j) {
+                pairs.push_back(Pair{pairScores[i * NUM_VERTICES + j], i, j});
+            }
+        }
+
+        // Stable sorts keep ties in vertex order, so the lowest-numbered choice always wins
+        std::stable_sort(partners[i].begin(), partners[i].end(), [&](int a, int b) { return getPairScore(i, a) > getPairScore(i, b); });
+    }
+    std::stable_sort(pairs.begin(), pairs.end(), [](const Pair& a, const Pair& b) { return a.score > b.score; });
+}
+
+PlacementSolver::~PlacementSolver() {}
+
+int PlacementSolver::getThreadCount() const {
+    int count = threads > 0 ? threads : static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1, std::min(count, NUM_VERTICES));
+}
+
+int PlacementSolver::getPairScore(int first, int second) const {
+    return pairScores.at(first * NUM_VERTICES + second);
+}
+
+// Best second basement for a builder whose first is at vertex, given the vertices blocked so far
+int PlacementSolver::bestPartner(int vertex, VertexMask blocked) const {
+    for (int partner : partners[vertex]) {
+        if ((blocked & vertexBit(partner)) == 0) {
+            return partner;
+        }
+    }
+    throw std::logic_error("No legal second basement left in the draft");
+}
+
+const PlacementSolver::Pair& PlacementSolver::bestPair(VertexMask blocked) const {
+    for (const Pair& pair : pairs) {
+        if ((blocked & (vertexBit(pair.first) | vertexBit(pair.second))) == 0) {
+            return pair;
+        }
+    }
+    throw std::logic_error("No legal pair of basements left in the draft");
+}
+
+// Picks 2 to 5 once builders 0 and 1 have taken their first basements
+PlacementSolver::Tail PlacementSolver::solveTail(int first, int second) const {
+    VertexMask blocked = spacingMasks[first] | spacingMasks[second];
+    Tail best{{-1, -1, -1, -1}};
+    int bestScore = -1;
+
+    for (int vertex = 0; vertex < NUM_VERTICES; vertex++) {
+        if (blocked & vertexBit(vertex)) {
+            continue;
+        }
+        VertexMask afterFirst = blocked | spacingMasks[vertex];
+        const Pair& pair = bestPair(afterFirst);
+        int partner = bestPartner(vertex, afterFirst | spacingMasks[pair.first] | spacingMasks[pair.second]);
+        if (getPairScore(vertex, partner) > bestScore) {
+            best = Tail{{vertex, pair.first, pair.second, partner}};
+            bestScore = getPairScore(vertex, partner);
+        }
+    }
+    return best;
+}
+
+void PlacementSolver::solveTails(int shard, int shards, std::vector<Tail>& tails) const {
+    // Rows are dealt out round-robin, and only the upper triangle is filled since the order of the two doesn't matter
+    for (int i = shard; i < NUM_VERTICES; i += shards) {
+        for (int j = i + 1; j < NUM_VERTICES; j++) {
+            if ((spacingMasks[i] & vertexBit(j)) == 0) {
+                tails[i * NUM_VERTICES + j] = solveTail(i, j);
+            }
+        }
+    }
+}
+
+PlacementPlan PlacementSolver::solve() const {
+    std::vector<Tail> tails(NUM_VERTICES * NUM_VERTICES);
+    int shards = getThreadCount();
+    std::vector<std::exception_ptr> shardErrors(shards);
+    std::vector<std::thread> workers;
+
+    auto runShard = [&](int shard) {
+        try {
+            solveTails(shard, shards, tails);
+        }
+        catch (...) {
+            shardErrors[shard] = std::current_exception();
+        }
+    };
+    for (int i = 1; i < shards; i++) {
+        workers.emplace_back(runShard, i);
+    }
+    runShard(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (const std::exception_ptr& error : shardErrors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // Picks 1 and 6 for builder 1 once builder 0 has taken their first basement; picks 2 to 5 come from the memo
+    auto solveSecondBuilder = [&](int first, PlacementPlan& plan) {
+        int bestScore = -1;
+        for (int vertex = 0; vertex < NUM_VERTICES; vertex++) {
+            if (spacingMasks[first] & vertexBit(vertex)) {
+                continue;
+            }
+            const Tail& tail = tails[std::min(first, vertex) * NUM_VERTICES + std::max(first, vertex)];
+            VertexMask blocked = spacingMasks[first] | spacingMasks[vertex];
+            for (int pick : tail.picks) {
+                blocked |= spacingMasks[pick];
+            }
+            int partner = bestPartner(vertex, blocked);
+            if (getPairScore(vertex, partner) > bestScore) {
+                plan.picks = {{first, vertex, tail.picks[0], tail.picks[1], tail.picks[2], tail.picks[3], partner, -1}};
+                bestScore = getPairScore(vertex, partner);
+            }
+        }
+    };
+
+    PlacementPlan best;
+    int bestScore = -1;
+    for (int vertex = 0; vertex < NUM_VERTICES; vertex++) {
+        PlacementPlan plan;
+        solveSecondBuilder(vertex, plan);
+        VertexMask blocked = 0;
+        for (int i = 1; i < PlacementPlan::NUM_PICKS - 1; i++) {
+            blocked |= spacingMasks[plan.picks[i]];
+        }
+        plan.picks[PlacementPlan::NUM_PICKS - 1] = bestPartner(vertex, blocked);
+        if (getPairScore(vertex, plan.picks[PlacementPlan::NUM_PICKS - 1]) > bestScore) {
+            best = plan;
+            bestScore = getPairScore(vertex, plan.picks[PlacementPlan::NUM_PICKS - 1]);
+        }
+    }
+
+    for (int i = 0; i < PlacementPlan::NUM_BUILDERS; i++) {
+        best.scores[i] = getPairScore(best.picks[i], best.picks[PlacementPlan::NUM_PICKS - 1 - i]);
+    }
+    return best;
+}
@@ -0,0 +1,70 @@
+#ifndef PLACEMENTSOLVER_H
+#define PLACEMENTSOLVER_H
+
+#include "../board/topology.h"
+#include "../common/forward.h"
+#include <array>
+#include <vector>
+
+// Outcome of the initial-placement draft when every builder plays it optimally
+struct PlacementPlan {
+    static const int NUM_BUILDERS = 4;
+    static const int NUM_PICKS = 2 * NUM_BUILDERS;
+
+    std::array<int, NUM_PICKS> picks{};     // Vertices in draft order; pick i belongs to getPickBuilder(i)
+    std::array<int, NUM_BUILDERS> scores{}; // Placement score of each builder's pair of basements
+
+    // Snake draft: builders 0, 1, 2, 3, then 3, 2, 1, 0
+    static int getPickBuilder(int pick);
+};
+
+/**
+ * Initial-placement advisor for the snake draft on an empty board.
+ * Builders score their two basements by expected yield (in 36ths, see Board::getVertexYield) plus a bonus for
+ * each distinct resource the pair produces, and each maximises their own score.
+ * A builder's score only depends on their own basements, so second picks are simply the best legal partner of
+ * the first, and builder 3 takes the best legal pair outright. Everything before that is searched exhaustively,
+ * with legality checked against bitmasks and the outcome after builders 0 and 1 memoised by their (unordered)
+ * vertices, since builders 2 and 3 only care which vertices are taken, not by whom.
+ * The memo is filled on several threads, each owning whole rows of it; ties go to the lowest-numbered vertex,
+ * so plans never depend on the thread count.
+ */
+class PlacementSolver final {
+  public:
+    static constexpr int NUM_VERTICES = Topology::NUM_VERTICES;
+    static constexpr int DIVERSITY_BONUS = 2; // Per distinct resource, in the same 36ths as the yields
+
+  private:
+    // Outcome of picks 2 to 5: builder 2's first basement, builder 3's pair and builder 2's second basement
+    struct Tail {
+        int picks[4];
+    };
+
+    struct Pair {
+        int score;
+        int first;
+        int second;
+    };
+
+    const int threads;
+    std::array<VertexMask, NUM_VERTICES> spacingMasks;
+    std::array<int, NUM_VERTICES * NUM_VERTICES> pairScores; // -1 where the pair is too close to build
+    std::array<std::vector<int>, NUM_VERTICES> partners;     // Legal second basements for each first, best first
+    std::vector<Pair> pairs;                                 // Every legal pair, best first
+
+    int bestPartner(int, VertexMask) const;
+    const Pair& bestPair(VertexMask) const;
+    Tail solveTail(int, int) const;
+    void solveTails(int shard, int shards, std::vector<Tail>&) const;
+
+  public:
+    // Throws std::invalid_argument if the board already has residences; threads of 0 means one per hardware thread
+    PlacementSolver(const Board&, int threads = 0);
+    ~PlacementSolver();
+
+    int getThreadCount() const;
+    int getPairScore(int, int) const; // -1 if the two vertices are too close to both hold basements
+    PlacementPlan solve() const;
+};
+
+#endif
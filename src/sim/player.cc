@@ -0,0 +1,219 @@
+#include "player.h"
+#include "../board/board.h"
+#include "../board/topology.h"
+#include "../board/vertex.h"
+#include "../game/builder.h"
+#include "../game/engine.h"
+#include "../structures/residence.h"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+// Lowest-numbered location accepted by canUse with the highest value, or -1 if no location is accepted
+template <typename CanUse, typename Value>
+static int bestLocation(int count, CanUse canUse, Value value) {
+    int best = -1;
+    int bestValue = 0;
+    for (int i = 0; i < count; i++) {
+        if (!canUse(i)) {
+            continue;
+        }
+        int locationValue = value(i);
+        if (best == -1 || locationValue > bestValue) {
+            best = i;
+            bestValue = locationValue;
+        }
+    }
+    return best;
+}
+
+// A 1:1 trade on offer that gets the builder a card of the one resource they lack for cost, in return for a card beyond kept
+static bool findTrade(const Engine& engine, const Builder& builder, const ResourceBundle& cost, const ResourceBundle& kept, Action& trade) {
+    int lacking = -1;
+    for (int i = 0; i < ResourceBundle::NUM_RESOURCES; i++) {
+        if (builder.inventory[static_cast<Resource>(i)] < cost[static_cast<Resource>(i)]) {
+            if (lacking != -1) {
+                return false;
+            }
+            lacking = i;
+        }
+    }
+    if (lacking == -1) {
+        return false;
+    }
+
+    LegalActions actions;
+    engine.generateLegalActions(actions);
+    for (const Action& action : actions) {
+        if (action.type == ActionType::TRADE && action.trade.resourceToTake == static_cast<Resource>(lacking) && builder.inventory[action.trade.resourceToGive] > kept[action.trade.resourceToGive]) {
+            trade = action;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Shared turn logic; greedy players value locations by their expected yield, others take the first legal location
+static Action chooseBuildAction(const Engine& engine, bool greedy) {
+    const Board& board = engine.getBoard();
+    const Builder& builder = engine.getBuilder(engine.getCurrentBuilder());
+    auto vertexValue = [&](int vertex) { return greedy ? board.getVertexYield(vertex).total() : 0; };
+
+    switch (engine.getPhase()) {
+        case TurnPhase::INITIAL_PLACEMENT:
+            return Action{ActionType::BUILD_INITIAL_RESIDENCE, bestLocation(Board::NUM_VERTICES, [&](int vertex) { return board.canBuildInitialResidence(vertex); }, vertexValue)};
+
+        case TurnPhase::PRE_ROLL:
+            // Builders start out with loaded dice, which only make sense for a human
+            return Action{builder.getHasLoadedDice() ? ActionType::FAIR_DICE : ActionType::ROLL};
+
+        case TurnPhase::POST_ROLL: {
+            // Upgrades first, then new basements, and roads only once there is nowhere left to build
+            int upgrade = -1;
+            int upgradeValue = 0;
+            bool hasBasement = false;
+            bool hasHouse = false;
+            for (int vertex : builder.residences) {
+                ResidenceLevel level = board.getVertex(vertex)->getResidence().getLevel();
+                hasBasement |= level == ResidenceLevel::BASEMENT;
+                hasHouse |= level == ResidenceLevel::HOUSE;
+                if ((level == ResidenceLevel::BASEMENT && builder.inventory.canAfford(HOUSE_COST)) || (level == ResidenceLevel::HOUSE && builder.inventory.canAfford(TOWER_COST))) {
+                    if (upgrade == -1 || vertexValue(vertex) > upgradeValue) {
+                        upgrade = vertex;
+                        upgradeValue = vertexValue(vertex);
+                    }
+                }
+            }
+            if (upgrade != -1) {
+                return Action{ActionType::IMPROVE, upgrade};
+            }
+
+            int residence = bestLocation(Board::NUM_VERTICES, [&](int vertex) { return board.canBuildResidence(builder, vertex); }, vertexValue);
+            if (residence != -1 && builder.inventory.canAfford(BASEMENT_COST)) {
+                return Action{ActionType::BUILD_RESIDENCE, residence};
+            }
+
+            int road = -1;
+            if (residence == -1) {
+                road = bestLocation(Board::NUM_EDGES, [&](int edge) { return board.canBuildRoad(builder, edge); }, [&](int edge) {
+                    // Head towards the best vertex a basement could later be built on
+                    int value = 0;
+                    for (int j = 0; j < Topology::VERTICES_PER_EDGE; j++) {
+                        int vertex = Topology::edgeVertices[edge * Topology::VERTICES_PER_EDGE + j];
+                        if (board.canBuildInitialResidence(vertex) && vertexValue(vertex) > value) {
+                            value = vertexValue(vertex);
+                        }
+                    }
+                    return value;
+                });
+                if (road != -1 && builder.inventory.canAfford(ROAD_COST)) {
+                    return Action{ActionType::BUILD_ROAD, road};
+                }
+            }
+
+            // Greedy players trade towards the first build that a single resource is holding up, only ever giving away
+            // cards that none of their next builds need, so that one trade never undoes another
+            if (greedy) {
+                std::array<ResourceBundle, 4> goals;
+                int numGoals = 0;
+                if (hasBasement) {
+                    goals[numGoals++] = HOUSE_COST;
+                }
+                if (hasHouse) {
+                    goals[numGoals++] = TOWER_COST;
+                }
+                if (residence != -1) {
+                    goals[numGoals++] = BASEMENT_COST;
+                }
+                if (road != -1) {
+                    goals[numGoals++] = ROAD_COST;
+                }
+
+                ResourceBundle kept;
+                for (int i = 0; i < numGoals; i++) {
+                    for (int j = 0; j < ResourceBundle::NUM_RESOURCES; j++) {
+                        Resource resource = static_cast<Resource>(j);
+                        kept[resource] = std::max(kept[resource], goals[i][resource]);
+                    }
+                }
+                for (int i = 0; i < numGoals; i++) {
+                    Action trade{ActionType::TRADE};
+                    if (findTrade(engine, builder, goals[i], kept, trade)) {
+                        return trade;
+                    }
+                }
+            }
+
+            return Action{ActionType::END_TURN};
+        }
+
+        default:
+            throw std::logic_error("No build action for phase");
+    }
+}
+
+Player::Player() {}
+Player::~Player() {}
+
+Action ScriptedPlayer::chooseAction(const Engine& engine) {
+    switch (engine.getPhase()) {
+        case TurnPhase::GEESE_PLACEMENT:
+            return Action{ActionType::MOVE_GEESE, engine.getGeeseLocation() == 0 ? 1 : 0};
+        case TurnPhase::STEAL:
+            return Action{ActionType::STEAL, engine.getStealCandidates().front()};
+        default:
+            return chooseBuildAction(engine, false);
+    }
+}
+
+std::string ScriptedPlayer::getName() const {
+    return "scripted";
+}
+
+Action HeuristicPlayer::chooseAction(const Engine& engine) {
+    int self = engine.getCurrentBuilder();
+
+    switch (engine.getPhase()) {
+        case TurnPhase::GEESE_PLACEMENT: {
+            // Block the tile that costs opponents the most production, steering clear of our own residences
+            int tile = bestLocation(Board::NUM_TILES, [&](int i) { return i != engine.getGeeseLocation(); }, [&](int i) {
+                int value = 0;
+                for (int j = 0; j < Topology::VERTICES_PER_TILE; j++) {
+                    const Residence& residence = engine.getBoard().getVertex(Topology::tileVertices[i * Topology::VERTICES_PER_TILE + j])->getResidence();
+                    if (residence.exists()) {
+                        value += residence.getOwner() == self ? -2 * residence.getResourceMultiplier() : residence.getResourceMultiplier();
+                    }
+                }
+                return value * Board::rollWays(engine.getBoard().getTile(i)->getTileValue());
+            });
+            return Action{ActionType::MOVE_GEESE, tile};
+        }
+        case TurnPhase::STEAL: {
+            // Steal from whoever holds the most resources
+            int victim = engine.getStealCandidates().front();
+            for (int candidate : engine.getStealCandidates()) {
+                if (engine.getBuilder(candidate).getTotalResourceQuantity() > engine.getBuilder(victim).getTotalResourceQuantity()) {
+                    victim = candidate;
+                }
+            }
+            return Action{ActionType::STEAL, victim};
+        }
+        default:
+            return chooseBuildAction(engine, true);
+    }
+}
+
+std::string HeuristicPlayer::getName() const {
+    return "heuristic";
+}
+
+std::unique_ptr<Player> makePlayer(const std::string& name) {
+    if (name == "scripted") {
+        return std::make_unique<ScriptedPlayer>();
+    }
+    else if (name == "heuristic") {
+        return std::make_unique<HeuristicPlayer>();
+    }
+
+    throw std::invalid_argument("Unknown player " + name);
+}
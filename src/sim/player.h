@@ -0,0 +1,40 @@
+#ifndef PLAYER_H
+#define PLAYER_H
+
+#include "../common/action.h"
+#include "../common/forward.h"
+#include <memory>
+#include <string>
+
+/**
+ * Computer-controlled builder used by the simulator. Players only ever see the Engine through a const
+ * reference and must hold no state shared with other players or games, so that games may run in parallel.
+ * chooseAction is only called while it is this player's builder's turn and the game is not over.
+ */
+class Player {
+  public:
+    Player();
+    virtual ~Player();
+
+    virtual Action chooseAction(const Engine&) = 0;
+    virtual std::string getName() const = 0;
+};
+
+// Plays a fixed script: always the lowest-numbered legal location, builds whenever it can afford to
+class ScriptedPlayer final : public Player {
+  public:
+    Action chooseAction(const Engine&) override;
+    std::string getName() const override;
+};
+
+// Greedy player that values locations by the number of ways their tiles can be rolled
+class HeuristicPlayer final : public Player {
+  public:
+    Action chooseAction(const Engine&) override;
+    std::string getName() const override;
+};
+
+// Creates a player by name ("scripted" or "heuristic"); throws std::invalid_argument for anything else
+std::unique_ptr<Player> makePlayer(const std::string&);
+
+#endif
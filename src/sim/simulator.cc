@@ -0,0 +1,224 @@
+#include "simulator.h"
+#include "../common/randomengine.h"
+#include "../game/engine.h"
+#include "../game/game.h"
+#include "player.h"
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+void SimulationResults::recordRound(int round, const std::array<int, NUM_SEATS>& income) {
+    if (static_cast<int>(incomeTotals.size()) <= round) {
+        incomeTotals.resize(round + 1);
+        incomeSamples.resize(round + 1);
+    }
+
+    for (int i = 0; i < NUM_SEATS; i++) {
+        incomeTotals[round][i] += income[i];
+    }
+    incomeSamples[round]++;
+}
+
+void SimulationResults::recordGame(int winner, int turns) {
+    games++;
+    if (winner == -1) {
+        unfinished++;
+        return;
+    }
+
+    wins.at(winner)++;
+    if (static_cast<int>(lengthCounts.size()) <= turns) {
+        lengthCounts.resize(turns + 1);
+    }
+    lengthCounts[turns]++;
+}
+
+SimulationResults& SimulationResults::operator+=(const SimulationResults& rhs) {
+    games += rhs.games;
+    unfinished += rhs.unfinished;
+    for (int i = 0; i < NUM_SEATS; i++) {
+        wins[i] += rhs.wins[i];
+    }
+
+    lengthCounts.resize(std::max(lengthCounts.size(), rhs.lengthCounts.size()));
+    for (size_t i = 0; i < rhs.lengthCounts.size(); i++) {
+        lengthCounts[i] += rhs.lengthCounts[i];
+    }
+
+    incomeTotals.resize(std::max(incomeTotals.size(), rhs.incomeTotals.size()));
+    incomeSamples.resize(incomeTotals.size());
+    for (size_t i = 0; i < rhs.incomeTotals.size(); i++) {
+        for (int j = 0; j < NUM_SEATS; j++) {
+            incomeTotals[i][j] += rhs.incomeTotals[i][j];
+        }
+        incomeSamples[i] += rhs.incomeSamples[i];
+    }
+
+    return *this;
+}
+
+double SimulationResults::getWinRate(int seat) const {
+    return games == 0 ? 0 : static_cast<double>(wins.at(seat)) / games;
+}
+
+double SimulationResults::getUnfinishedRate() const {
+    return games == 0 ? 0 : static_cast<double>(unfinished) / games;
+}
+
+double SimulationResults::getMeanLength() const {
+    long long finished = games - unfinished;
+    long long totalTurns = 0;
+    for (size_t i = 0; i < lengthCounts.size(); i++) {
+        totalTurns += lengthCounts[i] * i;
+    }
+    return finished == 0 ? 0 : static_cast<double>(totalTurns) / finished;
+}
+
+int SimulationResults::getLengthPercentile(double fraction) const {
+    long long finished = games - unfinished;
+    long long seen = 0;
+    for (size_t i = 0; i < lengthCounts.size(); i++) {
+        seen += lengthCounts[i];
+        if (seen > 0 && seen >= fraction * finished) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+double SimulationResults::getMeanIncome(int round, int seat) const {
+    if (round < 0 || round >= static_cast<int>(incomeSamples.size()) || incomeSamples[round] == 0) {
+        return 0;
+    }
+    return static_cast<double>(incomeTotals[round].at(seat)) / incomeSamples[round];
+}
+
+void SimulationResults::print(std::ostream& out, const SimulationConfig& config) const {
+    static const char* seatColours[NUM_SEATS] = {"Blue", "Red", "Orange", "Yellow"};
+
+    out << std::fixed << std::setprecision(1);
+    out << "Seat    Player      Wins  Win rate" << std::endl;
+    for (int i = 0; i < NUM_SEATS; i++) {
+        out << std::left << std::setw(8) << seatColours[i] << std::setw(12) << config.players[i] << std::right << std::setw(4) << wins[i] << "  " << std::setw(7) << 100 * getWinRate(i) << "%" << std::endl;
+    }
+    out << std::left << std::setw(20) << "Unfinished" << std::right << std::setw(4) << unfinished << "  " << std::setw(7) << 100 * getUnfinishedRate() << "%  (after " << config.maxTurns << " turns)" << std::endl;
+
+    out << "Game length (turns): mean " << getMeanLength() << ", p10 " << getLengthPercentile(0.1) << ", p50 " << getLengthPercentile(0.5) << ", p90 " << getLengthPercentile(0.9) << std::endl;
+
+    // Income curve, sampled every 5 rounds while at least a tenth of the games are still running
+    out << "Mean resources gained by end of round:" << std::endl;
+    out << "Round";
+    for (int i = 0; i < NUM_SEATS; i++) {
+        out << std::setw(9) << seatColours[i];
+    }
+    out << std::endl;
+    for (size_t round = 4; round < incomeSamples.size() && incomeSamples[round] * 10 >= games; round += 5) {
+        out << std::setw(5) << round + 1;
+        for (int i = 0; i < NUM_SEATS; i++) {
+            out << std::setw(9) << getMeanIncome(round, i);
+        }
+        out << std::endl;
+    }
+}
+
+Simulator::Simulator(SimulationConfig config) : config{config} {
+    for (const std::string& player : config.players) {
+        // Fail fast on unknown player names rather than inside a worker thread
+        makePlayer(player);
+    }
+}
+
+Simulator::~Simulator() {}
+
+int Simulator::getThreadCount() const {
+    int threads = config.threads > 0 ? config.threads : static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1, std::min(threads, config.games));
+}
+
+void Simulator::playGame(int gameNumber, SimulationResults& results) const {
+    // Game i always plays on stream i, whichever thread runs it
+    RandomEngine rng{config.seed, static_cast<uint64_t>(gameNumber)};
+    std::vector<TileInitData> board = Game::generateRandomBoard(rng);
+    Engine engine(board, rng);
+
+    std::vector<std::unique_ptr<Player>> players;
+    for (const std::string& player : config.players) {
+        players.push_back(makePlayer(player));
+    }
+
+    int turns = 0;
+    std::array<int, SimulationResults::NUM_SEATS> income{};
+
+    while (engine.getPhase() != TurnPhase::GAME_OVER && turns < config.maxTurns) {
+        Player& player = *players[engine.getCurrentBuilder()];
+        Action action = player.chooseAction(engine);
+        const ActionResult* result = &engine.apply(action);
+
+        if (result->status != ActionStatus::SUCCESS) {
+            // A player that cannot make up its mind after rolling forfeits the rest of its turn
+            if (engine.getPhase() != TurnPhase::POST_ROLL) {
+                throw std::logic_error(player.getName() + " player chose an illegal action");
+            }
+            action = Action{ActionType::END_TURN};
+            result = &engine.apply(action);
+        }
+
+        for (const GameEvent& event : result->events) {
+            if (event.type == EventType::RESOURCES_GAINED) {
+                income[event.builder] += event.amount;
+            }
+        }
+
+        if (action.type == ActionType::END_TURN) {
+            turns++;
+            if (turns % SimulationResults::NUM_SEATS == 0) {
+                results.recordRound(turns / SimulationResults::NUM_SEATS - 1, income);
+            }
+        }
+    }
+
+    // The winning turn counts towards the game's length
+    results.recordGame(engine.getWinner(), turns + 1);
+}
+
+void Simulator::playShard(int shard, int shards, SimulationResults& results, std::exception_ptr& error) const {
+    // Accumulate locally so that threads never write to neighbouring results while playing
+    SimulationResults local;
+    try {
+        for (int i = shard; i < config.games; i += shards) {
+            playGame(i, local);
+        }
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+    results = std::move(local);
+}
+
+SimulationResults Simulator::run() const {
+    int threads = getThreadCount();
+    std::vector<SimulationResults> shardResults(threads);
+    std::vector<std::exception_ptr> shardErrors(threads);
+    std::vector<std::thread> workers;
+
+    for (int i = 1; i < threads; i++) {
+        workers.emplace_back(&Simulator::playShard, this, i, threads, std::ref(shardResults[i]), std::ref(shardErrors[i]));
+    }
+    playShard(0, threads, shardResults[0], shardErrors[0]);
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    SimulationResults results;
+    for (int i = 0; i < threads; i++) {
+        if (shardErrors[i]) {
+            std::rethrow_exception(shardErrors[i]);
+        }
+        results += shardResults[i];
+    }
+
+    return results;
+}
@@ -0,0 +1,66 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include "../common/forward.h"
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct SimulationConfig {
+    static const int NUM_SEATS = 4;
+
+    int games = 1000;
+    uint64_t seed = 1;          // Master seed; game i plays on random stream i of it, whichever thread runs it
+    int threads = 0;            // 0 means one per hardware thread
+    int maxTurns = 1000;        // Games still running after this many turns are recorded as unfinished
+    std::array<std::string, NUM_SEATS> players = {{"heuristic", "heuristic", "heuristic", "heuristic"}};
+};
+
+// Aggregated outcome of many games; each thread fills its own and they are merged at the end
+struct SimulationResults {
+    static const int NUM_SEATS = SimulationConfig::NUM_SEATS;
+
+    long long games = 0;
+    long long unfinished = 0;
+    std::array<long long, NUM_SEATS> wins{};
+    std::vector<long long> lengthCounts;                         // Finished games by number of turns taken
+    std::vector<std::array<long long, NUM_SEATS>> incomeTotals; // Resources gained by each seat by the end of each round, summed over games
+    std::vector<long long> incomeSamples;                       // Number of games that completed each round
+
+    void recordRound(int round, const std::array<int, NUM_SEATS>& income);
+    void recordGame(int winner, int turns);
+    SimulationResults& operator+=(const SimulationResults&);
+
+    double getWinRate(int seat) const;
+    double getUnfinishedRate() const;
+    double getMeanLength() const;
+    int getLengthPercentile(double) const; // Turns taken by the given fraction of finished games
+    double getMeanIncome(int round, int seat) const;
+
+    void print(std::ostream&, const SimulationConfig&) const;
+};
+
+/**
+ * Plays complete games between computer players across several threads.
+ * Every game owns its Engine, players and random stream outright, so threads share nothing mutable
+ * and games are statically partitioned between them; results only depend on the config, not the thread count.
+ */
+class Simulator final {
+  private:
+    const SimulationConfig config;
+
+    void playGame(int gameNumber, SimulationResults&) const;
+    void playShard(int shard, int shards, SimulationResults&, std::exception_ptr&) const;
+
+  public:
+    Simulator(SimulationConfig);
+    ~Simulator();
+
+    int getThreadCount() const;
+    SimulationResults run() const;
+};
+
+#endif
@@ -1,13 +1,71 @@
 #include "residence.h"
+#include <stdexcept>
+#include <string>
 
-Residence::Residence(Builder& owner, Vertex& location) : owner{owner}, location{location} {}
+Residence::Residence(int owner, ResidenceLevel level) : owner{static_cast<int8_t>(owner)}, level{level} {}
 
-Residence::~Residence() {}
+bool Residence::operator==(const Residence& other) const {
+    return owner == other.owner && level == other.level;
+}
+
+bool Residence::operator!=(const Residence& other) const {
+    return !(*this == other);
+}
+
+bool Residence::exists() const {
+    return level != ResidenceLevel::NONE;
+}
 
-Builder& Residence::getOwner() const {
+int Residence::getOwner() const {
     return owner;
 }
 
-Vertex& Residence::getLocation() const {
-    return location;
+ResidenceLevel Residence::getLevel() const {
+    return level;
+}
+
+int Residence::getBuildingPoints() const {
+    // Basements, houses and towers are worth 1, 2 and 3 points
+    return static_cast<int>(level);
+}
+
+char Residence::getResidenceLetter() const {
+    switch (level) {
+        case ResidenceLevel::BASEMENT:
+            return 'B';
+        case ResidenceLevel::HOUSE:
+            return 'H';
+        case ResidenceLevel::TOWER:
+            return 'T';
+        default:
+            return ' ';
+    }
+}
+
+int Residence::getResourceMultiplier() const {
+    return static_cast<int>(level);
+}
+
+bool Residence::canUpgrade() const {
+    return level == ResidenceLevel::BASEMENT || level == ResidenceLevel::HOUSE;
+}
+
+void Residence::upgrade() {
+    if (!canUpgrade()) {
+        throw std::logic_error("Residence cannot be upgraded");
+    }
+    level = static_cast<ResidenceLevel>(static_cast<int>(level) + 1);
+}
+
+ResidenceLevel Residence::levelFromLetter(char letter) {
+    switch (letter) {
+        case 'B':
+            return ResidenceLevel::BASEMENT;
+        case 'H':
+            return ResidenceLevel::HOUSE;
+        case 'T':
+            return ResidenceLevel::TOWER;
+        default:
+            throw std::invalid_argument(std::string("Unknown residence ") + letter);
+    }
 }
@@ -2,23 +2,40 @@
 #define RESIDENCE_H
 
 #include "../common/forward.h"
+#include <cstdint>
 
-class Residence {
-  protected:
-    Builder& owner;
-    Vertex& location;
+enum class ResidenceLevel : uint8_t { NONE, BASEMENT, HOUSE, TOWER };
+
+/**
+ * A residence is stored by value on its Vertex, so a board's residences live in one flat array indexed by
+ * vertex number: they are freed with the board and copy with memcpy. Upgrades change the level in place.
+ */
+class Residence final {
+  private:
+    int8_t owner = -1; // Builder number, or -1 for an empty vertex
+    ResidenceLevel level = ResidenceLevel::NONE;
 
   public:
-    Residence(Builder&, Vertex&);
-    virtual ~Residence();
+    Residence() = default;
+    Residence(int, ResidenceLevel = ResidenceLevel::BASEMENT);
+
+    bool operator==(const Residence&) const;
+    bool operator!=(const Residence&) const;
+
+    bool exists() const;
+    int getOwner() const;
+    ResidenceLevel getLevel() const;
+
+    int getBuildingPoints() const;
+    char getResidenceLetter() const;
+    int getResourceMultiplier() const; // How many copies of each Resource does a Builder obtain
+                                       // from adjacent Tiles during each dice roll?
 
-    Builder& getOwner() const;
-    Vertex& getLocation() const;
+    bool canUpgrade() const;
+    void upgrade(); // Basement to House to Tower; throws std::logic_error for anything else
 
-    virtual int getBuildingPoints() const = 0;
-    virtual char getResidenceLetter() const = 0;
-    virtual int getResourceMultiplier() const = 0; // How many copies of each Resource does a Builder obtain
-                                                   // from adjacent Tiles during each dice roll?
+    // 'B', 'H' or 'T' to a level; throws std::invalid_argument for anything else
+    static ResidenceLevel levelFromLetter(char);
 };
 
 #endif
@@ -1,13 +1,19 @@
 #include "road.h"
 
-Road::Road(Builder& owner, Edge& location) : owner{owner}, location{location} {}
+Road::Road(int owner) : owner{static_cast<int8_t>(owner)} {}
 
-Road::~Road() {}
+bool Road::operator==(const Road& other) const {
+    return owner == other.owner;
+}
 
-Builder& Road::getOwner() const {
-    return owner;
+bool Road::operator!=(const Road& other) const {
+    return !(*this == other);
 }
 
-Edge& Road::getLocation() const {
-    return location;
+bool Road::exists() const {
+    return owner != -1;
+}
+
+int Road::getOwner() const {
+    return owner;
 }
@@ -2,18 +2,22 @@
 #define ROAD_H
 
 #include "../common/forward.h"
+#include <cstdint>
 
+// A road is stored by value on its Edge, like Residence on its Vertex
 class Road final {
   private:
-    Builder& owner;
-    Edge& location;
+    int8_t owner = -1; // Builder number, or -1 for an empty edge
 
   public:
-    Road(Builder&, Edge&);
-    ~Road();
+    Road() = default;
+    explicit Road(int);
 
-    Builder& getOwner() const;
-    Edge& getLocation() const;
+    bool operator==(const Road&) const;
+    bool operator!=(const Road&) const;
+
+    bool exists() const;
+    int getOwner() const;
 };
 
 #endif
@@ -0,0 +1,27 @@
+#include "allocations.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions for the benchmark binary only, so benchmarks can count allocations
+static std::atomic<long long> allocationCount{0};
+
+long long getAllocationCount() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
@@ -0,0 +1,7 @@
+#ifndef ALLOCATIONS_H
+#define ALLOCATIONS_H
+
+// Number of global operator new calls made so far by the benchmark binary, on any thread
+long long getAllocationCount();
+
+#endif
@@ -0,0 +1,184 @@
+#include "../../src/board/board.h"
+#include "../../src/board/boardrenderer.h"
+#include "../../src/common/inventoryupdate.h"
+#include "../../src/game/builder.h"
+#include "../../src/sim/placementsolver.h"
+#include "allocations.h"
+#include "benchmark/benchmark.h"
+#include <sstream>
+
+namespace {
+std::vector<TileInitData> benchTileInitData = {{3, BRICK}, {10, ENERGY}, {5, HEAT}, {4, ENERGY}, {7, PARK}, {10, HEAT}, {11, GLASS}, {3, BRICK}, {8, HEAT}, {2, BRICK}, {6, BRICK}, {8, ENERGY}, {12, WIFI}, {5, ENERGY}, {11, WIFI}, {4, GLASS}, {6, WIFI}, {9, GLASS}, {9, GLASS}};
+
+// A mid-game position with every builder owning several residences and roads
+struct BenchPosition {
+    std::vector<std::unique_ptr<Builder>> builders;
+    std::unique_ptr<Board> board;
+
+    BenchPosition() {
+        builders.push_back(std::make_unique<Builder>(0, 'B'));
+        builders.push_back(std::make_unique<Builder>(1, 'R'));
+        builders.push_back(std::make_unique<Builder>(2, 'O'));
+        builders.push_back(std::make_unique<Builder>(3, 'Y'));
+        std::vector<BuilderStructureData> structureData = {{{{22, 'T'}, {27, 'B'}}, {33, 36, 40}}, {{{11, 'T'}, {42, 'H'}}, {11, 17, 25}}, {{{44, 'B'}}, {64, 67, 69, 71}}, {{{2, 'H'}, {7, 'T'}, {13, 'B'}}, {3, 5, 13, 21, 30}}};
+        std::vector<std::pair<Builder*, BuilderStructureData>> structures;
+        for (int i = 0; i < 4; i++) {
+            structures.emplace_back(builders[i].get(), structureData[i]);
+        }
+        board = std::make_unique<Board>(benchTileInitData, structures);
+    }
+};
+}
+
+static void BM_BoardConstruction(benchmark::State& state) {
+    for (auto _ : state) {
+        Board board(benchTileInitData);
+        // Boards hold const tiles, so they escape by address
+        benchmark::DoNotOptimize(&board);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_BoardConstruction);
+
+static void BM_GetResourcesFromDiceRoll(benchmark::State& state) {
+    BenchPosition position;
+    int roll = 2;
+    for (auto _ : state) {
+        BuilderInventoryUpdate update = position.board->getResourcesFromDiceRoll(roll);
+        benchmark::DoNotOptimize(update);
+        roll = roll == 12 ? 2 : roll + 1;
+    }
+}
+BENCHMARK(BM_GetResourcesFromDiceRoll);
+
+// Checks every vertex on the board per iteration
+static void BM_CanBuildResidence(benchmark::State& state) {
+    BenchPosition position;
+    for (auto _ : state) {
+        int legal = 0;
+        for (int i = 0; i < Board::NUM_VERTICES; i++) {
+            legal += position.board->canBuildResidence(*position.builders[i % 4], i);
+        }
+        benchmark::DoNotOptimize(legal);
+    }
+    state.SetItemsProcessed(state.iterations() * Board::NUM_VERTICES);
+}
+BENCHMARK(BM_CanBuildResidence);
+
+// Checks every edge on the board per iteration
+static void BM_CanBuildRoad(benchmark::State& state) {
+    BenchPosition position;
+    for (auto _ : state) {
+        int legal = 0;
+        for (int i = 0; i < Board::NUM_EDGES; i++) {
+            legal += position.board->canBuildRoad(*position.builders[i % 4], i);
+        }
+        benchmark::DoNotOptimize(legal);
+    }
+    state.SetItemsProcessed(state.iterations() * Board::NUM_EDGES);
+}
+BENCHMARK(BM_CanBuildRoad);
+
+// Every road, basement and upgrade open to each builder, with enough resources to afford anything
+static void BM_GenerateLegalActions(benchmark::State& state) {
+    BenchPosition position;
+    for (std::unique_ptr<Builder>& builder : position.builders) {
+        builder->inventory = ResourceBundle{5, 5, 5, 5, 5};
+    }
+    LegalActions actions;
+    int builder = 0;
+    for (auto _ : state) {
+        actions.clear();
+        position.board->generateLegalActions(*position.builders[builder], actions);
+        benchmark::DoNotOptimize(actions);
+        builder = (builder + 1) % 4;
+    }
+}
+BENCHMARK(BM_GenerateLegalActions);
+
+// Also reports allocations per move, which should be zero once every payout row has been sized
+static void BM_SetGeeseTile(benchmark::State& state) {
+    BenchPosition position;
+    for (int i = 0; i < Board::NUM_TILES; i++) {
+        position.board->setGeeseTile(i);
+    }
+
+    long long allocationsBefore = getAllocationCount();
+    int tile = 0;
+    for (auto _ : state) {
+        position.board->setGeeseTile(tile);
+        tile = (tile + 1) % Board::NUM_TILES;
+    }
+    state.counters["allocations"] = benchmark::Counter(getAllocationCount() - allocationsBefore, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SetGeeseTile);
+
+// Scoring every vertex for an initial placement, the way a placement heuristic would
+static void BM_ScoreVertices(benchmark::State& state) {
+    BenchPosition position;
+    for (auto _ : state) {
+        int best = 0;
+        for (int i = 0; i < Board::NUM_VERTICES; i++) {
+            if (position.board->getVertexYield(i).total() > position.board->getVertexYield(best).total()) {
+                best = i;
+            }
+        }
+        benchmark::DoNotOptimize(best);
+    }
+}
+BENCHMARK(BM_ScoreVertices);
+
+// Solving the whole snake draft on the given number of threads (0 for one per hardware thread)
+static void BM_SolvePlacement(benchmark::State& state) {
+    Board board(benchTileInitData);
+    for (auto _ : state) {
+        PlacementPlan plan = PlacementSolver(board, state.range(0)).solve();
+        benchmark::DoNotOptimize(plan);
+    }
+}
+BENCHMARK(BM_SolvePlacement)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_PrintBoard(benchmark::State& state) {
+    BenchPosition position;
+    for (auto _ : state) {
+        std::ostringstream out;
+        position.board->printBoard(out);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BM_PrintBoard);
+
+// A spectator redrawing the board after every action, with one renderer kept for the whole game
+static void BM_RenderBoard(benchmark::State& state) {
+    BenchPosition position;
+    BoardRenderer renderer;
+    long long allocationsBefore = getAllocationCount();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(renderer.render(*position.board).data());
+    }
+    state.counters["allocations"] = benchmark::Counter(getAllocationCount() - allocationsBefore, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_RenderBoard);
+
+// A spectator already showing the board, sent only the two geese cells that change between moves;
+// bytes is the size of each patch, against the full frame that BM_PrintBoard sends
+static void BM_PrintBoardPatch(benchmark::State& state) {
+    BenchPosition position;
+    BoardRenderer renderer;
+    std::ostringstream frame;
+    renderer.printPatch(*position.board, frame);
+
+    int tile = 0;
+    size_t bytes = 0;
+    for (auto _ : state) {
+        position.board->setGeeseTile(tile);
+        tile = (tile + 1) % Board::NUM_TILES;
+        std::ostringstream out;
+        renderer.printPatch(*position.board, out);
+        bytes = out.str().size();
+        benchmark::DoNotOptimize(out);
+    }
+    state.counters["bytes"] = bytes;
+    state.counters["frameBytes"] = frame.str().size();
+}
+BENCHMARK(BM_PrintBoardPatch);
@@ -0,0 +1,364 @@
+#include "../../src/game/boardgenerator.h"
+#include "../../src/game/engine.h"
+#include "../../src/game/game.h"
+#include "../../src/game/gamefactory.h"
+#include "../../src/game/outputsink.h"
+#include "../../src/game/savefile.h"
+#include "../../src/sim/player.h"
+#include "benchmark/benchmark.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace {
+const std::string benchSave = "test_inputs/load_from_game.in";
+
+SaveData readBenchSave() {
+    std::ifstream file{benchSave};
+    return SaveFile::readText(file);
+}
+
+// Every builder holds enough resources to lose half of them to the geese
+std::unique_ptr<Engine> makeRichEngine() {
+    SaveData data = readBenchSave();
+    std::vector<BuilderResourceData> resourceData(4, BuilderResourceData{8, 8, 8, 8, 8});
+    std::vector<BuilderStructureData> structureData;
+    for (const SavedBuilder& b : data.builders) {
+        structureData.emplace_back(std::vector<std::pair<int, char>>(b.residences.begin(), b.residences.end()), std::vector<int>(b.roads.begin(), b.roads.end()));
+    }
+    return std::make_unique<Engine>(std::vector<TileInitData>(data.tiles.begin(), data.tiles.end()), resourceData, structureData, 0, data.geeseTile, RandomEngine{1});
+}
+
+// One game chosen by heuristic players, both as the typed actions and as the console commands that play the same turns
+struct ScriptedGame {
+    static const int MAX_TURNS = 400;
+
+    std::vector<TileInitData> board;
+    RandomEngine rng{7}; // State after dealing the board, for the engine or game that replays it
+    std::vector<Action> actions;
+    std::string script;
+    int turns = 0;
+    uint64_t finalHash = 0;
+};
+
+ScriptedGame makeScriptedGame() {
+    ScriptedGame game;
+    game.board = Game::generateRandomBoard(game.rng);
+    Engine engine{game.board, game.rng};
+    HeuristicPlayer player;
+    std::ostringstream script;
+
+    while (engine.getPhase() != TurnPhase::GAME_OVER && game.turns < ScriptedGame::MAX_TURNS) {
+        const Builder& builder = engine.getBuilder(engine.getCurrentBuilder());
+        bool loaded = builder.getHasLoadedDice();
+        Action action = player.chooseAction(engine);
+        if (engine.apply(action).status != ActionStatus::SUCCESS) {
+            // As in the simulator, a player that cannot make up its mind forfeits the rest of its turn
+            action = Action{ActionType::END_TURN};
+            engine.apply(action);
+        }
+        game.actions.push_back(action);
+
+        switch (action.type) {
+            case ActionType::BUILD_INITIAL_RESIDENCE:
+            case ActionType::MOVE_GEESE:
+                script << action.target << '\n';
+                break;
+            case ActionType::LOAD_DICE:
+                script << "load\n";
+                break;
+            case ActionType::FAIR_DICE:
+                script << "fair\n";
+                break;
+            case ActionType::ROLL:
+                script << "roll\n";
+                if (loaded) {
+                    script << action.target << '\n';
+                }
+                break;
+            case ActionType::BUILD_ROAD:
+                script << "build-road " << action.target << '\n';
+                break;
+            case ActionType::BUILD_RESIDENCE:
+                script << "build-res " << action.target << '\n';
+                break;
+            case ActionType::IMPROVE:
+                script << "improve " << action.target << '\n';
+                break;
+            case ActionType::TRADE:
+                script << "trade " << engine.getBuilder(action.target).getBuilderColourString() << ' ' << action.trade.numToGive << ' ' << action.trade.resourceToGive << ' '
+                       << action.trade.numToTake << ' ' << action.trade.resourceToTake << "\nyes\n";
+                break;
+            case ActionType::STEAL:
+                script << engine.getBuilder(action.target).getBuilderColourString() << '\n';
+                break;
+            case ActionType::END_TURN:
+                script << "next\n";
+                game.turns++;
+                break;
+        }
+    }
+
+    game.script = script.str();
+    game.finalHash = engine.stateHash();
+    return game;
+}
+
+const ScriptedGame& getScriptedGame() {
+    static const ScriptedGame game = makeScriptedGame();
+    return game;
+}
+}
+
+static void BM_GameSave(benchmark::State& state) {
+    GameFactory factory{1};
+    std::unique_ptr<Game> game = factory.loadFromGame(benchSave);
+    for (auto _ : state) {
+        game->save("bench.sv");
+    }
+    std::remove("bench.sv");
+}
+BENCHMARK(BM_GameSave);
+
+static void BM_GameSaveBinary(benchmark::State& state) {
+    GameFactory factory{1};
+    std::unique_ptr<Game> game = factory.loadFromGame(benchSave);
+    for (auto _ : state) {
+        game->save("bench.svb");
+    }
+    std::remove("bench.svb");
+}
+BENCHMARK(BM_GameSaveBinary);
+
+static void BM_LoadFromGame(benchmark::State& state) {
+    GameFactory factory{1};
+    for (auto _ : state) {
+        std::unique_ptr<Game> game = factory.loadFromGame(benchSave);
+        benchmark::DoNotOptimize(game);
+    }
+}
+BENCHMARK(BM_LoadFromGame);
+
+static void BM_LoadFromGameBinary(benchmark::State& state) {
+    GameFactory factory{1};
+    factory.loadFromGame(benchSave)->save("bench_load.svb");
+    for (auto _ : state) {
+        std::unique_ptr<Game> game = factory.loadFromGame("bench_load.svb");
+        benchmark::DoNotOptimize(game);
+    }
+    std::remove("bench_load.svb");
+}
+BENCHMARK(BM_LoadFromGameBinary);
+
+static void BM_GameClone(benchmark::State& state) {
+    GameFactory factory{1};
+    std::unique_ptr<Game> game = factory.loadFromGame(benchSave);
+    for (auto _ : state) {
+        std::unique_ptr<Game> clone = game->clone();
+        benchmark::DoNotOptimize(clone);
+    }
+}
+BENCHMARK(BM_GameClone);
+
+// The allocation-free way to try out moves: save, play, rewind
+static void BM_GameSnapshotRestore(benchmark::State& state) {
+    GameFactory factory{1};
+    std::unique_ptr<Game> game = factory.loadFromGame(benchSave);
+    for (auto _ : state) {
+        EngineSnapshot snapshot = game->snapshot();
+        game->restore(snapshot);
+        benchmark::DoNotOptimize(snapshot);
+    }
+}
+BENCHMARK(BM_GameSnapshotRestore);
+
+// Make/unmake in place through the undo journal
+static void BM_EngineApplyUndo(benchmark::State& state) {
+    GameFactory factory{1};
+    std::unique_ptr<Game> game = factory.loadFromGame(benchSave);
+    Engine& engine = game->getEngine();
+    engine.setUndoEnabled(true);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.apply(Action{ActionType::END_TURN}));
+        engine.undo();
+    }
+}
+BENCHMARK(BM_EngineApplyUndo);
+
+static void BM_GameStateHash(benchmark::State& state) {
+    GameFactory factory{1};
+    std::unique_ptr<Game> game = factory.loadFromGame(benchSave);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(game->stateHash());
+    }
+}
+BENCHMARK(BM_GameStateHash);
+
+// In-memory encode/decode, without file I/O or building the Game
+static void BM_SaveFileReadText(benchmark::State& state) {
+    std::ostringstream text;
+    SaveFile::writeText(text, readBenchSave());
+    for (auto _ : state) {
+        std::istringstream in{text.str()};
+        SaveData data = SaveFile::readText(in);
+        benchmark::DoNotOptimize(data);
+    }
+}
+BENCHMARK(BM_SaveFileReadText);
+
+static void BM_SaveFileDecodeBinary(benchmark::State& state) {
+    std::string bytes = SaveFile::encodeBinary(readBenchSave());
+    for (auto _ : state) {
+        SaveData data = SaveFile::decodeBinary(bytes.data(), bytes.size());
+        benchmark::DoNotOptimize(data);
+    }
+}
+BENCHMARK(BM_SaveFileDecodeBinary);
+
+static void BM_SaveFileWriteText(benchmark::State& state) {
+    SaveData data = readBenchSave();
+    for (auto _ : state) {
+        std::ostringstream out;
+        SaveFile::writeText(out, data);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BM_SaveFileWriteText);
+
+static void BM_SaveFileEncodeBinary(benchmark::State& state) {
+    SaveData data = readBenchSave();
+    for (auto _ : state) {
+        std::string bytes = SaveFile::encodeBinary(data);
+        benchmark::DoNotOptimize(bytes);
+    }
+}
+BENCHMARK(BM_SaveFileEncodeBinary);
+
+// Turns per second for the same game played through the typed Engine API and through Game::play reading the
+// console commands for it; the headless engine is meant to manage at least 100 times as many turns
+static void BM_TurnsEngineApply(benchmark::State& state) {
+    const ScriptedGame& game = getScriptedGame();
+    for (auto _ : state) {
+        Engine engine{game.board, game.rng};
+        for (const Action& action : game.actions) {
+            benchmark::DoNotOptimize(engine.apply(action));
+        }
+        if (engine.stateHash() != game.finalHash) {
+            state.SkipWithError("Replaying the actions reached a different position");
+            return;
+        }
+    }
+    state.counters["turns/s"] = benchmark::Counter(static_cast<double>(state.iterations()) * game.turns, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_TurnsEngineApply);
+
+// Plays the script on a fresh console game, reporting an error if it strays from the recorded game
+bool playScript(benchmark::State& state, const ScriptedGame& game, OutputSink& out) {
+    Game console{game.board, game.rng};
+    std::istringstream in{game.script};
+    console.play(in, out, true);
+    if (console.stateHash() != game.finalHash) {
+        state.SkipWithError("Replaying the script reached a different position");
+        return false;
+    }
+    return true;
+}
+
+template <typename Sink>
+void turnsGamePlay(benchmark::State& state) {
+    const ScriptedGame& game = getScriptedGame();
+    for (auto _ : state) {
+        Sink out;
+        if (!playScript(state, game, out)) {
+            return;
+        }
+    }
+    state.counters["turns/s"] = benchmark::Counter(static_cast<double>(state.iterations()) * game.turns, benchmark::Counter::kIsRate);
+}
+BENCHMARK_TEMPLATE(turnsGamePlay, CaptureSink)->Name("BM_TurnsGamePlay");
+BENCHMARK_TEMPLATE(turnsGamePlay, NullSink)->Name("BM_TurnsGamePlaySilent");
+
+// As ctor runs with its output piped somewhere: flushed at every prompt, here to /dev/null
+static void BM_TurnsGamePlayConsole(benchmark::State& state) {
+    const ScriptedGame& game = getScriptedGame();
+    std::ofstream device{"/dev/null"};
+    for (auto _ : state) {
+        ConsoleSink out{device};
+        if (!playScript(state, game, out)) {
+            return;
+        }
+    }
+    state.counters["turns/s"] = benchmark::Counter(static_cast<double>(state.iterations()) * game.turns, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_TurnsGamePlayConsole);
+
+// Rolling a 7 makes all four builders discard half of their 40 resources (drawRandomResources)
+static void BM_GeeseDiscard(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::unique_ptr<Engine> engine = makeRichEngine();
+        engine->apply(Action{ActionType::END_TURN});
+        engine->apply(Action{ActionType::LOAD_DICE});
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(engine->apply(Action{ActionType::ROLL, 7}));
+    }
+}
+BENCHMARK(BM_GeeseDiscard);
+
+// Rolls a 7 for the next builder on a fresh rich engine and moves the geese to tile
+std::unique_ptr<Engine> makeGeeseEngine(int tile) {
+    std::unique_ptr<Engine> engine = makeRichEngine();
+    engine->apply(Action{ActionType::END_TURN});
+    engine->apply(Action{ActionType::LOAD_DICE});
+    engine->apply(Action{ActionType::ROLL, 7});
+    engine->apply(Action{ActionType::MOVE_GEESE, tile});
+    return engine;
+}
+
+// Stealing draws a single random resource (drawRandomResource)
+static void BM_Steal(benchmark::State& state) {
+    int tile = 0;
+    while (tile < Board::NUM_TILES && makeGeeseEngine(tile)->getPhase() != TurnPhase::STEAL) {
+        tile++;
+    }
+    if (tile == Board::NUM_TILES) {
+        state.SkipWithError("No tile with a builder to steal from");
+        return;
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::unique_ptr<Engine> engine = makeGeeseEngine(tile);
+        int victim = engine->getStealCandidates().front();
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(engine->apply(Action{ActionType::STEAL, victim}));
+    }
+}
+BENCHMARK(BM_Steal);
+
+// Unconstrained boards as dealt by -random-board, for comparison with the balanced generator below
+static void BM_GenerateRandomBoard(benchmark::State& state) {
+    RandomEngine rng{1};
+    for (auto _ : state) {
+        std::vector<TileInitData> data = Game::generateRandomBoard(rng);
+        benchmark::DoNotOptimize(data);
+    }
+    state.counters["boards/s"] = benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_GenerateRandomBoard);
+
+static void BM_GenerateBalancedBoards(benchmark::State& state) {
+    BoardGenerator generator;
+    const int batch = 1000;
+    long long attempts = 0;
+    uint64_t seed = 1;
+    for (auto _ : state) {
+        GeneratedBoards results = generator.generateMany(batch, seed++, state.range(0));
+        attempts += results.attempts;
+    }
+    state.counters["boards/s"] = benchmark::Counter(state.iterations() * batch, benchmark::Counter::kIsRate);
+    state.counters["drawsPerBoard"] = static_cast<double>(attempts) / (state.iterations() * batch);
+}
+BENCHMARK(BM_GenerateBalancedBoards)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,96 @@
+#include "../../src/game/commandreader.h"
+#include "../../src/game/game.h"
+#include "../../src/game/gamefactory.h"
+#include "../../src/game/outputsink.h"
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+// Macrobenchmarks: every saved game in test_inputs replays every command script in game/inputs headlessly,
+// i.e. with output rendered into a string rather than a terminal. Registered as BM_Replay/<save>/<script>,
+// and as BM_ReplaySilent/<save>/<script> with output discarded.
+namespace {
+std::string readFile(const std::string& filename) {
+    std::ifstream file{filename};
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+// Saved games start with a single builder number on the first line; board layouts do not
+bool isSavedGame(const std::string& contents) {
+    std::istringstream in{contents};
+    std::string firstLine;
+    std::getline(in, firstLine);
+    return firstLine.find(' ') == std::string::npos;
+}
+
+// Sink is CaptureSink to render the transcript, or NullSink to measure the game logic alone
+template <typename Sink>
+void replay(benchmark::State& state, const std::string& save, const std::string& script) {
+    GameFactory factory{1};
+    for (auto _ : state) {
+        std::unique_ptr<Game> game = factory.loadFromGame(save);
+        std::istringstream in{script};
+        Sink out;
+        game->play(in, out, false);
+        benchmark::DoNotOptimize(out);
+    }
+}
+
+// Tokenizing alone, so the cost of reading commands can be compared with extracting them into std::strings
+void tokenizeWithReader(benchmark::State& state, const std::string& script) {
+    for (auto _ : state) {
+        std::istringstream in{script};
+        CommandReader reader{in};
+        std::string_view word;
+        while (reader.readWord(word)) {
+            benchmark::DoNotOptimize(word);
+        }
+    }
+}
+
+void tokenizeWithExtraction(benchmark::State& state, const std::string& script) {
+    for (auto _ : state) {
+        std::istringstream in{script};
+        std::string word;
+        while (in >> word) {
+            benchmark::DoNotOptimize(word);
+        }
+    }
+}
+
+// Directory order is unspecified, so sort to keep benchmark names in a stable order between runs
+std::vector<std::filesystem::path> listDirectory(const std::string& directory) {
+    std::vector<std::filesystem::path> paths;
+    for (const auto& entry : std::filesystem::directory_iterator{directory}) {
+        paths.push_back(entry.path());
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+bool registerReplays() {
+    for (const std::filesystem::path& save : listDirectory("test_inputs")) {
+        if (!isSavedGame(readFile(save.string()))) {
+            continue;
+        }
+        for (const std::filesystem::path& script : listDirectory("game/inputs")) {
+            std::string name = save.stem().string() + "/" + script.stem().string();
+            benchmark::RegisterBenchmark(("BM_Replay/" + name).c_str(), replay<CaptureSink>, save.string(), readFile(script.string()));
+            benchmark::RegisterBenchmark(("BM_ReplaySilent/" + name).c_str(), replay<NullSink>, save.string(), readFile(script.string()));
+        }
+    }
+    for (const std::filesystem::path& script : listDirectory("game/inputs")) {
+        std::string name = "BM_Tokenize/" + script.stem().string();
+        benchmark::RegisterBenchmark((name + "/reader").c_str(), tokenizeWithReader, readFile(script.string()));
+        benchmark::RegisterBenchmark((name + "/extraction").c_str(), tokenizeWithExtraction, readFile(script.string()));
+    }
+    return true;
+}
+
+const bool replaysRegistered = registerReplays();
+}
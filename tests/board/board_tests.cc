@@ -1,8 +1,11 @@
 #include "../../src/board/board.h"
+#include "../../src/board/boardrenderer.h"
 #include "../../src/board/edge.h"
 #include "../../src/common/inventoryupdate.h"
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <fstream>
+#include <type_traits>
 
 std::vector<TileInitData> sampleTileInitData = {{3, BRICK}, {10, ENERGY}, {5, HEAT}, {4, ENERGY}, {7, PARK}, {10, HEAT}, {11, GLASS}, {3, BRICK}, {8, HEAT}, {2, BRICK}, {6, BRICK}, {8, ENERGY}, {12, WIFI}, {5, ENERGY}, {11, WIFI}, {4, GLASS}, {6, WIFI}, {9, GLASS}, {9, GLASS}};
 
@@ -317,3 +320,536 @@ TEST(Board, GetResourcesFromDiceRoll) {
     EXPECT_EQ(update[2][WIFI], 0);
     EXPECT_EQ(update[3][WIFI], 0);
 }
+
+namespace {
+// Reference versions of the legality rules, reading each vertex and edge in turn rather than the masks
+
+bool walkTouchesRoad(const Board& board, const Builder& builder, int vertexNumber) {
+    for (int j = Topology::vertexEdgeOffsets[vertexNumber]; j < Topology::vertexEdgeOffsets[vertexNumber + 1]; j++) {
+        if (board.getEdge(Topology::vertexEdges[j])->getRoad().getOwner() == builder.getBuilderNumber()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool walkCanBuildInitialResidence(const Board& board, int vertexNumber) {
+    if (board.getVertex(vertexNumber)->hasResidence()) {
+        return false;
+    }
+    for (int j = Topology::vertexEdgeOffsets[vertexNumber]; j < Topology::vertexEdgeOffsets[vertexNumber + 1]; j++) {
+        for (int k = 0; k < Topology::VERTICES_PER_EDGE; k++) {
+            if (board.getVertex(Topology::edgeVertices[Topology::vertexEdges[j] * Topology::VERTICES_PER_EDGE + k])->hasResidence()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool walkCanBuildRoad(const Board& board, const Builder& builder, int edgeNumber) {
+    if (board.getEdge(edgeNumber)->hasRoad()) {
+        return false;
+    }
+    for (int k = 0; k < Topology::VERTICES_PER_EDGE; k++) {
+        // Roads leave the builder's own residences, or empty vertices touching one of their roads
+        const Vertex* vertex = board.getVertex(Topology::edgeVertices[edgeNumber * Topology::VERTICES_PER_EDGE + k]);
+        if (vertex->hasResidence() ? vertex->getResidence().getOwner() == builder.getBuilderNumber() : walkTouchesRoad(board, builder, vertex->getVertexNumber())) {
+            return true;
+        }
+    }
+    return false;
+}
+}
+
+TEST(Board, OccupancyMasksMatchStructures) {
+    Builder builder1{0, 'Y'};
+    Builder builder2{1, 'R'};
+    Builder builder3{2, 'B'};
+    Builder builder4{3, 'O'};
+    std::vector<Builder*> builders = {&builder1, &builder2, &builder3, &builder4};
+
+    BuilderStructureData builderData1({{22, 'T'}, {27, 'B'}}, {33, 36, 40, 44, 48, 52});
+    BuilderStructureData builderData2({{11, 'T'}, {42, 'H'}}, {11, 17, 25, 34, 42, 51});
+    BuilderStructureData builderData3({{44, 'B'}, {52, 'T'}}, {64, 67, 69, 47, 55, 63});
+    BuilderStructureData builderData4({{3, 'H'}, {7, 'T'}, {19, 'B'}}, {3, 5, 13, 21, 30, 35, 31});
+
+    std::vector<std::pair<Builder*, BuilderStructureData>> sampleStructureData = {{&builder1, builderData1}, {&builder2, builderData2}, {&builder3, builderData3}, {&builder4, builderData4}};
+    Board board(sampleTileInitData, sampleStructureData);
+
+    EXPECT_EQ(board.getResidenceMask(0), vertexBit(22) | vertexBit(27));
+    EXPECT_EQ(board.getResidenceMask(3), vertexBit(3) | vertexBit(7) | vertexBit(19));
+    EXPECT_TRUE(board.getRoadMask(2).test(64));
+    EXPECT_TRUE(board.getRoadMask(2).test(69));
+    EXPECT_FALSE(board.getRoadMask(2).test(33));
+
+    // The bitboard checks must agree with walking the topology tables one structure at a time
+    for (Builder* builder : builders) {
+        for (int i = 0; i < Board::NUM_VERTICES; i++) {
+            EXPECT_EQ(board.canBuildResidence(*builder, i), walkCanBuildInitialResidence(board, i) && walkTouchesRoad(board, *builder, i)) << "vertex " << i;
+            EXPECT_EQ(board.canBuildInitialResidence(i), walkCanBuildInitialResidence(board, i)) << "vertex " << i;
+        }
+        for (int i = 0; i < Board::NUM_EDGES; i++) {
+            EXPECT_EQ(board.canBuildRoad(*builder, i), walkCanBuildRoad(board, *builder, i)) << "edge " << i;
+        }
+    }
+}
+
+TEST(Board, OccupancyMasksFollowBuilds) {
+    Builder builder{0, 'B'};
+    builder.inventory[HEAT] = 10;
+    builder.inventory[WIFI] = 10;
+    Board board(sampleTileInitData);
+
+    EXPECT_EQ(board.buildInitialResidence(builder, 0), ActionStatus::SUCCESS);
+    EXPECT_EQ(board.getResidenceMask(0), vertexBit(0));
+    EXPECT_FALSE(board.canBuildInitialResidence(1));
+    EXPECT_FALSE(board.canBuildInitialResidence(3));
+    EXPECT_TRUE(board.canBuildInitialResidence(4));
+
+    // Roads grow out from the basement at vertex 0, but never onto an edge that is already taken
+    EXPECT_FALSE(board.canBuildRoad(builder, 2));
+    EXPECT_EQ(board.buildRoad(builder, 1), ActionStatus::SUCCESS);
+    EXPECT_TRUE(board.getRoadMask(0).test(1));
+    EXPECT_FALSE(board.canBuildRoad(builder, 1));
+    EXPECT_TRUE(board.canBuildRoad(builder, 3));
+    EXPECT_TRUE(board.canBuildRoad(builder, 0));
+    EXPECT_FALSE(board.canBuildRoad(builder, 5));
+}
+
+TEST(Board, PayoutsFollowUpgradesAndGeese) {
+    Builder builder{0, 'B'};
+    builder.inventory[GLASS] = 2;
+    builder.inventory[HEAT] = 3;
+    Board board(sampleTileInitData);
+
+    // Vertex 0 only touches tile 0, which produces BRICK on a 3
+    board.buildInitialResidence(builder, 0);
+    EXPECT_EQ(board.getResourcesFromDiceRoll(3)[0][BRICK], 1);
+
+    board.upgradeResidence(builder, 0);
+    EXPECT_EQ(board.getResourcesFromDiceRoll(3)[0][BRICK], 2);
+
+    board.setGeeseTile(0);
+    EXPECT_FALSE(board.getResourcesFromDiceRoll(3).changed());
+
+    board.setGeeseTile(4);
+    EXPECT_EQ(board.getResourcesFromDiceRoll(3)[0][BRICK], 2);
+
+    // Payouts are only reported; the Engine credits them
+    EXPECT_EQ(builder.inventory[BRICK], 0);
+
+    // Rolls that no tile carries pay nothing
+    EXPECT_FALSE(board.getResourcesFromDiceRoll(13).changed());
+}
+
+TEST(Board, GenerateLegalActionsMatchesProbing) {
+    std::vector<Builder> builders = {{0, 'Y'}, {1, 'R'}, {2, 'B'}, {3, 'O'}};
+    std::vector<BuilderStructureData> structureData = {{{{22, 'T'}, {27, 'B'}}, {33, 36, 40}}, {{{11, 'T'}, {42, 'H'}}, {11, 17, 25}}, {{{44, 'B'}}, {64, 67, 69, 71}}, {{{2, 'H'}, {7, 'T'}, {13, 'B'}}, {3, 5, 13, 21, 30}}};
+    std::vector<std::pair<Builder*, BuilderStructureData>> structures;
+    for (int i = 0; i < 4; i++) {
+        structures.emplace_back(&builders[i], structureData[i]);
+    }
+    Board board(sampleTileInitData, structures);
+
+    // Every combination of affording roads, basements, houses and towers
+    std::vector<ResourceBundle> inventories = {{0, 0, 0, 0, 0}, {0, 0, 0, 1, 1}, {1, 1, 1, 0, 1}, {0, 0, 2, 3, 0}, {3, 2, 2, 0, 1}, {5, 5, 5, 5, 5}};
+    for (Builder& builder : builders) {
+        for (const ResourceBundle& inventory : inventories) {
+            builder.inventory = inventory;
+
+            std::vector<std::pair<ActionType, int>> expected;
+            for (int i = 0; i < Board::NUM_EDGES; i++) {
+                if (board.canBuildRoad(builder, i) && inventory.canAfford(ROAD_COST)) {
+                    expected.emplace_back(ActionType::BUILD_ROAD, i);
+                }
+            }
+            for (int i = 0; i < Board::NUM_VERTICES; i++) {
+                if (board.canBuildResidence(builder, i) && inventory.canAfford(BASEMENT_COST)) {
+                    expected.emplace_back(ActionType::BUILD_RESIDENCE, i);
+                }
+            }
+            for (int i : builder.residences) {
+                ResidenceLevel level = board.getVertex(i)->getResidence().getLevel();
+                if ((level == ResidenceLevel::BASEMENT && inventory.canAfford(HOUSE_COST)) || (level == ResidenceLevel::HOUSE && inventory.canAfford(TOWER_COST))) {
+                    expected.emplace_back(ActionType::IMPROVE, i);
+                }
+            }
+
+            LegalActions actions;
+            board.generateLegalActions(builder, actions);
+            std::vector<std::pair<ActionType, int>> generated;
+            for (const Action& action : actions) {
+                generated.emplace_back(action.type, action.target);
+            }
+            EXPECT_EQ(generated, expected);
+        }
+    }
+}
+
+TEST(Board, UnbuildsReverseBuilds) {
+    Builder builder{0, 'B'};
+    builder.inventory[GLASS] = 2;
+    builder.inventory[HEAT] = 10;
+    builder.inventory[WIFI] = 10;
+    Board board(sampleTileInitData);
+
+    board.buildInitialResidence(builder, 0);
+    board.buildRoad(builder, 1);
+    board.buildRoad(builder, 3);
+    board.upgradeResidence(builder, 0);
+    EXPECT_EQ(builder.getBuildingPoints(), 2);
+    EXPECT_EQ(board.getResourcesFromDiceRoll(3)[0][BRICK], 2);
+
+    board.downgradeResidence(builder, 0);
+    EXPECT_EQ(board.getVertex(0)->getResidence().getLevel(), ResidenceLevel::BASEMENT);
+    EXPECT_EQ(builder.getBuildingPoints(), 1);
+    EXPECT_EQ(board.getResourcesFromDiceRoll(3)[0][BRICK], 1);
+
+    // Road 1 still reaches the vertex shared with road 3, so only road 3's far end becomes unreachable
+    board.unbuildRoad(builder, 3);
+    EXPECT_FALSE(board.getEdge(3)->hasRoad());
+    EXPECT_EQ(builder.roads.size(), 1u);
+    EXPECT_EQ(board.getRoadMask(0), EdgeMask::bit(1));
+    EXPECT_TRUE(board.canBuildRoad(builder, 3));
+    EXPECT_FALSE(board.canBuildRoad(builder, 5));
+
+    board.unbuildRoad(builder, 1);
+    board.unbuildResidence(builder, 0);
+    EXPECT_FALSE(board.getVertex(0)->hasResidence());
+    EXPECT_EQ(builder.getBuildingPoints(), 0);
+    EXPECT_TRUE(builder.residences.empty());
+    EXPECT_EQ(board.getResidenceMask(0), 0u);
+    EXPECT_FALSE(board.getRoadMask(0).any());
+    EXPECT_TRUE(board.canBuildInitialResidence(1));
+    EXPECT_FALSE(board.canBuildRoad(builder, 1));
+    EXPECT_FALSE(board.getResourcesFromDiceRoll(3).changed());
+}
+
+TEST(Board, HashFollowsStructuresNotHistory) {
+    Builder builder{0, 'B'};
+    builder.inventory = ResourceBundle{5, 5, 5, 5, 5};
+    Board board(sampleTileInitData);
+    uint64_t empty = board.getHash();
+    EXPECT_NE(Board(sampleTileInitData).getHash(), 0u);
+    EXPECT_EQ(Board(sampleTileInitData).getHash(), empty);
+
+    board.buildInitialResidence(builder, 0);
+    board.buildRoad(builder, 1);
+    board.buildRoad(builder, 3);
+    uint64_t built = board.getHash();
+    EXPECT_NE(built, empty);
+
+    // Loading the same structures in another order gives the same hash
+    Builder loadedBuilder{0, 'B'};
+    std::vector<std::pair<Builder*, BuilderStructureData>> structures = {{&loadedBuilder, BuilderStructureData{{{0, 'B'}}, {3, 1}}}};
+    EXPECT_EQ(Board(sampleTileInitData, structures).getHash(), built);
+
+    board.upgradeResidence(builder, 0);
+    EXPECT_NE(board.getHash(), built);
+    board.downgradeResidence(builder, 0);
+    EXPECT_EQ(board.getHash(), built);
+
+    board.setGeeseTile(0);
+    EXPECT_NE(board.getHash(), built);
+    BoardSnapshot geese = board.snapshot();
+    board.setGeeseTile(4);
+    EXPECT_EQ(board.getHash(), built);
+    EXPECT_EQ(Board(board).getHash(), built);
+    board.restore(geese);
+    EXPECT_EQ(board.getHash(), geese.hash);
+    board.setGeeseTile(4);
+
+    board.unbuildRoad(builder, 3);
+    board.unbuildRoad(builder, 1);
+    board.unbuildResidence(builder, 0);
+    EXPECT_EQ(board.getHash(), empty);
+
+    // Boards with different tiles differ even when empty
+    std::vector<TileInitData> swapped = sampleTileInitData;
+    std::swap(swapped[0], swapped[1]);
+    EXPECT_NE(Board(swapped).getHash(), empty);
+}
+
+TEST(Board, CopyDoesNotAliasOriginal) {
+    Builder builder{0, 'B'};
+    builder.inventory[GLASS] = 2;
+    builder.inventory[HEAT] = 3;
+    Board board(sampleTileInitData);
+    board.buildInitialResidence(builder, 0);
+
+    Board copy(board);
+    std::ostringstream boardOut;
+    std::ostringstream copyOut;
+    board.printBoard(boardOut);
+    copy.printBoard(copyOut);
+    EXPECT_EQ(copyOut.str(), boardOut.str());
+
+    copy.buildInitialResidence(builder, 10);
+    copy.upgradeResidence(builder, 0);
+    copy.setGeeseTile(0);
+    EXPECT_TRUE(board.canBuildInitialResidence(10));
+    EXPECT_EQ(board.getVertex(0)->getResidence().getLevel(), ResidenceLevel::BASEMENT);
+    EXPECT_EQ(board.getGeeseTile(), 4);
+    EXPECT_FALSE(board.getTile(0)->hasGeese());
+    EXPECT_EQ(board.getResourcesFromDiceRoll(3)[0][BRICK], 1);
+    EXPECT_FALSE(copy.getResourcesFromDiceRoll(3).changed());
+
+    std::ostringstream afterOut;
+    board.printBoard(afterOut);
+    EXPECT_EQ(afterOut.str(), boardOut.str());
+}
+
+TEST(Board, RestoreRewindsToSnapshot) {
+    Builder builder{0, 'B'};
+    builder.inventory[GLASS] = 2;
+    builder.inventory[HEAT] = 3;
+    Board board(sampleTileInitData);
+    board.buildInitialResidence(builder, 0);
+
+    BoardSnapshot snapshot = board.snapshot();
+    std::ostringstream before;
+    board.printBoard(before);
+
+    board.buildInitialResidence(builder, 10);
+    board.upgradeResidence(builder, 0);
+    board.setGeeseTile(7);
+
+    board.restore(snapshot);
+    std::ostringstream after;
+    board.printBoard(after);
+    EXPECT_EQ(after.str(), before.str());
+    EXPECT_EQ(board.getGeeseTile(), 4);
+    EXPECT_TRUE(board.getTile(4)->hasGeese());
+    EXPECT_FALSE(board.getTile(7)->hasGeese());
+    EXPECT_EQ(board.getResidenceMask(0), vertexBit(0));
+    EXPECT_TRUE(board.canBuildInitialResidence(10));
+    EXPECT_EQ(board.getResourcesFromDiceRoll(3)[0][BRICK], 1);
+    EXPECT_TRUE(std::is_trivially_copyable<BoardSnapshot>::value);
+}
+
+TEST(Board, ReusedRendererRedrawsEveryCell) {
+    Builder builder{0, 'B'};
+    builder.inventory[BRICK] = 1;
+    builder.inventory[ENERGY] = 1;
+    builder.inventory[GLASS] = 2;
+    builder.inventory[HEAT] = 3;
+    Board board(sampleTileInitData);
+    Board other({{2, WIFI}, {12, GLASS}, {7, PARK}, {4, ENERGY}, {5, HEAT}, {10, HEAT}, {11, GLASS}, {3, BRICK}, {8, HEAT}, {3, BRICK}, {6, BRICK}, {8, ENERGY}, {10, ENERGY}, {5, ENERGY}, {11, WIFI}, {4, GLASS}, {6, WIFI}, {9, GLASS}, {9, GLASS}});
+    BoardRenderer renderer;
+
+    board.buildInitialResidence(builder, 0);
+    board.buildRoad(builder, 0);
+    board.upgradeResidence(builder, 0);
+    board.setGeeseTile(7);
+    std::ostringstream fresh;
+    board.printBoard(fresh);
+    EXPECT_EQ(renderer.render(board), fresh.str());
+
+    // Nothing drawn for the first board may survive into the second
+    std::ostringstream expected;
+    other.printBoard(expected);
+    std::ostringstream out;
+    renderer.print(other, out);
+    EXPECT_EQ(out.str(), expected.str());
+    EXPECT_NE(out.str(), fresh.str());
+}
+
+namespace {
+// Applies the cursor moves and text of an ANSI patch to a frame, as a terminal showing it would
+std::string applyPatch(std::string frame, const std::string& patch) {
+    std::vector<size_t> lineStarts = {0};
+    for (size_t i = 0; i + 1 < frame.size(); i++) {
+        if (frame[i] == '\n') {
+            lineStarts.push_back(i + 1);
+        }
+    }
+
+    size_t cursor = 0;
+    for (size_t i = 0; i < patch.size();) {
+        if (patch[i] == '\x1b') {
+            size_t separator = patch.find(';', i);
+            size_t end = patch.find('H', i);
+            size_t line = std::stoul(patch.substr(i + 2, separator - i - 2));
+            size_t column = std::stoul(patch.substr(separator + 1, end - separator - 1));
+            cursor = line <= lineStarts.size() ? lineStarts[line - 1] + column - 1 : frame.size();
+            i = end + 1;
+        }
+        else {
+            frame.at(cursor++) = patch[i++];
+        }
+    }
+    return frame;
+}
+}
+
+TEST(Board, RendererSendsOnlyChanges) {
+    Builder builder{0, 'R'};
+    for (Resource resource : {BRICK, ENERGY, GLASS, HEAT, WIFI}) {
+        builder.inventory[resource] = 10;
+    }
+    Board board(sampleTileInitData);
+    BoardRenderer deltaRenderer;
+    BoardRenderer patchRenderer;
+
+    // New viewers get the full frame
+    std::ostringstream full;
+    board.printBoard(full);
+    std::ostringstream firstDelta;
+    deltaRenderer.printDelta(board, firstDelta);
+    EXPECT_EQ(firstDelta.str(), full.str());
+    std::ostringstream firstPatch;
+    patchRenderer.printPatch(board, firstPatch);
+    EXPECT_EQ(firstPatch.str(), "\x1b[H\x1b[2J" + full.str());
+
+    std::ostringstream unchanged;
+    deltaRenderer.printDelta(board, unchanged);
+    patchRenderer.printPatch(board, unchanged);
+    EXPECT_EQ(unchanged.str(), "");
+
+    board.buildInitialResidence(builder, 22);
+    board.upgradeResidence(builder, 22);
+    board.upgradeResidence(builder, 22);
+    board.buildRoad(builder, 28);
+    board.setGeeseTile(9);
+
+    std::ostringstream delta;
+    deltaRenderer.printDelta(board, delta);
+    EXPECT_EQ(delta.str(), "vertex 22 -> RT\nedge 28 -> RR\ngeese 4 -> 9\n");
+
+    std::ostringstream patch;
+    patchRenderer.printPatch(board, patch);
+    std::ostringstream expected;
+    board.printBoard(expected);
+    EXPECT_EQ(applyPatch(full.str(), patch.str()), expected.str());
+    EXPECT_LT(patch.str().size(), 100);
+
+    // Undoing a build is a change like any other
+    board.unbuildRoad(builder, 28);
+    std::ostringstream undone;
+    deltaRenderer.printDelta(board, undone);
+    EXPECT_EQ(undone.str(), "edge 28 -> 28\n");
+}
+
+namespace {
+// Yield of a vertex found the slow way, by scanning every tile for it
+ResourceBundle scanVertexYield(const Board& board, int vertexNumber) {
+    ResourceBundle yield;
+    for (int i = 0; i < Board::NUM_TILES; i++) {
+        const Tile* tile = board.getTile(i);
+        for (int j = 0; j < Topology::VERTICES_PER_TILE; j++) {
+            if (Topology::tileVertices[i * Topology::VERTICES_PER_TILE + j] == vertexNumber && !tile->hasGeese() && tile->getResource() != PARK) {
+                yield[tile->getResource()] += Board::rollWays(tile->getTileValue());
+            }
+        }
+    }
+    return yield;
+}
+
+void expectYieldsMatchScan(const Board& board) {
+    for (int i = 0; i < Board::NUM_VERTICES; i++) {
+        EXPECT_EQ(board.getVertexYield(i).counts, scanVertexYield(board, i).counts) << "vertex " << i;
+    }
+}
+}
+
+TEST(Board, VertexYieldsFollowTheGeese) {
+    Board board(sampleTileInitData);
+    expectYieldsMatchScan(board);
+    // Vertex 0 only touches tile 0, a 3 of BRICK
+    EXPECT_EQ(board.getVertexYield(0)[BRICK], 2);
+    EXPECT_EQ(board.getVertexYield(0).total(), 2);
+
+    for (int tile : {0, 9, 4, 18}) {
+        board.setGeeseTile(tile);
+        expectYieldsMatchScan(board);
+    }
+    EXPECT_EQ(board.getVertexYield(0)[BRICK], 2);
+
+    BoardSnapshot snapshot = board.snapshot();
+    board.setGeeseTile(0);
+    EXPECT_EQ(board.getVertexYield(0)[BRICK], 0);
+    Board copy(board);
+    board.restore(snapshot);
+    expectYieldsMatchScan(board);
+    expectYieldsMatchScan(copy);
+}
+
+TEST(Board, GetStealCandidates) {
+    Builder builder1(0, 'B');
+    Builder builder2(1, 'R');
+    Builder builder3(2, 'O');
+    Builder builder4(3, 'Y');
+    // Tile 4's corners are vertices 8, 9, 14, 15, 20 and 21; builder 3 only has a residence elsewhere
+    Board board(sampleTileInitData, {{&builder1, BuilderStructureData({{8, 'B'}}, {})}, {&builder2, BuilderStructureData({{15, 'H'}, {20, 'T'}}, {})}, {&builder3, BuilderStructureData({{0, 'B'}}, {})}});
+
+    // Each builder is listed once, however many corners they hold; whether they have anything to steal is the Engine's concern
+    EXPECT_EQ(board.getStealCandidates(4, builder1), std::vector<int>{1});
+    EXPECT_EQ(board.getStealCandidates(4, builder2), std::vector<int>{0});
+    EXPECT_EQ(board.getStealCandidates(4, builder4), (std::vector<int>{0, 1}));
+
+    // The geese don't hide anyone
+    board.setGeeseTile(4);
+    EXPECT_EQ(board.getStealCandidates(4, builder4), (std::vector<int>{0, 1}));
+    EXPECT_TRUE(board.getStealCandidates(18, builder4).empty());
+}
+
+namespace {
+// Payouts of a roll found the slow way, by scanning every tile's corners
+BuilderInventoryUpdate scanPayouts(const Board& board, int rollNumber) {
+    BuilderInventoryUpdate update;
+    for (int i = 0; i < Board::NUM_TILES; i++) {
+        const Tile* tile = board.getTile(i);
+        if (tile->getTileValue() != rollNumber || tile->hasGeese() || tile->getResource() == PARK) {
+            continue;
+        }
+        for (int j = 0; j < Topology::VERTICES_PER_TILE; j++) {
+            const Residence& residence = board.getVertex(Topology::tileVertices[i * Topology::VERTICES_PER_TILE + j])->getResidence();
+            if (residence.exists()) {
+                update[residence.getOwner()][tile->getResource()] += residence.getResourceMultiplier();
+            }
+        }
+    }
+    return update;
+}
+
+void expectPayoutsMatchScan(const Board& board) {
+    for (int roll = 2; roll <= Board::MAX_ROLL; roll++) {
+        EXPECT_EQ(board.getResourcesFromDiceRoll(roll).inventories, scanPayouts(board, roll).inventories) << "roll " << roll;
+    }
+}
+}
+
+TEST(Board, PayoutRowsMatchAFullScan) {
+    std::vector<Builder> builders = {{0, 'Y'}, {1, 'R'}, {2, 'B'}, {3, 'O'}};
+    for (Builder& builder : builders) {
+        builder.inventory = ResourceBundle{20, 20, 20, 20, 20};
+    }
+    Board board(sampleTileInitData);
+    expectPayoutsMatchScan(board);
+
+    // Spread basements over tiles sharing values, so that rows grow and shrink in the middle of the table
+    std::vector<int> spots = {0, 10, 20, 30, 40, 50, 23, 47};
+    for (size_t i = 0; i < spots.size(); i++) {
+        ASSERT_EQ(board.buildInitialResidence(builders[i % builders.size()], spots[i]), ActionStatus::SUCCESS) << "vertex " << spots[i];
+        expectPayoutsMatchScan(board);
+    }
+    for (int tile : {0, 9, 4, 18, 11, 8}) {
+        board.setGeeseTile(tile);
+        expectPayoutsMatchScan(board);
+    }
+    for (size_t i = 0; i < spots.size(); i += 2) {
+        ASSERT_EQ(board.upgradeResidence(builders[i % builders.size()], spots[i]), ActionStatus::SUCCESS);
+        expectPayoutsMatchScan(board);
+    }
+    for (size_t i = 0; i < spots.size(); i += 2) {
+        board.downgradeResidence(builders[i % builders.size()], spots[i]);
+        expectPayoutsMatchScan(board);
+    }
+
+    // Unbuilds undo builds, so they go newest first
+    for (size_t i = spots.size(); i-- > 0;) {
+        board.unbuildResidence(builders[i % builders.size()], spots[i]);
+        expectPayoutsMatchScan(board);
+    }
+}
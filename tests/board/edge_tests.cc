@@ -1,9 +1,14 @@
+#include "../../src/board/board.h"
 #include "../../src/board/edge.h"
 #include "../../src/game/builder.h"
-#include "../../src/structures/basement.h"
+#include "../../src/structures/residence.h"
 #include "../../src/structures/road.h"
 #include "gtest/gtest.h"
 
+namespace {
+std::vector<TileInitData> edgeTileInitData = {{3, BRICK}, {10, ENERGY}, {5, HEAT}, {4, ENERGY}, {7, PARK}, {10, HEAT}, {11, GLASS}, {3, BRICK}, {8, HEAT}, {2, BRICK}, {6, BRICK}, {8, ENERGY}, {12, WIFI}, {5, ENERGY}, {11, WIFI}, {4, GLASS}, {6, WIFI}, {9, GLASS}, {9, GLASS}};
+}
+
 TEST(Edge, GetEdgeNumber) {
     Edge edge(44);
     EXPECT_EQ(edge.getEdgeNumber(), 44);
@@ -12,87 +17,47 @@ TEST(Edge, GetEdgeNumber) {
 TEST(Edge, GetRoad) {
     Edge edge(42);
     Builder builder(3, 'O');
-    std::shared_ptr<Road> road = std::make_shared<Road>(builder, edge);
+    Road road{builder.getBuilderNumber()};
 
     edge.buildRoad(road);
 
     EXPECT_EQ(edge.getRoad(), road);
 }
 
-TEST(Edge, GetNeighbouringVertices) {
-    Edge edge(52);
-    Vertex vertex1(92);
-    Vertex vertex2(55);
-
-    edge.addNeighbouringVertex(&vertex1);
-    edge.addNeighbouringVertex(&vertex2);
-
-    EXPECT_EQ(edge.getNeighbouringVertices().at(0), &vertex1);
-    EXPECT_EQ(edge.getNeighbouringVertices().at(1), &vertex2);
-}
+// Road rules live in Board's occupancy masks; these cover them from a single edge's point of view
 
 TEST(Edge, CannotBuildRoadWhenRoadAlreadyExists) {
-    Edge edge(52);
     Builder builder(3, 'O');
-    std::shared_ptr<Road> road = std::make_shared<Road>(builder, edge);
-
-    edge.buildRoad(road);
+    Board board(edgeTileInitData, {{&builder, BuilderStructureData({}, {52})}});
 
-    EXPECT_EQ(edge.canBuildRoad(builder), false);
+    EXPECT_EQ(board.canBuildRoad(builder, 52), false);
 }
 
 TEST(Edge, CanBuildRoadWithAdjacentResidence) {
-    Edge edge(11);
-    Vertex vertex(12);
+    // Edge 11 joins vertices 10 and 11
     Builder builder1(2, 'B');
     Builder builder2(3, 'G');
+    Board board(edgeTileInitData, {{&builder1, BuilderStructureData({{10, 'B'}}, {})}});
 
-    edge.addNeighbouringVertex(&vertex);
-
-    std::shared_ptr<Residence> res = std::make_shared<Basement>(builder1, vertex);
-    vertex.buildResidence(res);
-
-    EXPECT_EQ(edge.canBuildRoad(builder1), true);
-    EXPECT_EQ(edge.canBuildRoad(builder2), false);
+    EXPECT_EQ(board.canBuildRoad(builder1, 11), true);
+    EXPECT_EQ(board.canBuildRoad(builder2, 11), false);
 }
 
 TEST(Edge, CanBuildRoadWithAdjacentRoad) {
-    Edge edge1(10);
-    Edge edge2(11);
-    Vertex vertex(12);
+    // Edges 10 and 14 meet at vertex 8
     Builder builder1(2, 'B');
     Builder builder2(3, 'G');
+    Board board(edgeTileInitData, {{&builder1, BuilderStructureData({}, {14})}});
 
-    edge1.addNeighbouringVertex(&vertex);
-    edge2.addNeighbouringVertex(&vertex);
-    vertex.addNeighbouringEdge(&edge1);
-    vertex.addNeighbouringEdge(&edge2);
-
-    std::shared_ptr<Road> road = std::make_shared<Road>(builder1, edge2);
-    edge2.buildRoad(road);
-
-    EXPECT_EQ(edge1.canBuildRoad(builder1), true);
-    EXPECT_EQ(edge1.canBuildRoad(builder2), false);
+    EXPECT_EQ(board.canBuildRoad(builder1, 10), true);
+    EXPECT_EQ(board.canBuildRoad(builder2, 10), false);
 }
 
 TEST(Edge, CannotBuildRoadThroughOpponentResidence) {
-    Edge edge1(10);
-    Edge edge2(11);
-    Vertex vertex(12);
     Builder builder1(2, 'B');
     Builder builder2(3, 'G');
+    Board board(edgeTileInitData, {{&builder1, BuilderStructureData({}, {14})}, {&builder2, BuilderStructureData({{8, 'B'}}, {})}});
 
-    edge1.addNeighbouringVertex(&vertex);
-    edge2.addNeighbouringVertex(&vertex);
-    vertex.addNeighbouringEdge(&edge1);
-    vertex.addNeighbouringEdge(&edge2);
-
-    std::shared_ptr<Road> road = std::make_shared<Road>(builder1, edge2);
-    edge2.buildRoad(road);
-
-    std::shared_ptr<Residence> res = std::make_shared<Basement>(builder2, vertex);
-    vertex.buildResidence(res);
-
-    EXPECT_EQ(edge1.canBuildRoad(builder1), false);
-    EXPECT_EQ(edge1.canBuildRoad(builder2), true);
+    EXPECT_EQ(board.canBuildRoad(builder1, 10), false);
+    EXPECT_EQ(board.canBuildRoad(builder2, 10), true);
 }
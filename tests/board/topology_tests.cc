@@ -0,0 +1,65 @@
+#include "../../src/board/topology.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+
+TEST(Topology, VertexEdgeRows) {
+    // Vertex 3 sits below tile 0's top-left corner and touches three edges
+    EXPECT_EQ(Topology::vertexEdgeOffsets[4] - Topology::vertexEdgeOffsets[3], 3);
+    EXPECT_EQ(Topology::vertexEdges[Topology::vertexEdgeOffsets[3]], 1);
+    EXPECT_EQ(Topology::vertexEdges[Topology::vertexEdgeOffsets[3] + 1], 3);
+    EXPECT_EQ(Topology::vertexEdges[Topology::vertexEdgeOffsets[3] + 2], 6);
+
+    // Vertex 0 is on the coast
+    EXPECT_EQ(Topology::vertexEdgeOffsets[1] - Topology::vertexEdgeOffsets[0], 2);
+}
+
+TEST(Topology, DerivedMasks) {
+    std::array<VertexMask, Topology::NUM_VERTICES> spacing = Topology::makeSpacingMasks();
+    std::array<VertexMask, Topology::NUM_EDGES> endpoints = Topology::makeEndpointMasks();
+
+    EXPECT_EQ(spacing[0], vertexBit(0) | vertexBit(1) | vertexBit(3));
+    EXPECT_EQ(endpoints[71], vertexBit(52) | vertexBit(53));
+}
+
+TEST(Topology, TileNeighbourMasks) {
+    std::array<TileMask, Topology::NUM_TILES> neighbours = Topology::makeTileNeighbourMasks();
+
+    EXPECT_EQ(neighbours[0], tileBit(1) | tileBit(2) | tileBit(4));
+    EXPECT_EQ(__builtin_popcount(neighbours[9]), 6);
+    for (int i = 0; i < Topology::NUM_TILES; i++) {
+        for (int j = 0; j < Topology::NUM_TILES; j++) {
+            EXPECT_EQ((neighbours[i] & tileBit(j)) != 0, (neighbours[j] & tileBit(i)) != 0);
+        }
+    }
+}
+
+TEST(Topology, VertexRowsMatchEdgeEndpoints) {
+    // Every edge a vertex lists has that vertex as an endpoint, and every edge is listed by both its endpoints
+    int links = 0;
+    for (int i = 0; i < Topology::NUM_VERTICES; i++) {
+        for (int j = Topology::vertexEdgeOffsets[i]; j < Topology::vertexEdgeOffsets[i + 1]; j++) {
+            int edge = Topology::vertexEdges[j];
+            EXPECT_TRUE(Topology::edgeVertices[2 * edge] == i || Topology::edgeVertices[2 * edge + 1] == i) << "vertex " << i << ", edge " << edge;
+            links++;
+        }
+    }
+    EXPECT_EQ(links, Topology::NUM_EDGES * Topology::VERTICES_PER_EDGE);
+}
+
+TEST(Topology, VertexTileMasks) {
+    std::array<TileMask, Topology::NUM_VERTICES> tiles = Topology::makeVertexTileMasks();
+
+    // Vertex 0 is on the coast of tile 0; vertex 9 is shared by tiles 0, 2 and 4
+    EXPECT_EQ(tiles[0], tileBit(0));
+    EXPECT_EQ(tiles[9], tileBit(0) | tileBit(2) | tileBit(4));
+
+    int links = 0;
+    for (int i = 0; i < Topology::NUM_VERTICES; i++) {
+        for (TileMask bits = tiles[i]; bits != 0; bits &= bits - 1) {
+            const int* first = &Topology::tileVertices[lowestBit(bits) * Topology::VERTICES_PER_TILE];
+            EXPECT_NE(std::find(first, first + Topology::VERTICES_PER_TILE, i), first + Topology::VERTICES_PER_TILE);
+            links++;
+        }
+    }
+    EXPECT_EQ(links, Topology::NUM_TILES * Topology::VERTICES_PER_TILE);
+}
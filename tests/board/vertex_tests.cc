@@ -1,11 +1,14 @@
+#include "../../src/board/board.h"
 #include "../../src/board/vertex.h"
 #include "../../src/game/builder.h"
-#include "../../src/structures/basement.h"
 #include "../../src/structures/residence.h"
 #include "../../src/structures/road.h"
-#include "../../src/structures/tower.h"
 #include "gtest/gtest.h"
 
+namespace {
+std::vector<TileInitData> vertexTileInitData = {{3, BRICK}, {10, ENERGY}, {5, HEAT}, {4, ENERGY}, {7, PARK}, {10, HEAT}, {11, GLASS}, {3, BRICK}, {8, HEAT}, {2, BRICK}, {6, BRICK}, {8, ENERGY}, {12, WIFI}, {5, ENERGY}, {11, WIFI}, {4, GLASS}, {6, WIFI}, {9, GLASS}, {9, GLASS}};
+}
+
 TEST(Vertex, GetVertexNumber) {
     Vertex vertex(15);
 
@@ -15,80 +18,48 @@ TEST(Vertex, GetVertexNumber) {
 TEST(Vertex, GetResidence) {
     Vertex vertex(16);
     Builder builder(2, 'B');
-    std::shared_ptr<Residence> res = std::make_shared<Basement>(builder, vertex);
+    Residence res{builder.getBuilderNumber(), ResidenceLevel::BASEMENT};
 
     vertex.buildResidence(res);
 
     EXPECT_EQ(vertex.getResidence(), res);
 }
 
-TEST(Vertex, GetNeighbouringEdges) {
-    Vertex vertex(11);
-    Edge edge1(1);
-    Edge edge2(2);
-
-    vertex.addNeighbouringEdge(&edge1);
-    vertex.addNeighbouringEdge(&edge2);
-
-    EXPECT_EQ(vertex.getNeighbouringEdges().at(0), &edge1);
-    EXPECT_EQ(vertex.getNeighbouringEdges().at(1), &edge2);
-}
+// Placement rules live in Board's occupancy masks; these cover them from a single vertex's point of view
 
 TEST(Vertex, CannotBuildResidenceIfAlreadyExists) {
-    Vertex vertex(16);
     Builder builder(2, 'B');
+    Board board(vertexTileInitData, {{&builder, BuilderStructureData({{16, 'B'}}, {})}});
 
-    std::shared_ptr<Residence> res = std::make_shared<Basement>(builder, vertex);
-    vertex.buildResidence(res);
-
-    EXPECT_EQ(vertex.canBuildResidence(builder), false);
-    EXPECT_EQ(vertex.canBuildInitialResidence(), false);
+    EXPECT_EQ(board.canBuildResidence(builder, 16), false);
+    EXPECT_EQ(board.canBuildInitialResidence(16), false);
 }
 
 TEST(Vertex, CannotBuildResidenceTooCloseToAnotherResidence) {
-    Vertex vertex1(4);
-    Vertex vertex2(5);
-    Edge edge(12);
+    // Edge 4 joins vertices 4 and 5, and edge 7 leads from vertex 4 to vertex 9
     Builder builder(3, 'G');
+    Board board(vertexTileInitData, {{&builder, BuilderStructureData({{5, 'B'}}, {7})}});
 
-    vertex1.addNeighbouringEdge(&edge);
-    vertex2.addNeighbouringEdge(&edge);
-    edge.addNeighbouringVertex(&vertex1);
-    edge.addNeighbouringVertex(&vertex2);
-
-    std::shared_ptr<Residence> res = std::make_shared<Basement>(builder, vertex2);
-    vertex2.buildResidence(res);
-
-    EXPECT_EQ(vertex1.canBuildResidence(builder), false);
-    EXPECT_EQ(vertex1.canBuildInitialResidence(), false);
+    EXPECT_EQ(board.canBuildResidence(builder, 4), false);
+    EXPECT_EQ(board.canBuildInitialResidence(4), false);
 }
 
 TEST(Vertex, CannotBuildResidenceWithoutRoad) {
-    Vertex vertex(2);
-    Edge edge(5);
     Builder builder(0, 'Y');
+    Board board(vertexTileInitData);
 
-    vertex.addNeighbouringEdge(&edge);
-    edge.addNeighbouringVertex(&vertex);
-
-    EXPECT_EQ(vertex.canBuildResidence(builder), false);
-    EXPECT_EQ(vertex.canBuildInitialResidence(), true);
+    EXPECT_EQ(board.canBuildResidence(builder, 2), false);
+    EXPECT_EQ(board.canBuildInitialResidence(2), true);
 }
 
 TEST(Vertex, CanBuildResidenceWithRoad) {
-    Vertex vertex(2);
-    Edge edge(5);
+    // Edge 5 touches vertex 2
     Builder builder1(0, 'Y');
     Builder builder2(1, 'G');
+    Board board(vertexTileInitData, {{&builder1, BuilderStructureData({}, {5})}});
 
-    vertex.addNeighbouringEdge(&edge);
-    edge.addNeighbouringVertex(&vertex);
-
-    std::shared_ptr<Road> road = std::make_shared<Road>(builder1, edge);
-    edge.buildRoad(road);
-
-    EXPECT_EQ(vertex.canBuildResidence(builder1), true);
-    EXPECT_EQ(vertex.canBuildResidence(builder2), false);
+    EXPECT_EQ(board.canBuildResidence(builder1, 2), true);
+    EXPECT_EQ(board.canBuildResidence(builder2, 2), false);
 }
 
 TEST(Vertex, CannotUpgradeResidenceThatDoesntExist) {
@@ -102,7 +73,7 @@ TEST(Vertex, CannotUpgradeResidenceThatIsTower) {
     Vertex vertex(5);
     Builder builder(0, 'Y');
 
-    std::shared_ptr<Residence> res = std::make_shared<Tower>(builder, vertex);
+    Residence res{builder.getBuilderNumber(), ResidenceLevel::TOWER};
     vertex.buildResidence(res);
 
     EXPECT_EQ(vertex.canUpgradeResidence(builder), false);
@@ -113,7 +84,7 @@ TEST(Vertex, CanUpgradeResidence) {
     Builder builder1(0, 'Y');
     Builder builder2(1, 'G');
 
-    std::shared_ptr<Residence> res = std::make_shared<Basement>(builder1, vertex);
+    Residence res{builder1.getBuilderNumber(), ResidenceLevel::BASEMENT};
     vertex.buildResidence(res);
 
     EXPECT_EQ(vertex.canUpgradeResidence(builder1), true);
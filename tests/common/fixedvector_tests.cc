@@ -0,0 +1,51 @@
+#include "../../src/common/fixedvector.h"
+#include "gtest/gtest.h"
+
+TEST(FixedVector, EmplaceAndIterate) {
+    FixedVector<int, 3> vector;
+    EXPECT_TRUE(vector.empty());
+
+    vector.emplace_back(4);
+    vector.emplace_back(7);
+    EXPECT_EQ(vector.size(), 2u);
+    EXPECT_EQ(vector.at(1), 7);
+
+    int sum = 0;
+    for (int i : vector) {
+        sum += i;
+    }
+    EXPECT_EQ(sum, 11);
+}
+
+TEST(FixedVector, BoundsAreChecked) {
+    FixedVector<int, 2> vector;
+    vector.emplace_back(1);
+
+    EXPECT_THROW(vector.at(1), std::out_of_range);
+    vector.emplace_back(2);
+    EXPECT_THROW(vector.emplace_back(3), std::length_error);
+}
+
+TEST(FixedVector, ResizeKeepsLeadingElements) {
+    FixedVector<int, 3> vector;
+    vector.emplace_back(5);
+    vector.emplace_back(6);
+
+    vector.resize(1);
+    EXPECT_EQ(vector.size(), 1u);
+    EXPECT_EQ(vector.at(0), 5);
+    vector.resize(3);
+    EXPECT_EQ(vector.size(), 3u);
+    EXPECT_EQ(vector.at(0), 5);
+    EXPECT_THROW(vector.resize(4), std::length_error);
+}
+
+TEST(FixedVector, Equality) {
+    FixedVector<int, 3> a;
+    FixedVector<int, 3> b;
+    a.emplace_back(1);
+    EXPECT_FALSE(a == b);
+
+    b.emplace_back(1);
+    EXPECT_TRUE(a == b);
+}
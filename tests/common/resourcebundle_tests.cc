@@ -0,0 +1,51 @@
+#include "../../src/common/inventoryupdate.h"
+#include "../../src/common/resourcebundle.h"
+#include "gtest/gtest.h"
+
+TEST(ResourceBundle, Arithmetic) {
+    ResourceBundle bundle{1, 2, 3, 4, 5};
+    EXPECT_EQ(bundle.total(), 15);
+    EXPECT_EQ(bundle[GLASS], 3);
+
+    bundle += ResourceBundle{1, 1, 1, 1, 1};
+    EXPECT_EQ(bundle, (ResourceBundle{2, 3, 4, 5, 6}));
+
+    bundle -= TOWER_COST;
+    EXPECT_EQ(bundle, (ResourceBundle{-1, 1, 2, 3, 5}));
+    EXPECT_EQ(bundle - bundle, ResourceBundle{});
+}
+
+TEST(ResourceBundle, CanAfford) {
+    EXPECT_TRUE((ResourceBundle{0, 0, 0, 1, 1}).canAfford(ROAD_COST));
+    EXPECT_FALSE((ResourceBundle{5, 5, 5, 0, 5}).canAfford(ROAD_COST));
+    EXPECT_TRUE((ResourceBundle{3, 2, 2, 2, 1}).canAfford(TOWER_COST));
+    EXPECT_FALSE((ResourceBundle{3, 2, 2, 2, 0}).canAfford(TOWER_COST));
+    EXPECT_TRUE(ResourceBundle{}.canAfford(ResourceBundle{}));
+
+    // Costs are usable at compile time
+    static_assert(HOUSE_COST.total() == 5, "a house costs 2 glass and 3 heat");
+    static_assert(!ResourceBundle{}.canAfford(BASEMENT_COST), "an empty inventory cannot afford a basement");
+}
+
+TEST(ResourceBundle, AtRejectsPark) {
+    ResourceBundle bundle;
+    bundle.at(WIFI) = 2;
+    EXPECT_EQ(bundle[WIFI], 2);
+    EXPECT_THROW(bundle.at(PARK), std::out_of_range);
+}
+
+TEST(BuilderInventoryUpdate, DenseMatrix) {
+    BuilderInventoryUpdate update;
+    EXPECT_FALSE(update.changed());
+
+    update[2][HEAT] += 3;
+    EXPECT_TRUE(update.changed());
+
+    BuilderInventoryUpdate other;
+    other[2][HEAT] = 1;
+    other[0][BRICK] = 2;
+    update += other;
+    EXPECT_EQ(update[2][HEAT], 4);
+    EXPECT_EQ(update[0][BRICK], 2);
+    EXPECT_THROW(update[4], std::out_of_range);
+}
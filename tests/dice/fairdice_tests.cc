@@ -5,9 +5,20 @@
 
 TEST(FairDice, RollDice) {
     FairDice fairDice;
-    RandomEngine::setSeed(0);
+    RandomEngine rng{0};
 
-    EXPECT_EQ(fairDice.rollDice(0), 2);
-    EXPECT_EQ(fairDice.rollDice(0), 8);
-    EXPECT_EQ(fairDice.rollDice(0), 6);
+    EXPECT_EQ(fairDice.rollDice(0, rng), 9);
+    EXPECT_EQ(fairDice.rollDice(0, rng), 3);
+    EXPECT_EQ(fairDice.rollDice(0, rng), 3);
+}
+
+TEST(FairDice, RollsStayInRange) {
+    FairDice fairDice;
+    RandomEngine rng{1};
+
+    for (int i = 0; i < 1000; i++) {
+        int roll = fairDice.rollDice(0, rng);
+        EXPECT_GE(roll, 2);
+        EXPECT_LE(roll, 12);
+    }
 }
@@ -1,3 +1,4 @@
+#include "../../src/common/randomengine.h"
 #include "../../src/dice/dice.h"
 #include "../../src/dice/loadeddice.h"
 #include "../../src/game/builder.h"
@@ -5,15 +6,17 @@
 
 TEST(LoadedDice, RollDice) {
     LoadedDice loadedDice;
+    RandomEngine rng{0};
 
-    EXPECT_EQ(loadedDice.rollDice(2), 2);
-    EXPECT_EQ(loadedDice.rollDice(5), 5);
-    EXPECT_EQ(loadedDice.rollDice(6), 6);
+    EXPECT_EQ(loadedDice.rollDice(2, rng), 2);
+    EXPECT_EQ(loadedDice.rollDice(5, rng), 5);
+    EXPECT_EQ(loadedDice.rollDice(6, rng), 6);
 }
 
 TEST(LoadedDice, RollDiceWithBuilder) {
     Builder builder(1, 'B');
-    int roll = builder.rollDice(1);
+    RandomEngine rng{0};
+    int roll = builder.rollDice(1, rng);
 
     EXPECT_EQ(roll, 1);
 }
@@ -0,0 +1,97 @@
+#include "../../src/board/board.h"
+#include "../../src/common/randomengine.h"
+#include "../../src/game/boardgenerator.h"
+#include "../../src/game/game.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+
+namespace {
+const std::array<TileMask, Topology::NUM_TILES> tileNeighbours = Topology::makeTileNeighbourMasks();
+
+bool neighbourMatches(const std::vector<TileInitData>& data, bool (*matches)(const TileInitData&, const TileInitData&)) {
+    for (int i = 0; i < Topology::NUM_TILES; i++) {
+        for (int j = 0; j < Topology::NUM_TILES; j++) {
+            if ((tileNeighbours[i] & tileBit(j)) && matches(data[i], data[j])) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool bothHot(const TileInitData& a, const TileInitData& b) {
+    return (a.tileValue == 6 || a.tileValue == 8) && (b.tileValue == 6 || b.tileValue == 8);
+}
+
+bool sameResource(const TileInitData& a, const TileInitData& b) {
+    return a.resource == b.resource;
+}
+}
+
+TEST(BoardGenerator, BoardsMeetTheConstraints) {
+    BoardGenerator generator;
+    RandomEngine rng{5};
+    std::vector<TileInitData> reference = Game::generateRandomBoard(rng);
+
+    for (int i = 0; i < 20; i++) {
+        std::vector<TileInitData> data = generator.generate(rng);
+        EXPECT_TRUE(generator.isSatisfiedBy(data));
+        EXPECT_FALSE(neighbourMatches(data, bothHot));
+        for (const TileInitData& tile : data) {
+            EXPECT_EQ(tile.resource == PARK, tile.tileValue == 7);
+        }
+
+        // Same values and resources as an unconstrained board, just rearranged
+        EXPECT_TRUE(std::is_permutation(data.begin(), data.end(), reference.begin(), [](const TileInitData& a, const TileInitData& b) { return a.tileValue == b.tileValue; }));
+        EXPECT_TRUE(std::is_permutation(data.begin(), data.end(), reference.begin(), [](const TileInitData& a, const TileInitData& b) { return a.resource == b.resource; }));
+    }
+}
+
+TEST(BoardGenerator, UnconstrainedBoardsAreNeverRejected) {
+    BoardGenerator generator{BoardConstraints{false, 0, -1}};
+    GeneratedBoards results = generator.generateMany(50, 3, 2);
+    EXPECT_EQ(results.attempts, 50);
+    for (const std::vector<TileInitData>& data : results.boards) {
+        EXPECT_TRUE(generator.isSatisfiedBy(data));
+    }
+}
+
+TEST(BoardGenerator, FullCheckAgreesWithNeighbourScan) {
+    BoardGenerator unconstrained{BoardConstraints{false, 0, -1}};
+    BoardGenerator hotValues{BoardConstraints{true, 0, -1}};
+    BoardGenerator noClusters{BoardConstraints{false, 1, -1}};
+    RandomEngine rng{11};
+
+    for (int i = 0; i < 200; i++) {
+        std::vector<TileInitData> data = unconstrained.generate(rng);
+        EXPECT_EQ(hotValues.isSatisfiedBy(data), !neighbourMatches(data, bothHot));
+        EXPECT_EQ(noClusters.isSatisfiedBy(data), !neighbourMatches(data, sameResource));
+    }
+    EXPECT_FALSE(unconstrained.isSatisfiedBy(std::vector<TileInitData>(3, TileInitData{7, PARK})));
+}
+
+TEST(BoardGenerator, BatchesDoNotDependOnThreadCount) {
+    BoardGenerator generator;
+    GeneratedBoards single = generator.generateMany(12, 9, 1);
+    GeneratedBoards parallel = generator.generateMany(12, 9, 4);
+
+    EXPECT_EQ(single.attempts, parallel.attempts);
+    ASSERT_EQ(parallel.boards.size(), 12u);
+    for (int i = 0; i < 12; i++) {
+        // Board i comes from stream i of the seed
+        RandomEngine rng{9, static_cast<uint64_t>(i)};
+        std::vector<TileInitData> expected = generator.generate(rng);
+        for (int j = 0; j < Topology::NUM_TILES; j++) {
+            EXPECT_EQ(single.boards[i][j].tileValue, expected[j].tileValue);
+            EXPECT_EQ(parallel.boards[i][j].tileValue, expected[j].tileValue);
+            EXPECT_EQ(parallel.boards[i][j].resource, expected[j].resource);
+        }
+    }
+}
+
+TEST(BoardGenerator, RejectsNegativeConstraints) {
+    BoardConstraints negativeCluster{true, -1, 3};
+    BoardConstraints negativeDeviation{true, 2, -2};
+    EXPECT_THROW(BoardGenerator{negativeCluster}, std::invalid_argument);
+    EXPECT_THROW(BoardGenerator{negativeDeviation}, std::invalid_argument);
+}
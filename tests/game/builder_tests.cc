@@ -1,9 +1,9 @@
 #include "../../src/board/edge.h"
+#include "../../src/board/vertex.h"
 #include "../../src/game/builder.h"
-#include "../../src/structures/basement.h"
-#include "../../src/structures/house.h"
-#include "../../src/structures/tower.h"
+#include "../../src/structures/residence.h"
 #include "gtest/gtest.h"
+#include <type_traits>
 
 TEST(Builder, GetBuilderNumber) {
     int builderNumber = 3;
@@ -37,21 +37,20 @@ TEST(Builder, GetBuildingPointsEmpty) {
 TEST(Builder, GetBuildingPointsNonEmpty) {
     Builder builder(2, 'Y');
 
-    Vertex location1(24);
-    Vertex location2(32);
-    Vertex location3(48);
-    std::shared_ptr<Basement> res1 = std::make_shared<Basement>(builder, location1);
-    std::shared_ptr<House> res2 = std::make_shared<House>(builder, location2);
-    std::shared_ptr<Tower> res3 = std::make_shared<Tower>(builder, location3);
+    Residence res1{builder.getBuilderNumber(), ResidenceLevel::BASEMENT};
+    Residence res2{builder.getBuilderNumber(), ResidenceLevel::HOUSE};
+    Residence res3{builder.getBuilderNumber(), ResidenceLevel::TOWER};
 
-    builder.residences.push_back(res1);
+    builder.addResidence(24, res1);
     EXPECT_EQ(builder.getBuildingPoints(), 1);
 
-    builder.residences.push_back(res2);
+    builder.addResidence(32, res2);
     EXPECT_EQ(builder.getBuildingPoints(), 3);
 
-    builder.residences.push_back(res3);
+    builder.addResidence(48, res3);
     EXPECT_EQ(builder.getBuildingPoints(), 6);
+    EXPECT_EQ(builder.residences.size(), 3u);
+    EXPECT_EQ(builder.residences[1], 32);
 }
 
 TEST(Builder, GetTotalResourceQuantity) {
@@ -69,9 +68,7 @@ TEST(Builder, GetTotalResourceQuantity) {
 TEST(Builder, GetStatus) {
     Builder builder(3, 'Y');
 
-    Vertex location(13);
-    std::shared_ptr<House> house = std::make_shared<House>(builder, location);
-    builder.residences.push_back(house);
+    builder.addResidence(13, Residence{builder.getBuilderNumber(), ResidenceLevel::HOUSE});
 
     builder.inventory.at(BRICK) = 2;
     builder.inventory.at(ENERGY) = 5;
@@ -93,26 +90,6 @@ TEST(Builder, GetHasLoadedDice) {
     EXPECT_EQ(builder.getHasLoadedDice(), true);
 }
 
-TEST(Builder, ChooseGeeseSpot) {
-    Builder builder(3, 'Y');
-    std::istringstream in("14");
-    std::ostringstream out;
-
-    int geeseSpot = builder.chooseGeeseSpot(in, out);
-    EXPECT_EQ(out.str(), "Choose where to place the GEESE.\n");
-    EXPECT_EQ(geeseSpot, 14);
-}
-
-TEST(Builder, Steal) {
-    Builder builder(2, 'G');
-    std::istringstream in("B");
-    std::ostringstream out;
-
-    char stealFrom = builder.steal(in, out);
-    EXPECT_EQ(out.str(), "Choose a builder to steal from.\n");
-    EXPECT_EQ(stealFrom, 'B');
-}
-
 TEST(Builder, ProposeTrade) {
     Builder builder(1, 'Y');
     std::ostringstream out;
@@ -147,9 +124,9 @@ TEST(Builder, RespondToTradeWithYes) {
 TEST(Builder, TryBuildRoadWithInsufficientResources) {
     Builder builder(2, 'Y');
     Edge edge(27);
-    std::shared_ptr<Road> road = builder.tryBuildRoad(edge);
-    
-    EXPECT_EQ(road, nullptr);
+
+    EXPECT_FALSE(builder.tryBuildRoad(edge));
+    EXPECT_TRUE(builder.roads.empty());
 }
 
 
@@ -159,9 +136,10 @@ TEST(Builder, TryBuildRoadWithSufficientResources) {
     builder.inventory[WIFI] = 4;
 
     Edge edge(27);
-    std::shared_ptr<Road> road = builder.tryBuildRoad(edge);
 
-    EXPECT_NE(road, nullptr);
+    EXPECT_TRUE(builder.tryBuildRoad(edge));
+    EXPECT_EQ(builder.roads.size(), 1u);
+    EXPECT_EQ(builder.roads[0], 27);
     EXPECT_EQ(builder.inventory[HEAT], 2);
     EXPECT_EQ(builder.inventory[WIFI], 3);
 }
@@ -169,9 +147,9 @@ TEST(Builder, TryBuildRoadWithSufficientResources) {
 TEST(Builder, TryBuildResidenceWithInsufficientResources) {
     Builder builder(3, 'Y');
     Vertex vertex(46);
-    std::shared_ptr<Residence> residence = builder.tryBuildResidence(vertex);
 
-    EXPECT_EQ(residence, nullptr);
+    EXPECT_FALSE(builder.tryBuildResidence(vertex));
+    EXPECT_TRUE(builder.residences.empty());
 }
 
 TEST(Builder, TryBuildResidenceWithSufficientResources) {
@@ -182,10 +160,10 @@ TEST(Builder, TryBuildResidenceWithSufficientResources) {
     builder.inventory[WIFI] = 5;
 
     Vertex vertex(46);
-    std::shared_ptr<Residence> residence = builder.tryBuildResidence(vertex);
 
-    EXPECT_NE(residence, nullptr);
-    EXPECT_EQ(residence.get()->getResidenceLetter(), 'B');
+    EXPECT_TRUE(builder.tryBuildResidence(vertex));
+    EXPECT_EQ(builder.residences[0], 46);
+    EXPECT_EQ(builder.getBuildingPoints(), 1);
 
     EXPECT_EQ(builder.inventory[BRICK], 1);
     EXPECT_EQ(builder.inventory[ENERGY], 2);
@@ -196,19 +174,20 @@ TEST(Builder, TryBuildResidenceWithSufficientResources) {
 TEST(Builder, TryBuildInitialResidence) {
     Builder builder(2, 'G');
     Vertex vertex(33);
-    std::shared_ptr<Residence> residence = builder.tryBuildInitialResidence(vertex);
 
-    EXPECT_NE(residence, nullptr);
-    EXPECT_EQ(residence.get()->getResidenceLetter(), 'B');
+    EXPECT_TRUE(builder.tryBuildInitialResidence(vertex));
+    EXPECT_EQ(builder.residences[0], 33);
+    EXPECT_EQ(builder.getBuildingPoints(), 1);
 }
 
 TEST(Builder, TryUpgradeToHouseWithInsufficientResources) {
     Builder builder(1, 'B');
     Vertex vertex(34);
-    vertex.buildResidence(builder.tryBuildInitialResidence(vertex));
-    std::shared_ptr<Residence> residence = builder.tryUpgradeResidence(vertex);
+    builder.tryBuildInitialResidence(vertex);
+    vertex.buildResidence(Residence{builder.getBuilderNumber()});
 
-    EXPECT_EQ(residence, nullptr);
+    EXPECT_FALSE(builder.tryUpgradeResidence(vertex));
+    EXPECT_EQ(builder.getBuildingPoints(), 1);
 }
 
 TEST(Builder, TryUpgradeToHouseWithSufficientResources) {
@@ -217,11 +196,11 @@ TEST(Builder, TryUpgradeToHouseWithSufficientResources) {
     builder.inventory[HEAT] = 8;
 
     Vertex vertex(34);
-    vertex.buildResidence(builder.tryBuildInitialResidence(vertex));
-    std::shared_ptr<Residence> residence = builder.tryUpgradeResidence(vertex);
+    builder.tryBuildInitialResidence(vertex);
+    vertex.buildResidence(Residence{builder.getBuilderNumber()});
 
-    EXPECT_NE(residence, nullptr);
-    EXPECT_EQ(residence.get()->getResidenceLetter(), 'H');
+    EXPECT_TRUE(builder.tryUpgradeResidence(vertex));
+    EXPECT_EQ(builder.getBuildingPoints(), 2);
 
     EXPECT_EQ(builder.inventory[GLASS], 6);
     EXPECT_EQ(builder.inventory[HEAT], 5);
@@ -233,11 +212,13 @@ TEST(Builder, TryUpgradeToTowerWithInsufficientResources) {
     builder.inventory[HEAT] = 3;
 
     Vertex vertex(34);
-    vertex.buildResidence(builder.tryBuildInitialResidence(vertex));
-    vertex.buildResidence(builder.tryUpgradeResidence(vertex));
-    std::shared_ptr<Residence> residence = builder.tryUpgradeResidence(vertex);
+    builder.tryBuildInitialResidence(vertex);
+    vertex.buildResidence(Residence{builder.getBuilderNumber()});
+    builder.tryUpgradeResidence(vertex);
+    vertex.upgradeResidence();
 
-    EXPECT_EQ(residence, nullptr);
+    EXPECT_FALSE(builder.tryUpgradeResidence(vertex));
+    EXPECT_EQ(builder.getBuildingPoints(), 2);
 }
 
 TEST(Builder, TryUpgradeToTowerWithSufficientResources) {
@@ -249,12 +230,13 @@ TEST(Builder, TryUpgradeToTowerWithSufficientResources) {
     builder.inventory[WIFI] = 18;
 
     Vertex vertex(34);
-    vertex.buildResidence(builder.tryBuildInitialResidence(vertex));
-    vertex.buildResidence(builder.tryUpgradeResidence(vertex));
-    std::shared_ptr<Residence> residence = builder.tryUpgradeResidence(vertex);
+    builder.tryBuildInitialResidence(vertex);
+    vertex.buildResidence(Residence{builder.getBuilderNumber()});
+    builder.tryUpgradeResidence(vertex);
+    vertex.upgradeResidence();
 
-    EXPECT_NE(residence, nullptr);
-    EXPECT_EQ(residence.get()->getResidenceLetter(), 'T');
+    EXPECT_TRUE(builder.tryUpgradeResidence(vertex));
+    EXPECT_EQ(builder.getBuildingPoints(), 3);
 
     EXPECT_EQ(builder.inventory[BRICK], 15);
     EXPECT_EQ(builder.inventory[ENERGY], 16);
@@ -263,7 +245,7 @@ TEST(Builder, TryUpgradeToTowerWithSufficientResources) {
     EXPECT_EQ(builder.inventory[WIFI], 17);
 }
 
-TEST(Builder, TryUpgradePastTowerReturnsNullptr) {
+TEST(Builder, TryUpgradePastTowerFails) {
     Builder builder(1, 'B');
     builder.inventory[BRICK] = 18;
     builder.inventory[ENERGY] = 18;
@@ -272,10 +254,45 @@ TEST(Builder, TryUpgradePastTowerReturnsNullptr) {
     builder.inventory[WIFI] = 18;
 
     Vertex vertex(34);
+    vertex.buildResidence(Residence{builder.getBuilderNumber(), ResidenceLevel::TOWER});
+
+    EXPECT_FALSE(builder.tryUpgradeResidence(vertex));
+    EXPECT_EQ(builder.inventory[BRICK], 18);
+}
+
+TEST(Builder, RestoreRewindsToSnapshot) {
+    Builder builder(1, 'R');
+    builder.inventory[HEAT] = 3;
+    builder.inventory[WIFI] = 3;
+    Vertex vertex(12);
+    Edge edge(20);
     builder.tryBuildInitialResidence(vertex);
-    builder.tryUpgradeResidence(vertex);
-    builder.tryUpgradeResidence(vertex);
-    std::shared_ptr<Residence> residence = builder.tryUpgradeResidence(vertex);
 
-    EXPECT_EQ(residence, nullptr);
+    BuilderSnapshot snapshot = builder.snapshot();
+    Builder before(builder);
+
+    builder.tryBuildRoad(edge);
+    builder.setDice(false);
+    builder.restore(snapshot);
+
+    EXPECT_EQ(builder, before);
+    EXPECT_EQ(builder.getBuildingPoints(), 1);
+    EXPECT_TRUE(builder.getHasLoadedDice());
+    EXPECT_TRUE(std::is_trivially_copyable<BuilderSnapshot>::value);
+}
+
+TEST(Builder, CopyDoesNotAliasOriginal) {
+    Builder builder(1, 'R');
+    builder.inventory[HEAT] = 3;
+    builder.inventory[WIFI] = 3;
+
+    Builder copy(builder);
+    Edge edge(20);
+    copy.tryBuildRoad(edge);
+    copy.setDice(false);
+
+    EXPECT_TRUE(builder.roads.empty());
+    EXPECT_EQ(builder.inventory[HEAT], 3);
+    EXPECT_TRUE(builder.getHasLoadedDice());
+    EXPECT_FALSE(copy.getHasLoadedDice());
 }
@@ -0,0 +1,60 @@
+#include "../../src/game/commandreader.h"
+#include "gtest/gtest.h"
+#include <iterator>
+#include <sstream>
+#include <string>
+
+TEST(CommandReader, ReadsWordsLikeExtraction) {
+    std::istringstream in{"  build-road 12\n\tnext  "};
+    CommandReader reader{in};
+    std::string_view word;
+    int number;
+
+    ASSERT_TRUE(reader.readWord(word));
+    EXPECT_EQ(word, "build-road");
+    ASSERT_TRUE(reader.readInt(number));
+    EXPECT_EQ(number, 12);
+    ASSERT_TRUE(reader.readWord(word));
+    EXPECT_EQ(word, "next");
+    EXPECT_FALSE(in.eof());
+
+    EXPECT_FALSE(reader.readWord(word));
+    EXPECT_TRUE(in.eof());
+    EXPECT_TRUE(in.fail());
+}
+
+TEST(CommandReader, MatchesExtractionOnNumbers) {
+    for (const char* input : {"12abc", "+5", "-7 ", "-", "+-3", "abc", "99999999999", "0012", ""}) {
+        std::istringstream expectedIn{input};
+        int expected = 0;
+        expectedIn >> expected;
+        std::string expectedRest{std::istreambuf_iterator<char>{expectedIn.rdbuf()}, {}};
+
+        std::istringstream in{input};
+        CommandReader reader{in};
+        int actual = 0;
+        reader.readInt(actual);
+        std::string rest{std::istreambuf_iterator<char>{in.rdbuf()}, {}};
+
+        EXPECT_EQ(in.fail(), expectedIn.fail()) << input;
+        EXPECT_EQ(in.eof(), expectedIn.eof()) << input;
+        EXPECT_EQ(rest, expectedRest) << input;
+        if (!expectedIn.fail()) {
+            EXPECT_EQ(actual, expected) << input;
+        }
+    }
+}
+
+TEST(CommandReader, NeverReadsAheadOfTheToken) {
+    std::istringstream in{"next\nyes please"};
+    CommandReader reader{in};
+    std::string_view word;
+    std::string answer;
+
+    ASSERT_TRUE(reader.readWord(word));
+    EXPECT_EQ(word, "next");
+    in >> answer;
+    EXPECT_EQ(answer, "yes");
+    ASSERT_TRUE(reader.readWord(word));
+    EXPECT_EQ(word, "please");
+}
@@ -0,0 +1,655 @@
+#include "../../src/common/inventoryupdate.h"
+#include "../../src/game/engine.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <type_traits>
+
+namespace {
+std::vector<TileInitData> engineTileInitData = {{3, BRICK}, {10, ENERGY}, {5, HEAT}, {4, ENERGY}, {7, PARK}, {10, HEAT}, {11, GLASS}, {3, BRICK}, {8, HEAT}, {2, BRICK}, {6, BRICK}, {8, ENERGY}, {12, WIFI}, {5, ENERGY}, {11, WIFI}, {4, GLASS}, {6, WIFI}, {9, GLASS}, {9, GLASS}};
+
+// Blue owns vertex 0 (tile 0), Red owns vertex 9 (tiles 0, 2 and 4), geese start on tile 4
+std::unique_ptr<Engine> makeLoadedEngine() {
+    std::vector<BuilderResourceData> resourceData = {{1, 1, 1, 1, 1}, {2, 0, 0, 0, 3}, {0, 0, 0, 0, 0}, {5, 5, 5, 5, 5}};
+    std::vector<BuilderStructureData> structureData = {{{{0, 'B'}}, {1}}, {{{9, 'H'}}, {}}, {{}, {}}, {{{40, 'B'}}, {}}};
+    return std::make_unique<Engine>(engineTileInitData, resourceData, structureData, 0, 4, RandomEngine{1});
+}
+
+// Ends the loaded engine's turn and rolls on behalf of the next builder
+void rollNextTurn(Engine& engine, int roll) {
+    engine.apply(Action{ActionType::END_TURN});
+    engine.apply(Action{ActionType::LOAD_DICE});
+    engine.apply(Action{ActionType::ROLL, roll});
+}
+
+// Everything observable about an engine, down to its next random number, for comparing states
+std::string describe(const Engine& engine) {
+    const Board& board = engine.getBoard();
+    std::ostringstream out;
+    board.printBoard(out);
+
+    for (int i = 0; i < Engine::NUM_BUILDERS; i++) {
+        const Builder& builder = engine.getBuilder(i);
+        out << builder.getStatus() << builder.getHasLoadedDice() << builder.residences.size() << builder.roads.size() << std::endl;
+        for (int edge = 0; edge < Board::NUM_EDGES; edge++) {
+            out << board.canBuildRoad(builder, edge);
+        }
+        for (int vertex = 0; vertex < Board::NUM_VERTICES; vertex++) {
+            out << board.canBuildResidence(builder, vertex);
+        }
+        out << std::endl;
+    }
+    for (int roll = 2; roll <= Board::MAX_ROLL; roll++) {
+        BuilderInventoryUpdate update = board.getResourcesFromDiceRoll(roll);
+        for (int i = 0; i < Engine::NUM_BUILDERS; i++) {
+            out << update[i].total() << ' ';
+        }
+    }
+
+    out << static_cast<int>(engine.getPhase()) << ' ' << engine.getCurrentBuilder() << ' ' << engine.getGeeseLocation() << ' ';
+    for (int candidate : engine.getStealCandidates()) {
+        out << candidate;
+    }
+    RandomEngine rng = engine.snapshot().rng;
+    out << ' ' << rng() << ' ' << engine.stateHash();
+    return out.str();
+}
+
+// Lowest-numbered location where check succeeds
+template <typename Check>
+int firstLegal(int count, Check check) {
+    for (int i = 0; i < count; i++) {
+        if (check(i)) {
+            return i;
+        }
+    }
+    return -1;
+}
+}
+
+TEST(Engine, InitialPlacementFollowsSnakeDraft) {
+    Engine engine(engineTileInitData, RandomEngine{1});
+    std::vector<int> vertices = {0, 10, 19, 29, 40, 48, 52, 33};
+    std::vector<int> expectedBuilders = {0, 1, 2, 3, 3, 2, 1, 0};
+
+    for (size_t i = 0; i < vertices.size(); i++) {
+        EXPECT_EQ(engine.getPhase(), TurnPhase::INITIAL_PLACEMENT);
+        EXPECT_EQ(engine.getCurrentBuilder(), expectedBuilders[i]);
+
+        const ActionResult& result = engine.apply(Action{ActionType::BUILD_INITIAL_RESIDENCE, vertices[i]});
+        EXPECT_EQ(result.status, ActionStatus::SUCCESS);
+        ASSERT_EQ(result.events.size(), i + 1 < vertices.size() ? 1u : 2u);
+        EXPECT_EQ(result.events[0].type, EventType::RESIDENCE_BUILT);
+        EXPECT_EQ(result.events[0].builder, expectedBuilders[i]);
+        EXPECT_EQ(result.events[0].target, vertices[i]);
+    }
+
+    // The last placement hands the first turn to Blue
+    EXPECT_EQ(engine.getPhase(), TurnPhase::PRE_ROLL);
+    EXPECT_EQ(engine.getCurrentBuilder(), 0);
+    EXPECT_EQ(engine.apply(Action{ActionType::BUILD_INITIAL_RESIDENCE, 5}).status, ActionStatus::INVALID_PHASE);
+}
+
+TEST(Engine, InitialPlacementRejectsInvalidVertices) {
+    Engine engine(engineTileInitData, RandomEngine{1});
+
+    EXPECT_EQ(engine.apply(Action{ActionType::BUILD_INITIAL_RESIDENCE, 54}).status, ActionStatus::INVALID_LOCATION);
+    EXPECT_EQ(engine.apply(Action{ActionType::BUILD_INITIAL_RESIDENCE, 0}).status, ActionStatus::SUCCESS);
+    EXPECT_EQ(engine.apply(Action{ActionType::BUILD_INITIAL_RESIDENCE, 1}).status, ActionStatus::CANNOT_BUILD);
+    EXPECT_EQ(engine.getCurrentBuilder(), 1);
+}
+
+TEST(Engine, RollDistributesResources) {
+    std::unique_ptr<Engine> engine = makeLoadedEngine();
+    engine->apply(Action{ActionType::END_TURN});
+    engine->apply(Action{ActionType::LOAD_DICE});
+
+    const ActionResult& result = engine->apply(Action{ActionType::ROLL, 3});
+    EXPECT_EQ(result.status, ActionStatus::SUCCESS);
+    ASSERT_EQ(result.events.size(), 3);
+    EXPECT_EQ(result.events[0].type, EventType::DICE_ROLLED);
+    EXPECT_EQ(result.events[0].amount, 3);
+
+    EXPECT_EQ(result.events[1].type, EventType::RESOURCES_GAINED);
+    EXPECT_EQ(result.events[1].builder, 0);
+    EXPECT_EQ(result.events[1].resource, BRICK);
+    EXPECT_EQ(result.events[1].amount, 1);
+
+    EXPECT_EQ(result.events[2].builder, 1);
+    EXPECT_EQ(result.events[2].amount, 2);
+
+    EXPECT_EQ(engine->getBuilder(0).inventory.at(BRICK), 2);
+    EXPECT_EQ(engine->getBuilder(1).inventory.at(BRICK), 4);
+    EXPECT_EQ(engine->getPhase(), TurnPhase::POST_ROLL);
+}
+
+TEST(Engine, LoadedRollOutsideRangeIsRejected) {
+    std::unique_ptr<Engine> engine = makeLoadedEngine();
+    engine->apply(Action{ActionType::END_TURN});
+    engine->apply(Action{ActionType::LOAD_DICE});
+
+    EXPECT_EQ(engine->apply(Action{ActionType::ROLL, 13}).status, ActionStatus::INVALID_ROLL);
+    EXPECT_EQ(engine->apply(Action{ActionType::ROLL, 1}).status, ActionStatus::INVALID_ROLL);
+    EXPECT_TRUE(engine->apply(Action{ActionType::ROLL, 1}).events.empty());
+    EXPECT_EQ(engine->getPhase(), TurnPhase::PRE_ROLL);
+}
+
+TEST(Engine, BuildReportsStatus) {
+    std::unique_ptr<Engine> engine = makeLoadedEngine();
+
+    EXPECT_EQ(engine->apply(Action{ActionType::BUILD_ROAD, 72}).status, ActionStatus::INVALID_LOCATION);
+    EXPECT_EQ(engine->apply(Action{ActionType::BUILD_ROAD, 71}).status, ActionStatus::CANNOT_BUILD);
+    EXPECT_EQ(engine->apply(Action{ActionType::BUILD_RESIDENCE, 3}).status, ActionStatus::CANNOT_BUILD);
+    EXPECT_EQ(engine->apply(Action{ActionType::IMPROVE, 9}).status, ActionStatus::CANNOT_BUILD);
+    EXPECT_EQ(engine->apply(Action{ActionType::IMPROVE, 0}).status, ActionStatus::INSUFFICIENT_RESOURCES);
+
+    const ActionResult& result = engine->apply(Action{ActionType::BUILD_ROAD, 3});
+    EXPECT_EQ(result.status, ActionStatus::SUCCESS);
+    ASSERT_EQ(result.events.size(), 1);
+    EXPECT_EQ(result.events[0].type, EventType::ROAD_BUILT);
+    EXPECT_EQ(result.events[0].target, 3);
+
+    EXPECT_EQ(engine->apply(Action{ActionType::BUILD_ROAD, 5}).status, ActionStatus::INSUFFICIENT_RESOURCES);
+}
+
+TEST(Engine, MoveGeeseAndSteal) {
+    std::unique_ptr<Engine> engine = makeLoadedEngine();
+    EXPECT_EQ(engine->apply(Action{ActionType::MOVE_GEESE, 0}).status, ActionStatus::INVALID_PHASE);
+
+    // Red rolls a 7; only Yellow holds 10 or more resources
+    engine->apply(Action{ActionType::END_TURN});
+    engine->apply(Action{ActionType::LOAD_DICE});
+    const ActionResult& rolled = engine->apply(Action{ActionType::ROLL, 7});
+    EXPECT_EQ(rolled.status, ActionStatus::SUCCESS);
+    for (size_t i = 1; i < rolled.events.size(); i++) {
+        EXPECT_EQ(rolled.events[i].type, EventType::RESOURCES_DISCARDED);
+        EXPECT_EQ(rolled.events[i].builder, 3);
+    }
+    EXPECT_EQ(engine->getBuilder(3).getTotalResourceQuantity(), 13);
+    EXPECT_EQ(engine->getPhase(), TurnPhase::GEESE_PLACEMENT);
+    EXPECT_EQ(engine->apply(Action{ActionType::END_TURN}).status, ActionStatus::INVALID_PHASE);
+
+    EXPECT_EQ(engine->apply(Action{ActionType::MOVE_GEESE, 4}).status, ActionStatus::INVALID_LOCATION);
+    EXPECT_EQ(engine->apply(Action{ActionType::MOVE_GEESE, 19}).status, ActionStatus::INVALID_LOCATION);
+
+    const ActionResult& moved = engine->apply(Action{ActionType::MOVE_GEESE, 0});
+    EXPECT_EQ(moved.status, ActionStatus::SUCCESS);
+    ASSERT_EQ(moved.events.size(), 2);
+    EXPECT_EQ(moved.events[0].type, EventType::GEESE_MOVED);
+    EXPECT_EQ(moved.events[1].type, EventType::STEAL_CANDIDATE);
+    EXPECT_EQ(moved.events[1].builder, 0);
+    EXPECT_EQ(engine->getGeeseLocation(), 0);
+    EXPECT_EQ(engine->getStealCandidates(), std::vector<int>{0});
+    EXPECT_EQ(engine->getPhase(), TurnPhase::STEAL);
+
+    EXPECT_EQ(engine->apply(Action{ActionType::STEAL, 3}).status, ActionStatus::INVALID_TARGET);
+
+    const ActionResult& stolen = engine->apply(Action{ActionType::STEAL, 0});
+    EXPECT_EQ(stolen.status, ActionStatus::SUCCESS);
+    ASSERT_EQ(stolen.events.size(), 1);
+    EXPECT_EQ(stolen.events[0].type, EventType::RESOURCE_STOLEN);
+    EXPECT_EQ(stolen.events[0].target, 0);
+    EXPECT_EQ(engine->getBuilder(0).getTotalResourceQuantity(), 4);
+    EXPECT_EQ(engine->getBuilder(1).getTotalResourceQuantity(), 6);
+
+    // Only one steal per geese move
+    EXPECT_EQ(engine->getPhase(), TurnPhase::POST_ROLL);
+    EXPECT_EQ(engine->apply(Action{ActionType::STEAL, 0}).status, ActionStatus::INVALID_PHASE);
+}
+
+TEST(Engine, MoveGeeseWithoutCandidatesSkipsSteal) {
+    std::unique_ptr<Engine> engine = makeLoadedEngine();
+    rollNextTurn(*engine, 7);
+
+    const ActionResult& moved = engine->apply(Action{ActionType::MOVE_GEESE, 18});
+    EXPECT_EQ(moved.status, ActionStatus::SUCCESS);
+    EXPECT_EQ(moved.events.size(), 1);
+    EXPECT_EQ(engine->getPhase(), TurnPhase::POST_ROLL);
+}
+
+TEST(Engine, ActionsOutsideTheirPhaseAreRejected) {
+    Engine engine(engineTileInitData, RandomEngine{1});
+    EXPECT_EQ(engine.apply(Action{ActionType::ROLL}).status, ActionStatus::INVALID_PHASE);
+    EXPECT_EQ(engine.apply(Action{ActionType::END_TURN}).status, ActionStatus::INVALID_PHASE);
+
+    std::unique_ptr<Engine> loaded = makeLoadedEngine();
+    EXPECT_EQ(loaded->getPhase(), TurnPhase::POST_ROLL);
+    EXPECT_EQ(loaded->apply(Action{ActionType::ROLL, 3}).status, ActionStatus::INVALID_PHASE);
+    EXPECT_EQ(loaded->apply(Action{ActionType::LOAD_DICE}).status, ActionStatus::INVALID_PHASE);
+
+    loaded->apply(Action{ActionType::END_TURN});
+    EXPECT_EQ(loaded->getPhase(), TurnPhase::PRE_ROLL);
+    EXPECT_EQ(loaded->apply(Action{ActionType::BUILD_ROAD, 3}).status, ActionStatus::INVALID_PHASE);
+    EXPECT_EQ(loaded->apply(Action{ActionType::END_TURN}).status, ActionStatus::INVALID_PHASE);
+}
+
+TEST(Engine, ReachingTenPointsEndsTheGame) {
+    // Yellow holds 2 towers, a house and a basement worth 9 points between them
+    std::vector<BuilderResourceData> resourceData = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0}, {0, 0, 0, 0, 0}, {5, 5, 5, 5, 5}};
+    std::vector<BuilderStructureData> structureData = {{{}, {}}, {{}, {}}, {{}, {}}, {{{0, 'T'}, {10, 'T'}, {19, 'H'}, {40, 'B'}}, {}}};
+    Engine engine(engineTileInitData, resourceData, structureData, 3, 4, RandomEngine{1});
+    EXPECT_EQ(engine.getPhase(), TurnPhase::POST_ROLL);
+
+    const ActionResult& result = engine.apply(Action{ActionType::IMPROVE, 40});
+    EXPECT_EQ(result.status, ActionStatus::SUCCESS);
+    ASSERT_EQ(result.events.size(), 2);
+    EXPECT_EQ(result.events[1].type, EventType::GAME_WON);
+    EXPECT_EQ(result.events[1].builder, 3);
+
+    EXPECT_EQ(engine.getPhase(), TurnPhase::GAME_OVER);
+    EXPECT_EQ(engine.apply(Action{ActionType::END_TURN}).status, ActionStatus::INVALID_PHASE);
+
+    // Saved games that have already been won start over
+    structureData[3].residences[3].second = 'H';
+    Engine won(engineTileInitData, resourceData, structureData, 3, 4, RandomEngine{1});
+    EXPECT_EQ(won.getPhase(), TurnPhase::GAME_OVER);
+    EXPECT_EQ(won.getWinner(), 3);
+}
+
+TEST(Engine, UndoingTheWinningBuildResumesTheGame) {
+    std::vector<BuilderResourceData> resourceData = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0}, {0, 0, 0, 0, 0}, {5, 5, 5, 5, 5}};
+    std::vector<BuilderStructureData> structureData = {{{}, {}}, {{}, {}}, {{}, {}}, {{{0, 'T'}, {10, 'T'}, {19, 'H'}, {40, 'B'}}, {}}};
+    Engine engine(engineTileInitData, resourceData, structureData, 3, 4, RandomEngine{1});
+    engine.setUndoEnabled(true);
+    EngineSnapshot beforeWin = engine.snapshot();
+    EXPECT_EQ(engine.getWinner(), -1);
+
+    engine.apply(Action{ActionType::IMPROVE, 40});
+    EXPECT_EQ(engine.getWinner(), 3);
+    EngineSnapshot won = engine.snapshot();
+
+    engine.undo();
+    EXPECT_EQ(engine.getWinner(), -1);
+    EXPECT_EQ(engine.getPhase(), TurnPhase::POST_ROLL);
+
+    engine.restore(won);
+    EXPECT_EQ(engine.getWinner(), 3);
+    EXPECT_EQ(engine.getPhase(), TurnPhase::GAME_OVER);
+    engine.restore(beforeWin);
+    EXPECT_EQ(engine.getWinner(), -1);
+    EXPECT_EQ(engine.getBuilder(3).getBuildingPoints(), 9);
+}
+
+TEST(Engine, TradeTransfersResources) {
+    std::unique_ptr<Engine> engine = makeLoadedEngine();
+
+    EXPECT_EQ(engine->apply(Action{ActionType::TRADE, 4, Trade{"", 1, BRICK, 1, WIFI}}).status, ActionStatus::INVALID_TARGET);
+    EXPECT_EQ(engine->apply(Action{ActionType::TRADE, 1, Trade{"", 2, BRICK, 1, WIFI}}).status, ActionStatus::INSUFFICIENT_RESOURCES);
+    EXPECT_EQ(engine->apply(Action{ActionType::TRADE, 1, Trade{"", 1, BRICK, 4, WIFI}}).status, ActionStatus::TARGET_INSUFFICIENT_RESOURCES);
+
+    const ActionResult& result = engine->apply(Action{ActionType::TRADE, 1, Trade{"", 1, GLASS, 3, WIFI}});
+    EXPECT_EQ(result.status, ActionStatus::SUCCESS);
+    EXPECT_EQ(result.events[0].type, EventType::TRADE_COMPLETED);
+
+    EXPECT_EQ(engine->getBuilder(0).inventory.at(GLASS), 0);
+    EXPECT_EQ(engine->getBuilder(0).inventory.at(WIFI), 4);
+    EXPECT_EQ(engine->getBuilder(1).inventory.at(GLASS), 1);
+    EXPECT_EQ(engine->getBuilder(1).inventory.at(WIFI), 0);
+}
+
+TEST(Engine, TradeRejectsAmountsBelowOne) {
+    std::unique_ptr<Engine> engine = makeLoadedEngine();
+    ResourceBundle before = engine->getBuilder(0).inventory;
+    ResourceBundle proposeeBefore = engine->getBuilder(1).inventory;
+
+    // A negative amount would otherwise move resources the other way without checking who can afford them
+    EXPECT_EQ(engine->apply(Action{ActionType::TRADE, 1, Trade{"", -3, WIFI, 0, BRICK}}).status, ActionStatus::INVALID_AMOUNT);
+    EXPECT_EQ(engine->apply(Action{ActionType::TRADE, 1, Trade{"", 1, GLASS, -3, WIFI}}).status, ActionStatus::INVALID_AMOUNT);
+    EXPECT_EQ(engine->apply(Action{ActionType::TRADE, 1, Trade{"", 0, GLASS, 1, WIFI}}).status, ActionStatus::INVALID_AMOUNT);
+    EXPECT_EQ(engine->apply(Action{ActionType::TRADE, 1, Trade{"", 1, GLASS, 0, WIFI}}).status, ActionStatus::INVALID_AMOUNT);
+
+    EXPECT_EQ(engine->getBuilder(0).inventory, before);
+    EXPECT_EQ(engine->getBuilder(1).inventory, proposeeBefore);
+}
+
+TEST(Engine, EndTurnWrapsAround) {
+    std::unique_ptr<Engine> engine = makeLoadedEngine();
+
+    for (int i = 1; i <= 4; i++) {
+        const ActionResult& result = engine->apply(Action{ActionType::END_TURN});
+        EXPECT_EQ(result.events[0].type, EventType::TURN_BEGAN);
+        EXPECT_EQ(result.events[0].builder, i % 4);
+        EXPECT_EQ(engine->getCurrentBuilder(), i % 4);
+        EXPECT_EQ(engine->getPhase(), TurnPhase::PRE_ROLL);
+
+        engine->apply(Action{ActionType::LOAD_DICE});
+        engine->apply(Action{ActionType::ROLL, 3});
+    }
+}
+
+TEST(Engine, CloneDoesNotAliasOriginal) {
+    std::unique_ptr<Engine> engine = makeLoadedEngine();
+    engine->apply(Action{ActionType::END_TURN});
+    engine->apply(Action{ActionType::FAIR_DICE});
+
+    Engine clone(*engine);
+    EXPECT_NE(&clone.getBoard(), &engine->getBoard());
+    EXPECT_NE(&clone.getBuilder(1), &engine->getBuilder(1));
+
+    std::ostringstream before;
+    engine->getBoard().printBoard(before);
+
+    // The clone plays on without touching the original
+    int cloneRoll = clone.apply(Action{ActionType::ROLL}).events.at(0).amount;
+    clone.restore(makeLoadedEngine()->snapshot());
+    EXPECT_EQ(clone.apply(Action{ActionType::BUILD_ROAD, 0}).status, ActionStatus::SUCCESS);
+
+    std::ostringstream after;
+    engine->getBoard().printBoard(after);
+    EXPECT_EQ(after.str(), before.str());
+    EXPECT_EQ(engine->getCurrentBuilder(), 1);
+    EXPECT_EQ(engine->getPhase(), TurnPhase::PRE_ROLL);
+    EXPECT_EQ(engine->getBuilder(0).getTotalResourceQuantity(), 5);
+    EXPECT_FALSE(engine->getBuilder(1).getHasLoadedDice());
+
+    // Each copy has its own random stream, starting from where the original was
+    EXPECT_EQ(engine->apply(Action{ActionType::ROLL}).events.at(0).amount, cloneRoll);
+}
+
+TEST(Engine, RestoreRewindsToSnapshot) {
+    std::unique_ptr<Engine> engine = makeLoadedEngine();
+    EngineSnapshot snapshot = engine->snapshot();
+    std::ostringstream before;
+    engine->getBoard().printBoard(before);
+
+    EXPECT_EQ(engine->apply(Action{ActionType::BUILD_ROAD, 0}).status, ActionStatus::SUCCESS);
+    engine->apply(Action{ActionType::END_TURN});
+    engine->apply(Action{ActionType::FAIR_DICE});
+    int firstRoll = engine->apply(Action{ActionType::ROLL}).events.at(0).amount;
+
+    engine->restore(snapshot);
+    std::ostringstream after;
+    engine->getBoard().printBoard(after);
+    EXPECT_EQ(after.str(), before.str());
+    EXPECT_EQ(engine->getCurrentBuilder(), 0);
+    EXPECT_EQ(engine->getPhase(), TurnPhase::POST_ROLL);
+    EXPECT_EQ(engine->getBuilder(0).getTotalResourceQuantity(), 5);
+    EXPECT_EQ(engine->getBuilder(0).roads.size(), 1u);
+    EXPECT_TRUE(engine->getBuilder(1).getHasLoadedDice());
+
+    // Replaying the same actions draws the same rolls
+    engine->apply(Action{ActionType::BUILD_ROAD, 0});
+    engine->apply(Action{ActionType::END_TURN});
+    engine->apply(Action{ActionType::FAIR_DICE});
+    EXPECT_EQ(engine->apply(Action{ActionType::ROLL}).events.at(0).amount, firstRoll);
+
+    EXPECT_TRUE(std::is_trivially_copyable<EngineSnapshot>::value);
+}
+
+TEST(Engine, UndoReversesEveryAction) {
+    std::unique_ptr<Engine> engine = makeLoadedEngine();
+    engine->setUndoEnabled(true);
+    std::vector<std::string> states = {describe(*engine)};
+    auto play = [&](const Action& action) {
+        ASSERT_EQ(engine->apply(action).status, ActionStatus::SUCCESS);
+        states.push_back(describe(*engine));
+    };
+
+    // Failed actions change nothing, so they leave nothing to undo
+    EXPECT_EQ(engine->apply(Action{ActionType::BUILD_ROAD, 5}).status, ActionStatus::CANNOT_BUILD);
+    EXPECT_FALSE(engine->canUndo());
+
+    play(Action{ActionType::BUILD_ROAD, 0});
+    play(Action{ActionType::TRADE, 1, Trade{"", 1, GLASS, 1, WIFI}});
+    play(Action{ActionType::END_TURN});
+    play(Action{ActionType::LOAD_DICE});
+    play(Action{ActionType::ROLL, 3});
+    play(Action{ActionType::END_TURN});
+    play(Action{ActionType::FAIR_DICE});
+    play(Action{ActionType::ROLL});
+    if (engine->getPhase() == TurnPhase::GEESE_PLACEMENT) {
+        play(Action{ActionType::MOVE_GEESE, 18});
+    }
+    play(Action{ActionType::END_TURN});
+    play(Action{ActionType::LOAD_DICE});
+    play(Action{ActionType::ROLL, 3});
+
+    // Yellow upgrades its basement, then builds out two roads to a new basement
+    const Board& board = engine->getBoard();
+    const Builder& yellow = engine->getBuilder(3);
+    play(Action{ActionType::IMPROVE, 40});
+    for (int i = 0; i < 2; i++) {
+        play(Action{ActionType::BUILD_ROAD, firstLegal(Board::NUM_EDGES, [&](int edge) { return board.canBuildRoad(yellow, edge); })});
+    }
+    play(Action{ActionType::BUILD_RESIDENCE, firstLegal(Board::NUM_VERTICES, [&](int vertex) { return board.canBuildResidence(yellow, vertex); })});
+
+    // Blue rolls a 7, sends the geese to tile 0 and steals from Red
+    play(Action{ActionType::END_TURN});
+    play(Action{ActionType::LOAD_DICE});
+    play(Action{ActionType::ROLL, 7});
+    play(Action{ActionType::MOVE_GEESE, 0});
+    play(Action{ActionType::STEAL, 1});
+    if (HasFatalFailure()) {
+        return;
+    }
+
+    // Unwinding passes back through every earlier state, random stream included
+    for (size_t i = states.size() - 1; i > 0; i--) {
+        ASSERT_TRUE(engine->canUndo());
+        engine->undo();
+        EXPECT_EQ(describe(*engine), states[i - 1]);
+    }
+    EXPECT_FALSE(engine->canUndo());
+    EXPECT_THROW(engine->undo(), std::logic_error);
+}
+
+TEST(Engine, UndoInitialPlacement) {
+    Engine engine(engineTileInitData, RandomEngine{1});
+    engine.setUndoEnabled(true);
+    std::string start = describe(engine);
+
+    std::vector<int> vertices = {0, 10, 19, 29, 40, 48, 52, 33};
+    for (int vertex : vertices) {
+        engine.apply(Action{ActionType::BUILD_INITIAL_RESIDENCE, vertex});
+    }
+    std::string placed = describe(engine);
+    EXPECT_EQ(engine.getPhase(), TurnPhase::PRE_ROLL);
+
+    // Undoing the last placement hands it back to Blue, who may choose differently
+    engine.undo();
+    EXPECT_EQ(engine.getPhase(), TurnPhase::INITIAL_PLACEMENT);
+    EXPECT_EQ(engine.getCurrentBuilder(), 0);
+    EXPECT_TRUE(engine.getBoard().canBuildInitialResidence(33));
+    engine.apply(Action{ActionType::BUILD_INITIAL_RESIDENCE, 33});
+    EXPECT_EQ(describe(engine), placed);
+
+    while (engine.canUndo()) {
+        engine.undo();
+    }
+    EXPECT_EQ(describe(engine), start);
+
+    // Restoring a snapshot, or turning the journal off, discards it
+    engine.apply(Action{ActionType::BUILD_INITIAL_RESIDENCE, 0});
+    engine.restore(engine.snapshot());
+    EXPECT_FALSE(engine.canUndo());
+    engine.apply(Action{ActionType::BUILD_INITIAL_RESIDENCE, 10});
+    engine.setUndoEnabled(false);
+    EXPECT_FALSE(engine.canUndo());
+    engine.apply(Action{ActionType::BUILD_INITIAL_RESIDENCE, 19});
+    EXPECT_FALSE(engine.canUndo());
+}
+
+TEST(Engine, GenerateLegalActionsMatchesTrialAndError) {
+    Engine engine(engineTileInitData, RandomEngine{3});
+    engine.setUndoEnabled(true);
+    LegalActions actions;
+    int buildsSeen = 0;
+
+    // Succeeds if applying the action would, leaving the engine as it was
+    auto succeeds = [&](const Action& action) {
+        if (engine.apply(action).status != ActionStatus::SUCCESS) {
+            return false;
+        }
+        engine.undo();
+        return true;
+    };
+
+    for (int step = 0; step < 120 && engine.getPhase() != TurnPhase::GAME_OVER; step++) {
+        engine.generateLegalActions(actions);
+        ASSERT_FALSE(actions.empty());
+
+        std::vector<std::pair<ActionType, int>> generated;
+        for (const Action& action : actions) {
+            EXPECT_TRUE(succeeds(action));
+            generated.emplace_back(action.type, action.target);
+            buildsSeen += action.type == ActionType::BUILD_ROAD || action.type == ActionType::BUILD_RESIDENCE || action.type == ActionType::IMPROVE;
+        }
+
+        // Every other one-for-one trade, and every other target of every other action, fails
+        std::vector<std::pair<ActionType, int>> expected;
+        for (int type = 0; type <= static_cast<int>(ActionType::END_TURN); type++) {
+            ActionType actionType = static_cast<ActionType>(type);
+            for (int target = -1; target < Board::NUM_EDGES; target++) {
+                // Untargeted actions ignore their target, so only the default one counts
+                bool fairRoll = actionType == ActionType::ROLL && !engine.getBuilder(engine.getCurrentBuilder()).getHasLoadedDice();
+                bool untargeted = fairRoll || actionType == ActionType::LOAD_DICE || actionType == ActionType::FAIR_DICE || actionType == ActionType::END_TURN;
+                if (actionType == ActionType::TRADE || (untargeted && target != -1)) {
+                    continue;
+                }
+                if (succeeds(Action{actionType, target})) {
+                    expected.emplace_back(actionType, target);
+                }
+            }
+        }
+        for (int target = 0; target < Engine::NUM_BUILDERS; target++) {
+            // Trading with yourself is a no-op the generator leaves out
+            if (target == engine.getCurrentBuilder()) {
+                continue;
+            }
+            for (int give = 0; give < ResourceBundle::NUM_RESOURCES; give++) {
+                for (int take = 0; take < ResourceBundle::NUM_RESOURCES; take++) {
+                    if (give != take && succeeds(Action{ActionType::TRADE, target, Trade{"", 1, static_cast<Resource>(give), 1, static_cast<Resource>(take)}})) {
+                        expected.emplace_back(ActionType::TRADE, target);
+                    }
+                }
+            }
+        }
+        std::sort(generated.begin(), generated.end());
+        std::sort(expected.begin(), expected.end());
+        ASSERT_EQ(generated, expected);
+
+        // Wander through the game
+        engine.apply(actions[(7 * step) % actions.size()]);
+    }
+    EXPECT_GT(buildsSeen, 0);
+}
+
+namespace {
+// Red rolls a 7 on a fresh engine seeded with seed, against Blue holding blue and Yellow holding yellow
+std::unique_ptr<Engine> makeSevenEngine(uint64_t seed, BuilderResourceData blue, BuilderResourceData yellow) {
+    std::vector<BuilderResourceData> resourceData = {blue, {0, 0, 0, 0, 0}, {0, 0, 0, 0, 0}, yellow};
+    std::vector<BuilderStructureData> structureData = {{{{0, 'B'}}, {1}}, {{{9, 'H'}}, {}}, {{}, {}}, {{{40, 'B'}}, {}}};
+    std::unique_ptr<Engine> engine = std::make_unique<Engine>(engineTileInitData, resourceData, structureData, 0, 4, RandomEngine{seed});
+    rollNextTurn(*engine, 7);
+    return engine;
+}
+
+// Pearson's statistic for observed counts against expected probabilities
+double chiSquare(const std::vector<int>& observed, const std::vector<double>& expected, int trials) {
+    double statistic = 0;
+    for (size_t i = 0; i < observed.size(); i++) {
+        double expectedCount = expected[i] * trials;
+        statistic += (observed[i] - expectedCount) * (observed[i] - expectedCount) / expectedCount;
+    }
+    return statistic;
+}
+
+double choose(int n, int k) {
+    double result = 1;
+    for (int i = 1; i <= k; i++) {
+        result = result * (n - k + i) / i;
+    }
+    return result;
+}
+}
+
+TEST(Engine, StealPicksResourcesInProportionToCounts) {
+    const int trials = 4000;
+    std::vector<int> stolen(ResourceBundle::NUM_RESOURCES);
+
+    for (int seed = 0; seed < trials; seed++) {
+        std::unique_ptr<Engine> engine = makeSevenEngine(seed, {1, 2, 3, 4, 0}, {0, 0, 0, 0, 0});
+        engine->apply(Action{ActionType::MOVE_GEESE, 0});
+        const ActionResult& result = engine->apply(Action{ActionType::STEAL, 0});
+        ASSERT_EQ(result.status, ActionStatus::SUCCESS);
+        stolen[result.events.at(0).resource]++;
+    }
+
+    // Blue never holds WiFi, so it can never be stolen; 16.27 is the 0.1% critical value for 3 degrees of freedom
+    EXPECT_EQ(stolen[WIFI], 0);
+    stolen.pop_back();
+    EXPECT_LT(chiSquare(stolen, {0.1, 0.2, 0.3, 0.4}, trials), 16.27);
+}
+
+TEST(Engine, GeeseDiscardIsHypergeometric) {
+    const int trials = 4000;
+    BuilderResourceData yellow = {2, 4, 6, 8, 5};
+    std::vector<int> counts = {2, 4, 6, 8, 5};
+    const int total = 25;
+    const int discards = 12;
+
+    std::vector<double> meanDiscarded(ResourceBundle::NUM_RESOURCES);
+    std::vector<int> brickDiscarded(3);
+    for (int seed = 0; seed < trials; seed++) {
+        std::unique_ptr<Engine> engine = makeSevenEngine(seed, {1, 1, 1, 1, 1}, yellow);
+        ResourceBundle remaining = engine->getBuilder(3).inventory;
+        EXPECT_EQ(remaining.total(), total - discards);
+
+        for (int j = 0; j < ResourceBundle::NUM_RESOURCES; j++) {
+            int discarded = counts[j] - remaining[static_cast<Resource>(j)];
+            ASSERT_GE(discarded, 0);
+            meanDiscarded[j] += static_cast<double>(discarded) / trials;
+        }
+        brickDiscarded[counts[BRICK] - remaining[BRICK]]++;
+    }
+
+    // Each resource loses discards * count / total on average, to within four standard errors
+    for (int j = 0; j < ResourceBundle::NUM_RESOURCES; j++) {
+        double p = static_cast<double>(counts[j]) / total;
+        double variance = discards * p * (1 - p) * (total - discards) / (total - 1);
+        EXPECT_NEAR(meanDiscarded[j], discards * p, 4 * std::sqrt(variance / trials));
+    }
+
+    // The number of bricks lost follows the hypergeometric distribution; 13.82 is the 0.1% critical value for 2 degrees of freedom
+    std::vector<double> expected;
+    for (int x = 0; x <= counts[BRICK]; x++) {
+        expected.push_back(choose(counts[BRICK], x) * choose(total - counts[BRICK], discards - x) / choose(total, discards));
+    }
+    EXPECT_LT(chiSquare(brickDiscarded, expected, trials), 13.82);
+}
+
+TEST(Engine, LargeGeeseDiscardIsHypergeometric) {
+    const int trials = 2000;
+    BuilderResourceData yellow = {3, 197, 100, 120, 80};
+    std::vector<int> counts = {3, 197, 100, 120, 80};
+    const int total = 500;
+    const int discards = 250;
+
+    // More cards than the exact draws cover, so the discard falls back to one pick at a time
+    std::vector<double> meanDiscarded(ResourceBundle::NUM_RESOURCES);
+    std::vector<int> brickDiscarded(4);
+    for (int seed = 0; seed < trials; seed++) {
+        std::unique_ptr<Engine> engine = makeSevenEngine(seed, {1, 1, 1, 1, 1}, yellow);
+        ResourceBundle remaining = engine->getBuilder(3).inventory;
+        ASSERT_EQ(remaining.total(), total - discards);
+
+        for (int j = 0; j < ResourceBundle::NUM_RESOURCES; j++) {
+            meanDiscarded[j] += static_cast<double>(counts[j] - remaining[static_cast<Resource>(j)]) / trials;
+        }
+        brickDiscarded[counts[BRICK] - remaining[BRICK]]++;
+    }
+
+    for (int j = 0; j < ResourceBundle::NUM_RESOURCES; j++) {
+        double p = static_cast<double>(counts[j]) / total;
+        double variance = discards * p * (1 - p) * (total - discards) / (total - 1);
+        EXPECT_NEAR(meanDiscarded[j], discards * p, 4 * std::sqrt(variance / trials));
+    }
+
+    // 16.27 is the 0.1% critical value for 3 degrees of freedom
+    std::vector<double> expected;
+    for (int x = 0; x <= counts[BRICK]; x++) {
+        expected.push_back(choose(counts[BRICK], x) * choose(total - counts[BRICK], discards - x) / choose(total, discards));
+    }
+    EXPECT_LT(chiSquare(brickDiscarded, expected, trials), 16.27);
+}
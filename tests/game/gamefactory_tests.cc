@@ -1,10 +1,12 @@
 #include "../../src/game/game.h"
 #include "../../src/game/gamefactory.h"
+#include "../../src/game/outputsink.h"
 #include "gtest/gtest.h"
+#include <cstdio>
 #include <fstream>
 
 TEST(GameFactory, LoadFromGame) {
-    GameFactory gameFactory;
+    GameFactory gameFactory{1};
     std::unique_ptr<Game> game = gameFactory.loadFromGame("test_inputs/load_from_game.in");
     std::ostringstream out;
 
@@ -21,7 +23,7 @@ TEST(GameFactory, LoadFromGame) {
 }
 
 TEST(GameFactory, LoadFromBoard) {
-    GameFactory gameFactory;
+    GameFactory gameFactory{1};
     std::unique_ptr<Game> game = gameFactory.loadFromBoard("test_inputs/load_from_board.in");
     std::ostringstream out;
 
@@ -35,3 +37,43 @@ TEST(GameFactory, LoadFromBoard) {
 
     EXPECT_EQ(out.str(), expectedPrintOutput);
 }
+
+TEST(GameFactory, ClonedGamesPlayIndependently) {
+    GameFactory gameFactory{1};
+    std::unique_ptr<Game> game = gameFactory.loadFromGame("test_inputs/load_from_game.in");
+    std::unique_ptr<Game> clone = game->clone();
+    EngineSnapshot snapshot = game->snapshot();
+
+    std::istringstream in("build-road 50\nnext\n");
+    NullSink out;
+    clone->play(in, out, false);
+    EXPECT_EQ(clone->getCurrentBuilder(), 2);
+
+    std::ostringstream original;
+    std::ostringstream restored;
+    game->getBoard().printBoard(original);
+    clone->restore(snapshot);
+    clone->getBoard().printBoard(restored);
+    EXPECT_EQ(restored.str(), original.str());
+    EXPECT_EQ(game->getCurrentBuilder(), 1);
+}
+
+TEST(GameFactory, SaveAndLoadPreserveStateHash) {
+    GameFactory gameFactory{1};
+    std::unique_ptr<Game> game = gameFactory.loadFromGame("test_inputs/load_from_game.in");
+    uint64_t loadedHash = game->stateHash();
+    EXPECT_EQ(gameFactory.loadFromGame("test_inputs/load_from_game.in")->stateHash(), loadedHash);
+
+    std::istringstream in("build-road 50\nnext\n");
+    NullSink out;
+    game->play(in, out, false);
+    EXPECT_NE(game->stateHash(), loadedHash);
+
+    // Binary saves load structures back in a different order, which must not matter
+    for (std::string filename : {"gamefactory_tests.sv", "gamefactory_tests.svb"}) {
+        game->save(filename);
+        std::unique_ptr<Game> loaded = gameFactory.loadFromGame(filename);
+        std::remove(filename.c_str());
+        EXPECT_EQ(loaded->stateHash(), game->stateHash()) << filename;
+    }
+}
@@ -0,0 +1,66 @@
+#include "../../src/game/game.h"
+#include "../../src/game/gamefactory.h"
+#include "../../src/game/outputsink.h"
+#include "gtest/gtest.h"
+#include <fstream>
+#include <sstream>
+
+namespace {
+std::string readScript(const std::string& filename) {
+    std::ifstream file{filename};
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+// Counts how often its stream is flushed
+class CountingBuffer final : public std::stringbuf {
+  public:
+    int flushes = 0;
+
+  protected:
+    int sync() override {
+        flushes++;
+        return std::stringbuf::sync();
+    }
+};
+}
+
+TEST(OutputSink, SinksOnlyDifferInWhereOutputGoes) {
+    std::string script = readScript("game/inputs/goose.in");
+
+    // Each game comes from a fresh factory so that all three roll the same dice
+    std::unique_ptr<Game> captured = GameFactory{1}.loadFromGame("test_inputs/lotsaresources.in");
+    std::istringstream capturedIn{script};
+    CaptureSink capture;
+    captured->play(capturedIn, capture, false);
+
+    std::unique_ptr<Game> console = GameFactory{1}.loadFromGame("test_inputs/lotsaresources.in");
+    std::istringstream consoleIn{script};
+    std::ostringstream consoleOut;
+    ConsoleSink consoleSink{consoleOut};
+    console->play(consoleIn, consoleSink, false);
+
+    std::unique_ptr<Game> silent = GameFactory{1}.loadFromGame("test_inputs/lotsaresources.in");
+    std::istringstream silentIn{script};
+    NullSink null;
+    silent->play(silentIn, null, false);
+
+    EXPECT_FALSE(capture.getOutput().empty());
+    EXPECT_EQ(consoleOut.str(), capture.getOutput());
+    EXPECT_EQ(console->stateHash(), captured->stateHash());
+    EXPECT_EQ(silent->stateHash(), captured->stateHash());
+}
+
+TEST(OutputSink, ConsoleFlushesOnlyAtPrompts) {
+    GameFactory gameFactory{1};
+    std::unique_ptr<Game> game = gameFactory.loadFromGame("test_inputs/load_from_game.in");
+    CountingBuffer buffer;
+    std::ostream out{&buffer};
+    ConsoleSink console{out};
+
+    // Printing the board and statuses writes dozens of lines, but only ending the turn prompts the next builder
+    std::istringstream in{"board\nstatus\nresidences\nnext\n"};
+    game->play(in, console, false);
+    EXPECT_EQ(buffer.flushes, 2);
+}
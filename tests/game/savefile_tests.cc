@@ -0,0 +1,121 @@
+#include "../../src/game/game.h"
+#include "../../src/game/gamefactory.h"
+#include "../../src/game/savefile.h"
+#include "gtest/gtest.h"
+#include <iterator>
+#include <fstream>
+#include <sstream>
+
+namespace {
+SaveData readTextInput(const std::string& filename) {
+    std::ifstream file{filename};
+    return SaveFile::readText(file);
+}
+
+void expectSameSave(const SaveData& a, const SaveData& b) {
+    EXPECT_EQ(a.currentBuilder, b.currentBuilder);
+    EXPECT_EQ(a.geeseTile, b.geeseTile);
+    for (int i = 0; i < SaveData::NUM_BUILDERS; i++) {
+        EXPECT_EQ(a.builders[i].resources, b.builders[i].resources);
+        // Structures must also come back in build order
+        std::vector<std::pair<int, char>> residencesA(a.builders[i].residences.begin(), a.builders[i].residences.end());
+        std::vector<std::pair<int, char>> residencesB(b.builders[i].residences.begin(), b.builders[i].residences.end());
+        std::vector<int> roadsA(a.builders[i].roads.begin(), a.builders[i].roads.end());
+        std::vector<int> roadsB(b.builders[i].roads.begin(), b.builders[i].roads.end());
+        EXPECT_EQ(residencesA, residencesB);
+        EXPECT_EQ(roadsA, roadsB);
+    }
+    ASSERT_EQ(a.tiles.size(), b.tiles.size());
+    for (size_t i = 0; i < a.tiles.size(); i++) {
+        EXPECT_EQ(a.tiles[i].tileValue, b.tiles[i].tileValue);
+        EXPECT_EQ(a.tiles[i].resource, b.tiles[i].resource);
+    }
+}
+}
+
+TEST(SaveFile, TextRoundTrip) {
+    GameFactory gameFactory{1};
+    std::unique_ptr<Game> game = gameFactory.loadFromGame("test_inputs/lotsaresources.in");
+
+    std::ostringstream out;
+    SaveData data = SaveFile::fromEngine(game->getEngine());
+    SaveFile::writeText(out, data);
+    expectSameSave(data, readTextInput("test_inputs/lotsaresources.in"));
+
+    // Saving what was loaded reproduces the same text
+    std::istringstream in{out.str()};
+    std::ostringstream again;
+    SaveFile::writeText(again, SaveFile::readText(in));
+    EXPECT_EQ(again.str(), out.str());
+}
+
+TEST(SaveFile, BinaryRoundTrip) {
+    SaveData text = readTextInput("test_inputs/load_from_game.in");
+
+    std::string bytes = SaveFile::encodeBinary(text);
+    EXPECT_EQ(bytes.size(), SaveFile::BINARY_SIZE);
+    expectSameSave(SaveFile::decodeBinary(bytes.data(), bytes.size()), text);
+}
+
+TEST(SaveFile, TextToBinaryToTextIsIdentical) {
+    // lotsaresources.in builds its roads and residences out of edge and vertex order
+    for (const char* filename : {"test_inputs/lotsaresources.in", "test_inputs/load_from_game.in"}) {
+        std::ifstream file{filename};
+        std::string original{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        std::istringstream in{original};
+        std::ostringstream text;
+        SaveFile::writeText(text, SaveFile::readText(in));
+
+        std::string bytes = SaveFile::encodeBinary(readTextInput(filename));
+        std::ostringstream again;
+        SaveFile::writeText(again, SaveFile::decodeBinary(bytes.data(), bytes.size()));
+        EXPECT_EQ(again.str(), text.str()) << filename;
+    }
+}
+
+TEST(SaveFile, BinaryDecodeRejectsBadInput) {
+    std::string bytes = SaveFile::encodeBinary(readTextInput("test_inputs/load_from_game.in"));
+
+    EXPECT_THROW(SaveFile::decodeBinary(bytes.data(), bytes.size() - 1), std::invalid_argument);
+
+    std::string badMagic = bytes;
+    badMagic[0] = 'X';
+    EXPECT_THROW(SaveFile::decodeBinary(badMagic.data(), badMagic.size()), std::invalid_argument);
+
+    std::string badVersion = bytes;
+    badVersion[4] = 1;
+    EXPECT_THROW(SaveFile::decodeBinary(badVersion.data(), badVersion.size()), std::invalid_argument);
+
+    std::string badGeese = bytes;
+    badGeese[7] = 19;
+    EXPECT_THROW(SaveFile::decodeBinary(badGeese.data(), badGeese.size()), std::invalid_argument);
+
+    // Build orders must list exactly the structures in the builder's masks, then pad with 0xFF
+    const size_t orderOffset = SaveFile::HEADER_SIZE + SaveData::NUM_BUILDERS * SaveFile::BUILDER_SIZE;
+    std::string badRoadOrder = bytes;
+    badRoadOrder[orderOffset] = badRoadOrder[orderOffset + 1];
+    EXPECT_THROW(SaveFile::decodeBinary(badRoadOrder.data(), badRoadOrder.size()), std::invalid_argument);
+
+    std::string badPadding = bytes;
+    badPadding[orderOffset + Board::NUM_EDGES - 1] = 0;
+    EXPECT_THROW(SaveFile::decodeBinary(badPadding.data(), badPadding.size()), std::invalid_argument);
+
+    std::string badTile = bytes;
+    badTile[bytes.size() - 2] = 6;
+    EXPECT_THROW(SaveFile::decodeBinary(badTile.data(), badTile.size()), std::invalid_argument);
+}
+
+TEST(SaveFile, LoadFromBinaryFile) {
+    GameFactory gameFactory{1};
+    std::unique_ptr<Game> textGame = gameFactory.loadFromGame("test_inputs/load_from_game.in");
+    textGame->save("savefile_tests.svb");
+    std::unique_ptr<Game> binaryGame = gameFactory.loadFromGame("savefile_tests.svb");
+    std::remove("savefile_tests.svb");
+
+    std::ostringstream textBoard, binaryBoard;
+    textGame->getBoard().printBoard(textBoard);
+    binaryGame->getBoard().printBoard(binaryBoard);
+    EXPECT_EQ(binaryBoard.str(), textBoard.str());
+    EXPECT_EQ(binaryGame->getCurrentBuilder(), textGame->getCurrentBuilder());
+    expectSameSave(SaveFile::fromEngine(binaryGame->getEngine()), SaveFile::fromEngine(textGame->getEngine()));
+}
@@ -0,0 +1,93 @@
+#include "../../src/board/board.h"
+#include "../../src/game/builder.h"
+#include "../../src/game/engine.h"
+#include "../../src/sim/placementsolver.h"
+#include "gtest/gtest.h"
+
+namespace {
+std::vector<TileInitData> solverTileInitData = {{3, BRICK}, {10, ENERGY}, {5, HEAT}, {4, ENERGY}, {7, PARK}, {10, HEAT}, {11, GLASS}, {3, BRICK}, {8, HEAT}, {2, BRICK}, {6, BRICK}, {8, ENERGY}, {12, WIFI}, {5, ENERGY}, {11, WIFI}, {4, GLASS}, {6, WIFI}, {9, GLASS}, {9, GLASS}};
+}
+
+TEST(PlacementSolver, SnakeDraftOrder) {
+    std::vector<int> builders;
+    for (int i = 0; i < PlacementPlan::NUM_PICKS; i++) {
+        builders.push_back(PlacementPlan::getPickBuilder(i));
+    }
+    EXPECT_EQ(builders, (std::vector<int>{0, 1, 2, 3, 3, 2, 1, 0}));
+}
+
+TEST(PlacementSolver, PairScoresCountYieldAndDiversity) {
+    Board board(solverTileInitData);
+    PlacementSolver solver(board, 1);
+
+    // Vertex 0 only touches a 3 of BRICK and vertex 2 only a 10 of ENERGY
+    EXPECT_EQ(solver.getPairScore(0, 2), 2 + 3 + 2 * PlacementSolver::DIVERSITY_BONUS);
+    EXPECT_EQ(solver.getPairScore(2, 0), solver.getPairScore(0, 2));
+    EXPECT_EQ(solver.getPairScore(0, 1), -1);
+    EXPECT_EQ(solver.getPairScore(0, 0), -1);
+}
+
+TEST(PlacementSolver, PlanPlaysThroughTheEngine) {
+    PlacementPlan plan = PlacementSolver(Board{solverTileInitData}).solve();
+    Engine engine(solverTileInitData, RandomEngine{1});
+
+    for (int i = 0; i < PlacementPlan::NUM_PICKS; i++) {
+        EXPECT_EQ(engine.getCurrentBuilder(), PlacementPlan::getPickBuilder(i));
+        EXPECT_EQ(engine.apply(Action{ActionType::BUILD_INITIAL_RESIDENCE, plan.picks[i]}).status, ActionStatus::SUCCESS);
+    }
+    EXPECT_EQ(engine.getPhase(), TurnPhase::PRE_ROLL);
+}
+
+TEST(PlacementSolver, NoBuilderCanImproveOnTheirLastPick) {
+    Board board(solverTileInitData);
+    PlacementSolver solver(board, 2);
+    PlacementPlan plan = solver.solve();
+    std::vector<std::unique_ptr<Builder>> builders;
+    for (int i = 0; i < PlacementPlan::NUM_BUILDERS; i++) {
+        builders.push_back(std::make_unique<Builder>(i, "BROY"[i]));
+    }
+
+    for (int i = 0; i < PlacementPlan::NUM_PICKS; i++) {
+        int builder = PlacementPlan::getPickBuilder(i);
+        int first = plan.picks[PlacementPlan::NUM_PICKS - 1 - i];
+        if (i == PlacementPlan::NUM_BUILDERS - 1) {
+            // Builder 3 picks both basements back to back, so neither could be bettered as a pair
+            for (int a = 0; a < Board::NUM_VERTICES; a++) {
+                for (int b = 0; b < Board::NUM_VERTICES; b++) {
+                    if (board.canBuildInitialResidence(a) && board.canBuildInitialResidence(b) && solver.getPairScore(a, b) > 0) {
+                        EXPECT_LE(solver.getPairScore(a, b), plan.scores[builder]);
+                    }
+                }
+            }
+        }
+        else if (i >= PlacementPlan::NUM_BUILDERS) {
+            for (int vertex = 0; vertex < Board::NUM_VERTICES; vertex++) {
+                if (board.canBuildInitialResidence(vertex)) {
+                    EXPECT_LE(solver.getPairScore(first, vertex), plan.scores[builder]) << "pick " << i << " at " << vertex;
+                }
+            }
+        }
+        ASSERT_EQ(board.buildInitialResidence(*builders[builder], plan.picks[i]), ActionStatus::SUCCESS);
+    }
+
+    for (int i = 0; i < PlacementPlan::NUM_BUILDERS; i++) {
+        EXPECT_EQ(plan.scores[i], solver.getPairScore(plan.picks[i], plan.picks[PlacementPlan::NUM_PICKS - 1 - i]));
+    }
+}
+
+TEST(PlacementSolver, PlanDoesNotDependOnThreadCount) {
+    Board board(solverTileInitData);
+    board.setGeeseTile(10);
+    PlacementPlan single = PlacementSolver(board, 1).solve();
+    PlacementPlan parallel = PlacementSolver(board, 4).solve();
+
+    EXPECT_EQ(single.picks, parallel.picks);
+    EXPECT_EQ(single.scores, parallel.scores);
+}
+
+TEST(PlacementSolver, RejectsBoardsWithResidences) {
+    Board board(solverTileInitData);
+    Builder builder(0, 'B');
+    board.buildInitialResidence(builder, 20);
+    EXPECT_THROW(PlacementSolver{board}, std::invalid_argument);
+}
@@ -0,0 +1,67 @@
+#include "../../src/board/board.h"
+#include "../../src/game/engine.h"
+#include "../../src/sim/player.h"
+#include "gtest/gtest.h"
+
+namespace {
+std::vector<TileInitData> playerTileInitData = {{3, BRICK}, {10, ENERGY}, {5, HEAT}, {4, ENERGY}, {7, PARK}, {10, HEAT}, {11, GLASS}, {3, BRICK}, {8, HEAT}, {2, BRICK}, {6, BRICK}, {8, ENERGY}, {12, WIFI}, {5, ENERGY}, {11, WIFI}, {4, GLASS}, {6, WIFI}, {9, GLASS}, {9, GLASS}};
+}
+
+TEST(Player, MakePlayerByName) {
+    EXPECT_EQ(makePlayer("scripted")->getName(), "scripted");
+    EXPECT_EQ(makePlayer("heuristic")->getName(), "heuristic");
+    EXPECT_THROW(makePlayer("human"), std::invalid_argument);
+}
+
+TEST(Player, InitialPlacementsAreLegal) {
+    Engine engine(playerTileInitData, RandomEngine{1});
+    std::unique_ptr<Player> scripted = makePlayer("scripted");
+    std::unique_ptr<Player> heuristic = makePlayer("heuristic");
+
+    // Alternate the two players through the whole snake draft
+    for (int i = 0; engine.getPhase() == TurnPhase::INITIAL_PLACEMENT; i++) {
+        Action action = (i % 2 == 0 ? scripted : heuristic)->chooseAction(engine);
+        EXPECT_EQ(action.type, ActionType::BUILD_INITIAL_RESIDENCE);
+        EXPECT_TRUE(engine.getBoard().canBuildInitialResidence(action.target));
+        EXPECT_EQ(engine.apply(action).status, ActionStatus::SUCCESS);
+    }
+    EXPECT_EQ(engine.getPhase(), TurnPhase::PRE_ROLL);
+}
+
+TEST(Player, ScriptedTakesFirstVertexHeuristicTakesMostPips) {
+    Engine engine(playerTileInitData, RandomEngine{1});
+
+    EXPECT_EQ(makePlayer("scripted")->chooseAction(engine).target, 0);
+
+    // Vertex 31 touches the 8, 8 and 5 tiles (5 + 5 + 4 pips), more than any other vertex
+    EXPECT_EQ(makePlayer("heuristic")->chooseAction(engine).target, 31);
+}
+
+TEST(Player, HeuristicTradesForTheOneResourceItLacks) {
+    // Blue is a heat short of a house and can spare a brick; only Yellow holds any heat
+    std::vector<BuilderResourceData> resourceData = {{2, 0, 2, 2, 0}, {0, 0, 0, 0, 0}, {0, 0, 0, 0, 0}, {0, 0, 0, 1, 0}};
+    std::vector<BuilderStructureData> structureData = {{{{0, 'B'}}, {1}}, {{}, {}}, {{}, {}}, {{}, {}}};
+    Engine engine(playerTileInitData, resourceData, structureData, 0, 4, RandomEngine{1});
+
+    EXPECT_EQ(makePlayer("scripted")->chooseAction(engine).type, ActionType::END_TURN);
+
+    Action action = makePlayer("heuristic")->chooseAction(engine);
+    ASSERT_EQ(action.type, ActionType::TRADE);
+    EXPECT_EQ(action.target, 3);
+    EXPECT_EQ(action.trade.resourceToGive, BRICK);
+    EXPECT_EQ(action.trade.resourceToTake, HEAT);
+    ASSERT_EQ(engine.apply(action).status, ActionStatus::SUCCESS);
+
+    action = makePlayer("heuristic")->chooseAction(engine);
+    EXPECT_EQ(action.type, ActionType::IMPROVE);
+    EXPECT_EQ(action.target, 0);
+}
+
+TEST(Player, HeuristicOnlyTradesAwayCardsItCanSpare) {
+    // Every card Blue holds goes into the house, so it has nothing to give for the heat
+    std::vector<BuilderResourceData> resourceData = {{0, 0, 2, 2, 0}, {0, 0, 0, 0, 0}, {0, 0, 0, 0, 0}, {0, 0, 0, 1, 0}};
+    std::vector<BuilderStructureData> structureData = {{{{0, 'B'}}, {1}}, {{}, {}}, {{}, {}}, {{}, {}}};
+    Engine engine(playerTileInitData, resourceData, structureData, 0, 4, RandomEngine{1});
+
+    EXPECT_EQ(makePlayer("heuristic")->chooseAction(engine).type, ActionType::END_TURN);
+}
@@ -0,0 +1,61 @@
+#include "../../src/sim/simulator.h"
+#include "gtest/gtest.h"
+
+namespace {
+SimulationConfig makeConfig(int games, int threads) {
+    SimulationConfig config;
+    config.games = games;
+    config.seed = 7;
+    config.threads = threads;
+    config.players = {{"heuristic", "scripted", "heuristic", "scripted"}};
+    return config;
+}
+}
+
+TEST(Simulator, RejectsUnknownPlayers) {
+    SimulationConfig config = makeConfig(1, 1);
+    config.players[2] = "human";
+    EXPECT_THROW(Simulator{config}, std::invalid_argument);
+}
+
+TEST(Simulator, PlaysEveryGame) {
+    SimulationResults results = Simulator{makeConfig(8, 2)}.run();
+
+    EXPECT_EQ(results.games, 8);
+    long long wins = 0;
+    for (int i = 0; i < SimulationConfig::NUM_SEATS; i++) {
+        wins += results.wins[i];
+    }
+    EXPECT_EQ(wins + results.unfinished, 8);
+    EXPECT_GT(results.getMeanLength(), 0);
+    EXPECT_GT(results.getMeanIncome(0, 0), 0);
+}
+
+TEST(Simulator, ResultsDoNotDependOnThreadCount) {
+    SimulationResults single = Simulator{makeConfig(12, 1)}.run();
+    SimulationResults parallel = Simulator{makeConfig(12, 4)}.run();
+
+    EXPECT_EQ(single.wins, parallel.wins);
+    EXPECT_EQ(single.unfinished, parallel.unfinished);
+    EXPECT_EQ(single.lengthCounts, parallel.lengthCounts);
+    EXPECT_EQ(single.incomeTotals, parallel.incomeTotals);
+}
+
+TEST(Simulator, ResultsMergeAcrossShards) {
+    SimulationResults a;
+    a.recordRound(0, {{1, 2, 3, 4}});
+    a.recordGame(0, 10);
+    SimulationResults b;
+    b.recordRound(0, {{3, 2, 1, 0}});
+    b.recordRound(1, {{5, 5, 5, 5}});
+    b.recordGame(-1, 1000);
+
+    a += b;
+    EXPECT_EQ(a.games, 2);
+    EXPECT_EQ(a.unfinished, 1);
+    EXPECT_DOUBLE_EQ(a.getUnfinishedRate(), 0.5);
+    EXPECT_EQ(a.wins[0], 1);
+    EXPECT_DOUBLE_EQ(a.getMeanLength(), 10);
+    EXPECT_DOUBLE_EQ(a.getMeanIncome(0, 0), 2);
+    EXPECT_DOUBLE_EQ(a.getMeanIncome(1, 3), 5);
+}
@@ -0,0 +1,80 @@
+#include "../../src/structures/residence.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+TEST(Residence, DefaultIsEmpty) {
+    Residence residence;
+
+    EXPECT_FALSE(residence.exists());
+    EXPECT_EQ(residence.getOwner(), -1);
+    EXPECT_EQ(residence.getLevel(), ResidenceLevel::NONE);
+    EXPECT_EQ(residence.getBuildingPoints(), 0);
+    EXPECT_EQ(residence.getResourceMultiplier(), 0);
+    EXPECT_FALSE(residence.canUpgrade());
+}
+
+TEST(Residence, GetOwner) {
+    Residence residence(2);
+
+    EXPECT_TRUE(residence.exists());
+    EXPECT_EQ(residence.getOwner(), 2);
+    EXPECT_EQ(residence.getLevel(), ResidenceLevel::BASEMENT);
+}
+
+TEST(Residence, Basement) {
+    Residence basement(3, ResidenceLevel::BASEMENT);
+
+    EXPECT_EQ(basement.getBuildingPoints(), 1);
+    EXPECT_EQ(basement.getResidenceLetter(), 'B');
+    EXPECT_EQ(basement.getResourceMultiplier(), 1);
+}
+
+TEST(Residence, House) {
+    Residence house(2, ResidenceLevel::HOUSE);
+
+    EXPECT_EQ(house.getBuildingPoints(), 2);
+    EXPECT_EQ(house.getResidenceLetter(), 'H');
+    EXPECT_EQ(house.getResourceMultiplier(), 2);
+}
+
+TEST(Residence, Tower) {
+    Residence tower(1, ResidenceLevel::TOWER);
+
+    EXPECT_EQ(tower.getBuildingPoints(), 3);
+    EXPECT_EQ(tower.getResidenceLetter(), 'T');
+    EXPECT_EQ(tower.getResourceMultiplier(), 3);
+}
+
+TEST(Residence, UpgradeInPlace) {
+    Residence residence(1);
+
+    residence.upgrade();
+    EXPECT_EQ(residence, Residence(1, ResidenceLevel::HOUSE));
+
+    residence.upgrade();
+    EXPECT_EQ(residence, Residence(1, ResidenceLevel::TOWER));
+    EXPECT_FALSE(residence.canUpgrade());
+    EXPECT_THROW(residence.upgrade(), std::logic_error);
+    EXPECT_THROW(Residence().upgrade(), std::logic_error);
+}
+
+TEST(Residence, LevelFromLetter) {
+    EXPECT_EQ(Residence::levelFromLetter('B'), ResidenceLevel::BASEMENT);
+    EXPECT_EQ(Residence::levelFromLetter('H'), ResidenceLevel::HOUSE);
+    EXPECT_EQ(Residence::levelFromLetter('T'), ResidenceLevel::TOWER);
+    EXPECT_THROW(Residence::levelFromLetter('X'), std::invalid_argument);
+}
+
+TEST(Residence, CopiesAsPlainBytes) {
+    EXPECT_TRUE(std::is_trivially_copyable<Residence>::value);
+    EXPECT_EQ(sizeof(Residence), 2u);
+
+    Residence residences[3] = {Residence{0}, Residence{}, Residence{3, ResidenceLevel::TOWER}};
+    Residence copy[3];
+    std::memcpy(copy, residences, sizeof(residences));
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(copy[i], residences[i]);
+    }
+}
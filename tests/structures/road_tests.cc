@@ -1,20 +1,29 @@
-#include "../../src/board/edge.h"
-#include "../../src/game/builder.h"
 #include "../../src/structures/road.h"
 #include "gtest/gtest.h"
+#include <cstring>
+#include <type_traits>
 
 TEST(Road, GetOwner) {
-    Builder builder(4, 'B');
-    Edge location(18);
-    Road road(builder, location);
+    Road road(3);
 
-    EXPECT_EQ(road.getOwner().getBuilderNumber(), 4);
+    EXPECT_TRUE(road.exists());
+    EXPECT_EQ(road.getOwner(), 3);
 }
 
-TEST(Road, GetLocation) {
-    Builder builder(33, 'C');
-    Edge location(42);
-    Road road(builder, location);
+TEST(Road, DefaultIsEmpty) {
+    Road road;
 
-    EXPECT_EQ(road.getLocation(), location);
+    EXPECT_FALSE(road.exists());
+    EXPECT_EQ(road.getOwner(), -1);
+    EXPECT_NE(road, Road{0});
+}
+
+TEST(Road, CopiesAsPlainBytes) {
+    EXPECT_TRUE(std::is_trivially_copyable<Road>::value);
+
+    Road roads[2] = {Road{1}, Road{}};
+    Road copy[2];
+    std::memcpy(copy, roads, sizeof(roads));
+    EXPECT_EQ(copy[0], Road{1});
+    EXPECT_FALSE(copy[1].exists());
 }